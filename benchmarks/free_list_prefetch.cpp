@@ -0,0 +1,137 @@
+// benchmarks/free_list_prefetch.cpp
+//
+// Effect of prefetching the next free-list slot on a cold, randomly fragmented
+// free list.
+//
+// The pool holds far more slots than the last-level cache. Every slot is
+// allocated once and freed in a shuffled order, so the free list visits
+// memory at random and each pop is a cache miss on the slot and, without
+// prefetching, a second dependent miss on its link.
+//
+// - pop: allocate every slot again and write one field (one op = one emplace)
+// - pipeline: emplace one item per step and run some unrelated work on it;
+//   with `hint` the work is preceded by prefetch_next_slot(), so the slot of
+//   the next step is loaded while the current one is processed
+//
+// Built as free_list_prefetch_bench and free_list_prefetch_bench_noprefetch
+// (OxiMemPool_NoPrefetch) to compare the automatic prefetch with none.
+//
+// Usage: free_list_prefetch_bench [slots] [rounds]
+#include "MemOx/object_pool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+struct Record
+{
+    std::uint64_t id;
+    std::uint64_t payload[15];
+
+    explicit Record(std::uint64_t i) : id(i) {}
+};
+
+template <PoolThreading Threading>
+constexpr const char* threading_name()
+{
+    if constexpr (Threading == PoolThreading::SingleThread)
+        return "SingleThread";
+    else if constexpr (Threading == PoolThreading::Mutex)
+        return "Mutex";
+    else if constexpr (Threading == PoolThreading::LockFree)
+        return "LockFree";
+    else
+        return "OwnerThread";
+}
+
+// Frees every object of `objects` in a shuffled order, leaving a free list
+// that jumps around the whole pool.
+template <PoolThreading Threading>
+static void fragment(ObjectPool<Record, Threading>& pool, std::vector<Record*>& objects, std::mt19937_64& rng)
+{
+    std::shuffle(objects.begin(), objects.end(), rng);
+    for (Record* r : objects)
+        pool.destroy_unowned(r);
+    objects.clear();
+}
+
+// Work of one pipeline step that does not depend on the pool.
+static std::uint64_t process(std::uint64_t x)
+{
+    for (int i = 0; i < 48; ++i)
+        x = x * 6364136223846793005ull + 1442695040888963407ull;
+    return x;
+}
+
+template <PoolThreading Threading>
+static void run(size_t slots, int rounds)
+{
+    ObjectPool<Record, Threading> pool(slots);
+    std::vector<Record*> objects;
+    objects.reserve(slots);
+    std::mt19937_64 rng(42);
+
+    for (size_t i = 0; i < slots; ++i)
+        objects.push_back(pool.emplace_unowned(i));
+    fragment(pool, objects, rng);
+
+    double pop_ns = 0;
+    double pipeline_ns[2] = {0, 0};
+    for (int round = 0; round < rounds; ++round)
+    {
+        const auto begin = Clock::now();
+        for (size_t i = 0; i < slots; ++i)
+            objects.push_back(pool.emplace_unowned(i));
+        pop_ns += std::chrono::duration<double, std::nano>(Clock::now() - begin).count();
+        fragment(pool, objects, rng);
+
+        for (int hint = 0; hint < 2; ++hint)
+        {
+            const auto start = Clock::now();
+            for (size_t i = 0; i < slots; ++i)
+            {
+                Record* r = pool.emplace_unowned(i);
+                if (hint)
+                    pool.prefetch_next_slot();
+                r->payload[0] = process(r->id);
+                objects.push_back(r);
+            }
+            pipeline_ns[hint] += std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+            fragment(pool, objects, rng);
+        }
+    }
+
+    const double ops = static_cast<double>(slots) * rounds;
+    std::cout << std::left << std::setw(14) << threading_name<Threading>() << std::right << std::fixed
+              << std::setprecision(2) << "pop=" << std::setw(7) << pop_ns / ops << " ns/op"
+              << "  pipeline=" << std::setw(7) << pipeline_ns[0] / ops << " ns/op"
+              << "  pipeline+hint=" << std::setw(7) << pipeline_ns[1] / ops << " ns/op\n";
+}
+
+int main(int argc, char** argv)
+{
+    const size_t slots = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : size_t{1} << 20;
+    const int rounds = argc > 2 ? std::atoi(argv[2]) : 3;
+
+    std::cout << "[FreeListPrefetch] slots=" << slots << " slot_size=" << ObjectPool<Record>::slot_size
+              << " rounds=" << rounds
+#ifdef OxiMemPool_NoPrefetch
+              << " prefetch=off"
+#else
+              << " prefetch=on"
+#endif
+              << "\n";
+
+    run<PoolThreading::SingleThread>(slots, rounds);
+    run<PoolThreading::Mutex>(slots, rounds);
+    run<PoolThreading::LockFree>(slots, rounds);
+    run<PoolThreading::OwnerThread>(slots, rounds);
+    return 0;
+}
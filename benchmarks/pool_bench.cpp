@@ -0,0 +1,626 @@
+// benchmarks/pool_bench.cpp
+//
+// Self-contained microbenchmark suite comparing ObjectPool (every threading
+// policy) with plain new/delete and the std::pmr pool resources.
+//
+// Workloads:
+//   pair     emplace + destroy of one object, repeated
+//   lifo     fill a working set, free it in reverse order
+//   random   fill a working set, free it in a shuffled order
+//   batch    churn of fixed-size batches (emplace_n / release_bulk for pools)
+//   threads  1..N threads churning a shared allocator (thread-safe backends)
+//   handoff  one producer allocates, 1..N consumer threads free (thread-safe backends)
+//
+// Every workload runs for several sizeof(T) / alignof(T) classes. Throughput is
+// reported as ns/op (one op = one allocation or one free). Latency percentiles
+// come from a separate pass that times single operations with steady_clock, so
+// they include the clock overhead printed in the header.
+//
+// Built a second time as pool_bench_hardened (OxiMemPool_Hardened) to measure
+// the cost of the hardening checks, and as pool_bench_profile
+// (OxiMemPool_Profile) for the sampling profiler; the header line reports
+// which build runs.
+//
+// Usage: pool_bench [ops_per_run] [max_threads]
+#include "MemOx/object_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory_resource>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+// Makes `p` escape so the optimizer can neither drop nor merge allocations
+// (new/delete pairs may otherwise be elided entirely).
+static void do_not_optimize(void* p)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "g"(p) : "memory");
+#else
+    static void* volatile sink;
+    sink = p;
+#endif
+}
+
+template <size_t Size, size_t Align>
+struct alignas(Align) BenchObject
+{
+    std::uint8_t bytes[Size];
+
+    static constexpr size_t kSize = Size;
+    static constexpr size_t kAlign = Align;
+};
+
+// ---------------------------------------------------------------------------
+// Backends: acquire() returns an owning handle, release() destroys it.
+// ---------------------------------------------------------------------------
+
+template <PoolThreading Threading>
+constexpr const char* policy_name()
+{
+    if constexpr (Threading == PoolThreading::SingleThread)
+        return "ObjectPool<SingleThread>";
+    else if constexpr (Threading == PoolThreading::Mutex)
+        return "ObjectPool<Mutex>";
+    else if constexpr (Threading == PoolThreading::LockFree)
+        return "ObjectPool<LockFree>";
+    else
+        return "ObjectPool<OwnerThread>";
+}
+
+template <typename T, PoolThreading Threading>
+struct PoolBackend
+{
+    using Handle = PoolHandle<T, Threading>;
+    static constexpr bool kThreadSafe = Threading != PoolThreading::SingleThread;
+    static const char* name() { return policy_name<Threading>(); }
+
+    ObjectPool<T, Threading> pool;
+
+    explicit PoolBackend(size_t capacity) : pool(capacity) {}
+
+    Handle acquire() { return pool.emplace(); }
+    void release(Handle& h) { h.reset(); }
+    static T* get(const Handle& h) { return h.get(); }
+
+    void acquire_batch(size_t count, std::vector<Handle>& out)
+    {
+        pool.emplace_n(count, std::back_inserter(out));
+    }
+
+    void release_batch(std::vector<Handle>& handles)
+    {
+        pool.release_bulk(handles.begin(), handles.end());
+        handles.clear();
+    }
+};
+
+template <typename T>
+struct NewDeleteBackend
+{
+    using Handle = T*;
+    static constexpr bool kThreadSafe = true;
+    static const char* name() { return "new/delete"; }
+
+    explicit NewDeleteBackend(size_t) {}
+
+    Handle acquire() { return new T(); }
+    void release(Handle& h) { delete h; h = nullptr; }
+    static T* get(Handle h) { return h; }
+
+    void acquire_batch(size_t count, std::vector<Handle>& out)
+    {
+        for (size_t i = 0; i < count; ++i)
+            out.push_back(acquire());
+    }
+
+    void release_batch(std::vector<Handle>& handles)
+    {
+        for (auto& h : handles)
+            release(h);
+        handles.clear();
+    }
+};
+
+template <typename T, typename Resource, bool ThreadSafe>
+struct PmrBackend
+{
+    using Handle = T*;
+    static constexpr bool kThreadSafe = ThreadSafe;
+    static const char* name()
+    {
+        return ThreadSafe ? "pmr::synchronized_pool" : "pmr::unsynchronized_pool";
+    }
+
+    Resource resource;
+    std::pmr::polymorphic_allocator<T> alloc{&resource};
+
+    explicit PmrBackend(size_t) {}
+
+    Handle acquire() { return std::construct_at(alloc.allocate(1)); }
+
+    void release(Handle& h)
+    {
+        std::destroy_at(h);
+        alloc.deallocate(h, 1);
+        h = nullptr;
+    }
+
+    static T* get(Handle h) { return h; }
+
+    void acquire_batch(size_t count, std::vector<Handle>& out)
+    {
+        for (size_t i = 0; i < count; ++i)
+            out.push_back(acquire());
+    }
+
+    void release_batch(std::vector<Handle>& handles)
+    {
+        for (auto& h : handles)
+            release(h);
+        handles.clear();
+    }
+};
+
+template <typename T>
+using UnsyncPmr = PmrBackend<T, std::pmr::unsynchronized_pool_resource, false>;
+template <typename T>
+using SyncPmr = PmrBackend<T, std::pmr::synchronized_pool_resource, true>;
+
+// ---------------------------------------------------------------------------
+// Measurement helpers
+// ---------------------------------------------------------------------------
+
+struct Result
+{
+    double ns_per_op = 0;
+    double p50 = 0;
+    double p99 = 0;
+    double p999 = 0;
+};
+
+static double percentile(std::vector<std::uint32_t>& sorted, double q)
+{
+    if (sorted.empty())
+        return 0;
+    const size_t idx = static_cast<size_t>(q * static_cast<double>(sorted.size() - 1));
+    return sorted[idx];
+}
+
+static void fill_percentiles(Result& r, std::vector<std::uint32_t>& samples)
+{
+    std::sort(samples.begin(), samples.end());
+    r.p50 = percentile(samples, 0.50);
+    r.p99 = percentile(samples, 0.99);
+    r.p999 = percentile(samples, 0.999);
+}
+
+static std::uint32_t elapsed_ns(Clock::time_point begin, Clock::time_point end)
+{
+    return static_cast<std::uint32_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count());
+}
+
+static double clock_overhead_ns()
+{
+    constexpr int kSamples = 100'000;
+    std::vector<std::uint32_t> samples(kSamples);
+    for (auto& s : samples)
+    {
+        const auto a = Clock::now();
+        s = elapsed_ns(a, Clock::now());
+    }
+    std::sort(samples.begin(), samples.end());
+    return samples[kSamples / 2];
+}
+
+template <typename T>
+static void touch(T* obj, size_t value)
+{
+    obj->bytes[0] = static_cast<std::uint8_t>(value);
+    do_not_optimize(obj);
+}
+
+static constexpr size_t kWorkingSet = 1024;
+static constexpr size_t kBatch = 64;
+
+// One op = one allocation or one free; latency samples time a single op.
+
+template <typename Backend>
+static Result bench_pair(size_t ops)
+{
+    Backend backend(16);
+    Result r;
+
+    const size_t pairs = ops / 2;
+    const auto begin = Clock::now();
+    for (size_t i = 0; i < pairs; ++i)
+    {
+        auto h = backend.acquire();
+        touch(Backend::get(h), i);
+        backend.release(h);
+    }
+    r.ns_per_op = std::chrono::duration<double, std::nano>(Clock::now() - begin).count() /
+                  static_cast<double>(pairs * 2);
+
+    std::vector<std::uint32_t> samples;
+    samples.reserve(pairs);
+    for (size_t i = 0; i < pairs; ++i)
+    {
+        const auto t0 = Clock::now();
+        auto h = backend.acquire();
+        const auto t1 = Clock::now();
+        touch(Backend::get(h), i);
+        const auto t2 = Clock::now();
+        backend.release(h);
+        const auto t3 = Clock::now();
+        samples.push_back(elapsed_ns(t0, t1));
+        samples.push_back(elapsed_ns(t2, t3));
+    }
+    fill_percentiles(r, samples);
+    return r;
+}
+
+// Fills kWorkingSet objects and frees them in `order` (indices into the set).
+template <typename Backend>
+static Result bench_order(size_t ops, const std::vector<size_t>& order)
+{
+    Backend backend(kWorkingSet);
+    Result r;
+
+    std::vector<typename Backend::Handle> handles;
+    handles.reserve(kWorkingSet);
+    const size_t rounds = std::max<size_t>(1, ops / (2 * kWorkingSet));
+
+    const auto begin = Clock::now();
+    for (size_t round = 0; round < rounds; ++round)
+    {
+        for (size_t i = 0; i < kWorkingSet; ++i)
+        {
+            handles.push_back(backend.acquire());
+            touch(Backend::get(handles[i]), i);
+        }
+        for (size_t idx : order)
+            backend.release(handles[idx]);
+        handles.clear();
+    }
+    r.ns_per_op = std::chrono::duration<double, std::nano>(Clock::now() - begin).count() /
+                  static_cast<double>(rounds * kWorkingSet * 2);
+
+    std::vector<std::uint32_t> samples;
+    samples.reserve(rounds * kWorkingSet * 2);
+    for (size_t round = 0; round < rounds; ++round)
+    {
+        for (size_t i = 0; i < kWorkingSet; ++i)
+        {
+            const auto t0 = Clock::now();
+            handles.push_back(backend.acquire());
+            samples.push_back(elapsed_ns(t0, Clock::now()));
+            touch(Backend::get(handles[i]), i);
+        }
+        for (size_t idx : order)
+        {
+            const auto t0 = Clock::now();
+            backend.release(handles[idx]);
+            samples.push_back(elapsed_ns(t0, Clock::now()));
+        }
+        handles.clear();
+    }
+    fill_percentiles(r, samples);
+    return r;
+}
+
+// Latency samples are per batch, divided by the batch size.
+template <typename Backend>
+static Result bench_batch(size_t ops)
+{
+    Backend backend(kBatch * 4);
+    Result r;
+
+    std::vector<typename Backend::Handle> handles;
+    handles.reserve(kBatch);
+    const size_t rounds = std::max<size_t>(1, ops / (2 * kBatch));
+
+    std::vector<std::uint32_t> samples;
+    samples.reserve(rounds * 2);
+
+    const auto begin = Clock::now();
+    for (size_t round = 0; round < rounds; ++round)
+    {
+        const auto t0 = Clock::now();
+        backend.acquire_batch(kBatch, handles);
+        const auto t1 = Clock::now();
+        touch(Backend::get(handles[round % kBatch]), round);
+        const auto t2 = Clock::now();
+        backend.release_batch(handles);
+        const auto t3 = Clock::now();
+        samples.push_back(elapsed_ns(t0, t1) / kBatch);
+        samples.push_back(elapsed_ns(t2, t3) / kBatch);
+    }
+    r.ns_per_op = std::chrono::duration<double, std::nano>(Clock::now() - begin).count() /
+                  static_cast<double>(rounds * kBatch * 2);
+
+    fill_percentiles(r, samples);
+    return r;
+}
+
+// Each thread keeps a small working set and frees from it in random order, as
+// in thread_contention.cpp. ns/op is wall time per op of one thread; every
+// 16th op is timed for the latency percentiles.
+template <typename Backend>
+static Result bench_threads(size_t ops, int num_threads)
+{
+    constexpr size_t kLocal = 32;
+    Backend backend(static_cast<size_t>(num_threads) * (kLocal + 2));
+    Result r;
+
+    const size_t ops_per_thread = ops / 2;
+    std::atomic<bool> start{false};
+    std::vector<std::vector<std::uint32_t>> samples(num_threads);
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < num_threads; ++t)
+    {
+        threads.emplace_back([&, t] {
+            std::mt19937_64 rng(0x9E3779B97F4A7C15ull + static_cast<std::uint64_t>(t));
+            std::vector<typename Backend::Handle> local;
+            local.reserve(kLocal + 1);
+            auto& mine = samples[t];
+            mine.reserve(ops_per_thread / 16 + 1);
+
+            while (!start.load(std::memory_order_acquire)) {}
+
+            for (size_t i = 0; i < ops_per_thread; ++i)
+            {
+                const bool timed = (i & 15) == 0;
+                const auto t0 = timed ? Clock::now() : Clock::time_point{};
+                local.push_back(backend.acquire());
+                if (timed)
+                    mine.push_back(elapsed_ns(t0, Clock::now()));
+                touch(Backend::get(local.back()), i);
+
+                if (local.size() > kLocal)
+                {
+                    const size_t idx = rng() % local.size();
+                    std::swap(local[idx], local.back());
+                    const auto t1 = timed ? Clock::now() : Clock::time_point{};
+                    backend.release(local.back());
+                    if (timed)
+                        mine.push_back(elapsed_ns(t1, Clock::now()));
+                    local.pop_back();
+                }
+            }
+
+            for (auto& h : local)
+                backend.release(h);
+        });
+    }
+
+    const auto begin = Clock::now();
+    start.store(true, std::memory_order_release);
+    for (auto& th : threads)
+        th.join();
+    r.ns_per_op = std::chrono::duration<double, std::nano>(Clock::now() - begin).count() /
+                  static_cast<double>(ops_per_thread * 2);
+
+    std::vector<std::uint32_t> all;
+    for (auto& s : samples)
+        all.insert(all.end(), s.begin(), s.end());
+    fill_percentiles(r, all);
+    return r;
+}
+
+// The calling thread (the owner of OwnerThread pools) allocates batches of
+// kBatch objects and hands them to `num_threads` consumers that destroy them,
+// as in a pipeline whose network thread allocates and whose workers free.
+// The queue is the same for every backend. ns/op is wall time per op; every
+// 16th op on either side is timed for the latency percentiles.
+template <typename Backend>
+static Result bench_handoff(size_t ops, int num_threads)
+{
+    constexpr size_t kInFlight = 8; // queued batches at most
+    using Batch = std::vector<typename Backend::Handle>;
+    Backend backend((kInFlight + static_cast<size_t>(num_threads) + 1) * kBatch);
+    Result r;
+
+    const size_t batches = ops / 2 / kBatch;
+    std::mutex queue_mutex;
+    std::vector<Batch> queue;
+    bool done = false;
+    std::vector<std::vector<std::uint32_t>> samples(num_threads + 1);
+    std::vector<std::thread> consumers;
+
+    for (int t = 0; t < num_threads; ++t)
+    {
+        consumers.emplace_back([&, t] {
+            auto& mine = samples[t + 1];
+            Batch batch;
+            for (size_t i = 0;;)
+            {
+                {
+                    std::lock_guard<std::mutex> g(queue_mutex);
+                    if (queue.empty() && done)
+                        return;
+                    if (!queue.empty())
+                    {
+                        batch = std::move(queue.back());
+                        queue.pop_back();
+                    }
+                }
+                if (batch.empty())
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+                for (auto& h : batch)
+                {
+                    const bool timed = (i++ & 15) == 0;
+                    const auto t0 = timed ? Clock::now() : Clock::time_point{};
+                    backend.release(h);
+                    if (timed)
+                        mine.push_back(elapsed_ns(t0, Clock::now()));
+                }
+                batch.clear();
+            }
+        });
+    }
+
+    const auto begin = Clock::now();
+    auto& mine = samples[0];
+    for (size_t b = 0, i = 0; b < batches; ++b)
+    {
+        Batch batch;
+        batch.reserve(kBatch);
+        for (size_t k = 0; k < kBatch; ++k)
+        {
+            const bool timed = (i++ & 15) == 0;
+            const auto t0 = timed ? Clock::now() : Clock::time_point{};
+            batch.push_back(backend.acquire());
+            if (timed)
+                mine.push_back(elapsed_ns(t0, Clock::now()));
+            touch(Backend::get(batch.back()), k);
+        }
+
+        for (;;)
+        {
+            {
+                std::lock_guard<std::mutex> g(queue_mutex);
+                if (queue.size() < kInFlight)
+                {
+                    queue.push_back(std::move(batch));
+                    break;
+                }
+            }
+            std::this_thread::yield();
+        }
+    }
+    {
+        std::lock_guard<std::mutex> g(queue_mutex);
+        done = true;
+    }
+    for (auto& th : consumers)
+        th.join();
+    r.ns_per_op = std::chrono::duration<double, std::nano>(Clock::now() - begin).count() /
+                  static_cast<double>(batches * kBatch * 2);
+
+    std::vector<std::uint32_t> all;
+    for (auto& s : samples)
+        all.insert(all.end(), s.begin(), s.end());
+    fill_percentiles(r, all);
+    return r;
+}
+
+// ---------------------------------------------------------------------------
+// Reporting
+// ---------------------------------------------------------------------------
+
+template <typename T>
+static void print_row(const char* workload, const char* backend, const Result& r, int threads = 0)
+{
+    std::cout << std::left << std::setw(8) << workload
+              << std::right << std::setw(6) << T::kSize << "/" << std::left << std::setw(4) << T::kAlign
+              << std::setw(26) << backend;
+    if (threads)
+        std::cout << "threads=" << std::setw(3) << threads;
+    else
+        std::cout << std::setw(11) << "";
+    std::cout << std::right << std::fixed << std::setprecision(2)
+              << " ns/op=" << std::setw(8) << r.ns_per_op
+              << std::setprecision(0)
+              << "  p50=" << std::setw(6) << r.p50
+              << "  p99=" << std::setw(6) << r.p99
+              << "  p999=" << std::setw(7) << r.p999 << "\n";
+}
+
+template <typename T, typename... Backends>
+static void run_single_threaded(size_t ops)
+{
+    std::vector<size_t> lifo(kWorkingSet);
+    std::iota(lifo.rbegin(), lifo.rend(), size_t{0});
+
+    std::vector<size_t> random(kWorkingSet);
+    std::iota(random.begin(), random.end(), size_t{0});
+    std::shuffle(random.begin(), random.end(), std::mt19937_64(42));
+
+    (print_row<T>("pair", Backends::name(), bench_pair<Backends>(ops)), ...);
+    (print_row<T>("lifo", Backends::name(), bench_order<Backends>(ops, lifo)), ...);
+    (print_row<T>("random", Backends::name(), bench_order<Backends>(ops, random)), ...);
+    (print_row<T>("batch", Backends::name(), bench_batch<Backends>(ops)), ...);
+}
+
+template <typename T, typename... Backends>
+static void run_multi_threaded(size_t ops, int max_threads)
+{
+    for (int threads = 1; threads <= max_threads; threads *= 2)
+        (print_row<T>("threads", Backends::name(), bench_threads<Backends>(ops, threads), threads), ...);
+}
+
+template <typename T, typename... Backends>
+static void run_handoff(size_t ops, int max_threads)
+{
+    for (int threads = 1; threads <= max_threads; threads *= 2)
+        (print_row<T>("handoff", Backends::name(), bench_handoff<Backends>(ops, threads), threads), ...);
+}
+
+template <typename T>
+static void run_size_class(size_t ops, int max_threads)
+{
+    run_single_threaded<T,
+                        PoolBackend<T, PoolThreading::SingleThread>,
+                        PoolBackend<T, PoolThreading::Mutex>,
+                        PoolBackend<T, PoolThreading::LockFree>,
+                        PoolBackend<T, PoolThreading::OwnerThread>,
+                        NewDeleteBackend<T>,
+                        UnsyncPmr<T>>(ops);
+
+    run_multi_threaded<T,
+                       PoolBackend<T, PoolThreading::Mutex>,
+                       PoolBackend<T, PoolThreading::LockFree>,
+                       NewDeleteBackend<T>,
+                       SyncPmr<T>>(ops, max_threads);
+
+    run_handoff<T,
+                PoolBackend<T, PoolThreading::Mutex>,
+                PoolBackend<T, PoolThreading::LockFree>,
+                PoolBackend<T, PoolThreading::OwnerThread>,
+                NewDeleteBackend<T>,
+                SyncPmr<T>>(ops, max_threads);
+    std::cout << "\n";
+}
+
+int main(int argc, char** argv)
+{
+    const size_t ops = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : 1'000'000;
+    const unsigned hw = std::max(2u, std::thread::hardware_concurrency());
+    const int max_threads = argc > 2 ? std::atoi(argv[2]) : static_cast<int>(hw);
+
+    std::cout << "[PoolBench] ops_per_run=" << ops << " max_threads=" << max_threads
+              << " clock_overhead_ns=" << clock_overhead_ns()
+#ifdef OxiMemPool_Hardened
+              << " hardened=1"
+#endif
+#ifdef OxiMemPool_Profile
+              << " profile_interval=" << OxiMemPool_ProfileInterval
+#endif
+              << "\n"
+              << "workload size/align backend                              "
+                 "  ns/op and latency percentiles (ns)\n";
+
+    run_size_class<BenchObject<16, 8>>(ops, max_threads);
+    run_size_class<BenchObject<64, 8>>(ops, max_threads);
+    run_size_class<BenchObject<64, 64>>(ops, max_threads);
+    run_size_class<BenchObject<256, 16>>(ops, max_threads);
+    run_size_class<BenchObject<1024, 8>>(ops, max_threads);
+
+    return 0;
+}
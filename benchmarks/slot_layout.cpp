@@ -0,0 +1,174 @@
+// benchmarks/slot_layout.cpp
+//
+// Effect of the slot layout (SlotLayout) on multi-threaded workloads.
+//
+// - counters: every thread owns a few small counters that were allocated
+//   interleaved with the counters of the other threads (as connections are
+//   accepted by one thread and handed to workers) and increments them in a
+//   loop. With the natural and dense layouts neighbouring slots belong to
+//   different threads and the cache lines ping-pong between cores; CacheLine
+//   slots remove that false sharing.
+// - churn: allocation-heavy churn modelled on tests/unit/thread_stress.cpp,
+//   where every object is written right after allocation.
+#include "MemOx/object_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+template <SlotLayout Layout>
+struct Counter
+{
+    std::uint32_t hits = 0;
+};
+
+template <SlotLayout Layout>
+struct PoolSlotLayout<Counter<Layout>>
+{
+    static constexpr SlotLayout value = Layout;
+};
+
+template <SlotLayout Layout>
+constexpr const char* layout_name()
+{
+    if constexpr (Layout == SlotLayout::CacheLine)
+        return "cache-line";
+    else if constexpr (Layout == SlotLayout::Dense)
+        return "dense";
+    else
+        return "natural";
+}
+
+static constexpr int kCountersPerThread = 8;
+
+// Runs `body(thread_index, stop)` on `num_threads` threads for `duration` and
+// returns the summed operation count per second.
+template <typename Body>
+static double run_threads(int num_threads, std::chrono::milliseconds duration, Body body)
+{
+    std::atomic<bool> start{false};
+    std::atomic<bool> stop{false};
+    std::atomic<std::uint64_t> total_ops{0};
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads);
+
+    for (int t = 0; t < num_threads; ++t)
+    {
+        threads.emplace_back([t, &body, &start, &stop, &total_ops]() {
+            while (!start.load(std::memory_order_acquire)) {}
+            total_ops.fetch_add(body(t, stop), std::memory_order_relaxed);
+        });
+    }
+
+    const auto begin = std::chrono::steady_clock::now();
+    start.store(true, std::memory_order_release);
+    std::this_thread::sleep_for(duration);
+    stop.store(true, std::memory_order_relaxed);
+
+    for (auto& th : threads) th.join();
+
+    const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    return static_cast<double>(total_ops.load()) / elapsed;
+}
+
+template <SlotLayout Layout>
+static double run_counters(int num_threads, std::chrono::milliseconds duration)
+{
+    using Item = Counter<Layout>;
+    ObjectPool<Item, PoolThreading::Mutex> pool(static_cast<size_t>(num_threads) * kCountersPerThread);
+
+    // Round-robin allocation: consecutive slots go to consecutive threads.
+    std::vector<std::vector<PoolHandle<Item, PoolThreading::Mutex>>> owned(num_threads);
+    for (int i = 0; i < kCountersPerThread; ++i)
+        for (int t = 0; t < num_threads; ++t)
+            owned[t].push_back(pool.emplace());
+
+    return run_threads(num_threads, duration, [&](int t, const std::atomic<bool>& stop) {
+        auto& mine = owned[t];
+        std::uint64_t ops = 0;
+        while (!stop.load(std::memory_order_relaxed))
+        {
+            for (auto& h : mine)
+            {
+                // Relaxed load + store keeps every increment in memory.
+                std::atomic_ref<std::uint32_t> hits(h->hits);
+                hits.store(hits.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            }
+            ops += mine.size();
+        }
+        return ops;
+    });
+}
+
+template <SlotLayout Layout>
+static double run_churn(int num_threads, std::chrono::milliseconds duration)
+{
+    using Item = Counter<Layout>;
+    ObjectPool<Item, PoolThreading::Mutex> pool(static_cast<size_t>(num_threads) * 64);
+
+    return run_threads(num_threads, duration, [&](int t, const std::atomic<bool>& stop) {
+        std::mt19937_64 rng(0x9E3779B97F4A7C15ull + static_cast<std::uint64_t>(t));
+        std::vector<PoolHandle<Item, PoolThreading::Mutex>> local;
+        local.reserve(33);
+
+        std::uint64_t ops = 0;
+        while (!stop.load(std::memory_order_relaxed))
+        {
+            auto h = pool.emplace();
+            for (int i = 0; i < 16; ++i)
+            {
+                std::atomic_ref<std::uint32_t> hits(h->hits);
+                hits.store(hits.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            }
+
+            // keep a small working set so frees happen in random order
+            if ((rng() & 3) == 0)
+            {
+                local.push_back(std::move(h));
+                if (local.size() > 32)
+                {
+                    const size_t idx = rng() % local.size();
+                    if (idx + 1 != local.size()) local[idx] = std::move(local.back());
+                    local.pop_back();
+                }
+            }
+            ops += 2; // one emplace + one destroy
+        }
+        return ops;
+    });
+}
+
+template <SlotLayout Layout>
+static void run_layout(int max_threads, std::chrono::milliseconds duration)
+{
+    for (int threads = 1; threads <= max_threads; threads *= 2)
+    {
+        const double counters = run_counters<Layout>(threads, duration);
+        const double churn = run_churn<Layout>(threads, duration);
+        std::cout << "  layout=" << layout_name<Layout>()
+                  << " threads=" << threads
+                  << " counters ns/inc=" << (1e9 * threads / counters)
+                  << " churn ns/op=" << (1e9 * threads / churn) << "\n";
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const unsigned hw = std::max(2u, std::thread::hardware_concurrency());
+    const int max_threads = argc > 1 ? std::atoi(argv[1]) : static_cast<int>(hw);
+    const auto duration = std::chrono::milliseconds(argc > 2 ? std::atoi(argv[2]) : 300);
+
+    std::cout << "[SlotLayout] cache_line=" << kPoolCacheLineSize << "\n";
+
+    run_layout<SlotLayout::Natural>(max_threads, duration);
+    run_layout<SlotLayout::Dense>(max_threads, duration);
+    run_layout<SlotLayout::CacheLine>(max_threads, duration);
+
+    return 0;
+}
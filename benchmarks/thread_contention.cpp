@@ -0,0 +1,115 @@
+// benchmarks/thread_contention.cpp
+//
+// Allocation-heavy multi-threaded churn, modelled on tests/unit/thread_stress.cpp.
+// The same source is compiled once per synchronization mode (see CMakeLists.txt)
+// so the mutex build and the lock-free build can be compared side by side.
+#include "MemOx/object_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+#if defined(OxiMemPool_LockFree) && defined(OxiMemPool_ShardedCount)
+static constexpr const char* kMode = "lock-free, sharded count";
+#elif defined(OxiMemPool_LockFree)
+static constexpr const char* kMode = "lock-free";
+#elif defined(OxiMemPool_ThreadSafe)
+static constexpr const char* kMode = "mutex";
+#else
+#error "thread_contention benchmark needs OxiMemPool_ThreadSafe or OxiMemPool_LockFree"
+#endif
+
+struct BenchItem
+{
+    std::uint64_t payload[4] = {};
+};
+
+static double run_round(int num_threads, std::chrono::milliseconds duration)
+{
+    const size_t pool_capacity = static_cast<size_t>(num_threads) * 64;
+
+    ObjectPool<BenchItem> pool(pool_capacity);
+
+    std::atomic<bool> start{false};
+    std::atomic<bool> stop{false};
+    std::atomic<std::uint64_t> total_ops{0};
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads);
+
+    for (int t = 0; t < num_threads; ++t)
+    {
+        threads.emplace_back([t, &pool, &start, &stop, &total_ops]() {
+            std::mt19937_64 rng(0x9E3779B97F4A7C15ull + static_cast<std::uint64_t>(t));
+
+            std::vector<PoolHandle<BenchItem>> local;
+            local.reserve(32);
+
+            std::uint64_t ops = 0;
+
+            while (!start.load(std::memory_order_acquire)) {}
+
+            while (!stop.load(std::memory_order_relaxed))
+            {
+                try
+                {
+                    auto h = pool.emplace();
+                    h->payload[0] = ops;
+
+                    // keep a small working set so frees happen in random order
+                    if ((rng() & 3) == 0)
+                    {
+                        local.push_back(std::move(h));
+                        if (local.size() > 32)
+                        {
+                            const size_t idx = rng() % local.size();
+                            if (idx + 1 != local.size()) local[idx] = std::move(local.back());
+                            local.pop_back();
+                        }
+                    }
+                    ops += 2; // one emplace + one destroy
+                }
+                catch (...)
+                {
+                    // exhaustion is not expected with this capacity, but never abort the run
+                }
+            }
+
+            total_ops.fetch_add(ops, std::memory_order_relaxed);
+        });
+    }
+
+    const auto begin = std::chrono::steady_clock::now();
+    start.store(true, std::memory_order_release);
+    std::this_thread::sleep_for(duration);
+    stop.store(true, std::memory_order_relaxed);
+
+    for (auto& th : threads) th.join();
+
+    const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    return static_cast<double>(total_ops.load()) / elapsed;
+}
+
+int main(int argc, char** argv)
+{
+    const unsigned hw = std::max(2u, std::thread::hardware_concurrency());
+    const int max_threads = argc > 1 ? std::atoi(argv[1]) : static_cast<int>(hw);
+    const auto duration = std::chrono::milliseconds(argc > 2 ? std::atoi(argv[2]) : 500);
+
+    std::cout << "[ThreadContention] mode=" << kMode << "\n";
+
+    for (int threads = 1; threads <= max_threads; threads *= 2)
+    {
+        const double ops_per_sec = run_round(threads, duration);
+        std::cout << "  threads=" << threads
+                  << " ops/s=" << static_cast<std::uint64_t>(ops_per_sec)
+                  << " ns/op=" << (1e9 * threads / ops_per_sec) << "\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,297 @@
+/**
+* @file backing_memory.hpp
+* @brief Backing-memory policies for ObjectPool slot storage (OxiMemPool_BackingMemory).
+*
+* By default ObjectPool takes its slot memory from the aligned ::operator new.
+* A BackingPolicy instead maps pages straight from the operating system, which
+* allows huge pages, NUMA node binding and pre-faulting:
+*
+* - Linux:   mmap (optionally MAP_HUGETLB), madvise(MADV_HUGEPAGE), mbind,
+*            MAP_POPULATE
+* - Windows: VirtualAlloc / VirtualAllocExNuma, optionally MEM_LARGE_PAGES
+* - Elsewhere, and for slots aligned beyond the page size, the policy falls
+*   back to ::operator new.
+*
+* All OS requests are best effort: a failed huge-page mapping falls back to
+* regular pages and a failed NUMA binding leaves the memory unbound. Only a
+* failure to obtain memory at all is reported (nullptr).
+*
+* @author 0x1mer
+* @license MIT
+*/
+
+#pragma once
+
+#include <cstddef>    // size_t
+#include <cstdio>     // std::fopen, std::fgets
+#include <new>        // ::operator new/delete, std::align_val_t
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__linux__)
+#include <sys/mman.h>     // mmap, munmap, madvise
+#include <sys/syscall.h>  // SYS_mbind, SYS_getcpu
+#include <unistd.h>       // sysconf, syscall
+#endif
+
+/**
+ * BackingPolicy describes where an ObjectPool's slot memory comes from.
+ *
+ * - Source::Heap: aligned ::operator new (default, all other fields ignored)
+ * - Source::Os:   pages mapped directly from the operating system
+ *
+ * Huge pages:
+ * - None:        regular pages
+ * - Transparent: ask the kernel to back the mapping with transparent huge
+ *                pages (Linux MADV_HUGEPAGE; ignored on Windows)
+ * - Explicit:    reserved huge pages (Linux MAP_HUGETLB, Windows
+ *                MEM_LARGE_PAGES); falls back to Transparent if unavailable
+ */
+struct BackingPolicy
+{
+    enum class Source { Heap, Os };
+    enum class HugePages { None, Transparent, Explicit };
+
+    Source source = Source::Heap;
+    HugePages huge_pages = HugePages::None;
+    int numa_node = -1;     // node to bind the memory to, -1 for no binding
+    bool populate = false;  // fault every page in when the memory is mapped
+
+    static constexpr BackingPolicy heap() noexcept
+    {
+        return BackingPolicy{};
+    }
+
+    static constexpr BackingPolicy pages(HugePages huge_pages = HugePages::None,
+                                         int numa_node = -1,
+                                         bool populate = false) noexcept
+    {
+        return BackingPolicy{Source::Os, huge_pages, numa_node, populate};
+    }
+};
+
+/**
+ * BackingMemory implements BackingPolicy on top of the OS primitives and
+ * exposes the small amount of NUMA topology the pool front ends need.
+ */
+struct BackingMemory
+{
+    static size_t page_size() noexcept
+    {
+#if defined(_WIN32)
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        return info.dwPageSize;
+#elif defined(__linux__)
+        const long size = sysconf(_SC_PAGESIZE);
+        return size > 0 ? static_cast<size_t>(size) : 4096;
+#else
+        return 4096;
+#endif
+    }
+
+    // Granularity of explicit huge pages, 0 if the platform has none.
+    static size_t huge_page_size() noexcept
+    {
+#if defined(_WIN32)
+        return GetLargePageMinimum();
+#elif defined(__linux__)
+        return size_t{2} << 20; // default hugetlb size on x86-64 and arm64
+#else
+        return 0;
+#endif
+    }
+
+    // Number of NUMA nodes (at least 1).
+    static size_t node_count() noexcept
+    {
+#if defined(_WIN32)
+        ULONG highest = 0;
+        return GetNumaHighestNodeNumber(&highest) ? static_cast<size_t>(highest) + 1 : 1;
+#elif defined(__linux__)
+        // "0", "0-1", "0-3,5" ...: the last number is the highest node.
+        std::FILE* file = std::fopen("/sys/devices/system/node/online", "r");
+        if (!file)
+            return 1;
+
+        char buffer[256] = {};
+        const bool ok = std::fgets(buffer, sizeof(buffer), file) != nullptr;
+        std::fclose(file);
+        if (!ok)
+            return 1;
+
+        size_t highest = 0;
+        size_t current = 0;
+        for (const char* c = buffer; *c; ++c)
+        {
+            if (*c >= '0' && *c <= '9')
+                current = current * 10 + static_cast<size_t>(*c - '0');
+            else
+            {
+                highest = current > highest ? current : highest;
+                current = 0;
+            }
+        }
+        highest = current > highest ? current : highest;
+        return highest + 1;
+#else
+        return 1;
+#endif
+    }
+
+    // NUMA node of the CPU the calling thread currently runs on (0 if unknown).
+    static size_t current_node() noexcept
+    {
+#if defined(_WIN32)
+        PROCESSOR_NUMBER processor;
+        GetCurrentProcessorNumberEx(&processor);
+        USHORT node = 0;
+        return GetNumaProcessorNodeEx(&processor, &node) ? node : 0;
+#elif defined(__linux__) && defined(SYS_getcpu)
+        unsigned cpu = 0;
+        unsigned node = 0;
+        return syscall(SYS_getcpu, &cpu, &node, nullptr) == 0 ? node : 0;
+#else
+        return 0;
+#endif
+    }
+
+    // Allocates `bytes` bytes aligned to `align`. Returns nullptr on failure.
+    static void* allocate(const BackingPolicy& policy, size_t bytes, size_t align) noexcept
+    {
+        if (uses_heap(policy, bytes, align))
+            return ::operator new(bytes, std::align_val_t{align}, std::nothrow);
+
+        const size_t length = mapping_length(policy, bytes);
+#if defined(_WIN32)
+        void* memory = nullptr;
+        if (policy.huge_pages == BackingPolicy::HugePages::Explicit && huge_page_size() != 0)
+            memory = map_windows(policy, length, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES);
+        if (!memory)
+            memory = map_windows(policy, length, MEM_RESERVE | MEM_COMMIT);
+        if (memory && policy.populate)
+            touch_pages(memory, length);
+        return memory;
+#elif defined(__linux__)
+        int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#ifdef MAP_POPULATE
+        // With a NUMA binding the pages are faulted in after mbind() instead.
+        if (policy.populate && policy.numa_node < 0)
+            flags |= MAP_POPULATE;
+#endif
+        void* memory = MAP_FAILED;
+#ifdef MAP_HUGETLB
+        if (policy.huge_pages == BackingPolicy::HugePages::Explicit)
+            memory = mmap(nullptr, length, PROT_READ | PROT_WRITE, flags | MAP_HUGETLB, -1, 0);
+#endif
+        const bool hugetlb = memory != MAP_FAILED;
+        if (!hugetlb)
+            memory = mmap(nullptr, length, PROT_READ | PROT_WRITE, flags, -1, 0);
+        if (memory == MAP_FAILED)
+            return nullptr;
+
+#ifdef MADV_HUGEPAGE
+        if (!hugetlb && policy.huge_pages != BackingPolicy::HugePages::None)
+            madvise(memory, length, MADV_HUGEPAGE);
+#endif
+        if (policy.numa_node >= 0)
+        {
+            bind_to_node(memory, length, static_cast<size_t>(policy.numa_node));
+            if (policy.populate)
+                touch_pages(memory, length);
+        }
+        return memory;
+#else
+        (void)length;
+        return nullptr; // unreachable: uses_heap() is always true here
+#endif
+    }
+
+    // Releases memory obtained from allocate() with the same arguments.
+    static void release(const BackingPolicy& policy, void* memory, size_t bytes, size_t align) noexcept
+    {
+        if (!memory)
+            return;
+
+        if (uses_heap(policy, bytes, align))
+        {
+            ::operator delete(memory, std::align_val_t{align});
+            return;
+        }
+
+#if defined(_WIN32)
+        (void)bytes;
+        VirtualFree(memory, 0, MEM_RELEASE);
+#elif defined(__linux__)
+        munmap(memory, mapping_length(policy, bytes));
+#endif
+    }
+
+private:
+    // OS mappings are page aligned and cannot be empty; other requests use the heap.
+    static bool uses_heap(const BackingPolicy& policy, size_t bytes, size_t align) noexcept
+    {
+#if defined(_WIN32) || defined(__linux__)
+        return policy.source == BackingPolicy::Source::Heap || bytes == 0 || align > page_size();
+#else
+        (void)policy;
+        (void)bytes;
+        (void)align;
+        return true;
+#endif
+    }
+
+    // Length of the mapping for `bytes`; deterministic so release() can
+    // recompute it. Huge-page policies round to the huge page size so that a
+    // hugetlb mapping and its regular-page fallback have the same length.
+    static size_t mapping_length(const BackingPolicy& policy, size_t bytes) noexcept
+    {
+        size_t granule = page_size();
+        if (policy.huge_pages != BackingPolicy::HugePages::None && huge_page_size() > granule)
+            granule = huge_page_size();
+        return (bytes + granule - 1) / granule * granule;
+    }
+
+    static void touch_pages(void* memory, size_t length) noexcept
+    {
+        const size_t step = page_size();
+        auto* bytes = static_cast<volatile unsigned char*>(memory);
+        for (size_t offset = 0; offset < length; offset += step)
+            bytes[offset] = 0;
+    }
+
+#if defined(_WIN32)
+    static void* map_windows(const BackingPolicy& policy, size_t length, DWORD type) noexcept
+    {
+        if (policy.numa_node >= 0)
+            return VirtualAllocExNuma(GetCurrentProcess(), nullptr, length, type, PAGE_READWRITE,
+                                      static_cast<DWORD>(policy.numa_node));
+        return VirtualAlloc(nullptr, length, type, PAGE_READWRITE);
+    }
+#elif defined(__linux__)
+    // mbind(MPOL_BIND) through the raw syscall so that no libnuma is needed.
+    static void bind_to_node(void* memory, size_t length, size_t node) noexcept
+    {
+#ifdef SYS_mbind
+        constexpr int kMpolBind = 2;
+        constexpr unsigned kMpolMfMove = 1u << 1;
+        constexpr size_t kWordBits = sizeof(unsigned long) * 8;
+        constexpr size_t kMaxNodes = 1024;
+
+        if (node >= kMaxNodes)
+            return;
+
+        unsigned long mask[kMaxNodes / kWordBits] = {};
+        mask[node / kWordBits] = 1ul << (node % kWordBits);
+        syscall(SYS_mbind, memory, length, kMpolBind, mask, kMaxNodes + 1, kMpolMfMove);
+#else
+        (void)memory;
+        (void)length;
+        (void)node;
+#endif
+    }
+#endif
+};
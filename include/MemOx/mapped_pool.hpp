@@ -0,0 +1,266 @@
+/**
+* @file mapped_pool.hpp
+* @brief ObjectPool backed by a memory-mapped file image that survives restarts.
+*
+*     MappedObjectPool<Record, PoolThreading::LockFree> records("/var/cache/records.pool", 1 << 22);
+*     if (records.created())
+*         load_from_database(records);  // first start: fill the image
+*     // later starts: the records, free list and live count are back at once
+*
+* The image holds the slots and a header with the pool geometry and
+* PoolImageState. The free list is linked by slot indices, so the image does
+* not depend on the address it is mapped at. POSIX only.
+*
+* @author 0x1mer
+* @license MIT
+*/
+
+#pragma once
+
+#include "object_pool.hpp"
+
+#if !defined(__unix__) && !defined(__APPLE__)
+#error "mapped_pool.hpp requires POSIX mmap"
+#endif
+
+#include <cerrno>        // errno
+#include <cstring>       // std::memcpy, std::memcmp
+#include <span>          // std::span
+#include <stdexcept>     // std::runtime_error
+#include <string>        // std::string
+#include <system_error>  // std::system_error
+
+#include <fcntl.h>       // open
+#include <sys/file.h>    // flock
+#include <sys/mman.h>    // mmap, munmap
+#include <sys/stat.h>    // fstat
+#include <unistd.h>      // ftruncate, close
+
+// Bytes before the first slot of an image; slots start page-aligned.
+inline constexpr size_t kMappedPoolHeaderSize = 4096;
+
+inline constexpr char kMappedPoolMagic[8] = {'O', 'X', 'I', 'P', 'O', 'O', 'L', '\0'};
+inline constexpr std::uint32_t kMappedPoolVersion = 1;
+
+/**
+ * First bytes of a pool image. Geometry and `type_tag` must match for an
+ * image to be attached; `clean` is cleared while a process has the image
+ * attached and set again, together with `state`, when it detaches.
+ */
+struct MappedPoolHeader
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t clean;
+    std::uint64_t object_size;
+    std::uint64_t object_align;
+    std::uint64_t slot_size;
+    std::uint64_t slot_align;
+    std::uint64_t capacity;
+    std::uint64_t type_tag;
+    PoolImageState state;
+};
+
+static_assert(sizeof(MappedPoolHeader) <= kMappedPoolHeaderSize);
+
+/**
+ * Opens, locks and maps the image file of a MappedObjectPool. It is a
+ * separate base so that the mapping exists before the ObjectPool base is
+ * constructed over it, and is unmapped after that base is destroyed.
+ */
+template <typename T, PoolThreading Threading>
+class MappedPoolStorage
+{
+protected:
+    using pool_type = ObjectPool<T, Threading>;
+
+    static_assert(pool_type::slot_align <= kMappedPoolHeaderSize,
+                  "slots of a mapped pool must not be aligned beyond the header size");
+
+    int fd_ = -1;
+    std::byte* base_ = nullptr;
+    size_t bytes_ = 0;
+    bool created_ = false;
+    PoolImageState state_{};
+
+    MappedPoolStorage(const std::string& path, size_t capacity, std::uint64_t type_tag)
+    {
+        if (capacity == 0 || capacity > (std::numeric_limits<size_t>::max() - kMappedPoolHeaderSize) /
+                                            pool_type::slot_size)
+            throw std::runtime_error("MappedObjectPool: invalid capacity");
+        bytes_ = kMappedPoolHeaderSize + capacity * pool_type::slot_size;
+
+        fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (fd_ < 0)
+            fail_errno("open");
+        // One process at a time; the lock dies with the process.
+        if (::flock(fd_, LOCK_EX | LOCK_NB) != 0)
+            fail_errno("image is attached by another process");
+
+        struct stat st{};
+        if (::fstat(fd_, &st) != 0)
+            fail_errno("fstat");
+        created_ = st.st_size == 0;
+        if (created_)
+        {
+            if (::ftruncate(fd_, static_cast<off_t>(bytes_)) != 0)
+                fail_errno("ftruncate");
+        }
+        else if (static_cast<std::uint64_t>(st.st_size) != bytes_)
+        {
+            fail("image size does not match the pool");
+        }
+
+        void* base = ::mmap(nullptr, bytes_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (base == MAP_FAILED)
+            fail_errno("mmap");
+        base_ = static_cast<std::byte*>(base);
+
+        MappedPoolHeader header = expected_header(capacity, type_tag);
+        if (!created_)
+        {
+            MappedPoolHeader found;
+            std::memcpy(&found, base_, sizeof(found));
+            if (std::memcmp(found.magic, header.magic, sizeof(header.magic)) != 0 ||
+                found.version != header.version)
+                fail("not a pool image");
+            if (found.object_size != header.object_size || found.object_align != header.object_align ||
+                found.slot_size != header.slot_size || found.slot_align != header.slot_align ||
+                found.capacity != header.capacity || found.type_tag != header.type_tag)
+                fail("image was written for a different type or capacity");
+            if (found.clean != 1)
+                fail("image was not detached cleanly");
+            state_ = found.state;
+        }
+
+        // Marked in use until the pool detaches; a crash leaves it unclean.
+        header.clean = 0;
+        header.state = state_;
+        std::memcpy(base_, &header, sizeof(header));
+    }
+
+    ~MappedPoolStorage() noexcept
+    {
+        release();
+    }
+
+    std::span<std::byte> slots() const noexcept
+    {
+        return std::span<std::byte>(base_ + kMappedPoolHeaderSize, bytes_ - kMappedPoolHeaderSize);
+    }
+
+    // Stores the state of the detached pool and marks the image clean.
+    void save(const PoolImageState& state) noexcept
+    {
+        auto* header = reinterpret_cast<MappedPoolHeader*>(base_);
+        header->state = state;
+        header->clean = 1;
+    }
+
+private:
+    static MappedPoolHeader expected_header(size_t capacity, std::uint64_t type_tag) noexcept
+    {
+        MappedPoolHeader header{};
+        std::memcpy(header.magic, kMappedPoolMagic, sizeof(header.magic));
+        header.version = kMappedPoolVersion;
+        header.object_size = sizeof(T);
+        header.object_align = alignof(T);
+        header.slot_size = pool_type::slot_size;
+        header.slot_align = pool_type::slot_align;
+        header.capacity = capacity;
+        header.type_tag = type_tag;
+        return header;
+    }
+
+    void release() noexcept
+    {
+        if (base_)
+            ::munmap(base_, bytes_);
+        if (fd_ >= 0)
+            ::close(fd_);
+        base_ = nullptr;
+        fd_ = -1;
+    }
+
+    [[noreturn]] void fail_errno(const char* what)
+    {
+        const int err = errno;
+        release();
+        throw std::system_error(err, std::generic_category(), std::string("MappedObjectPool: ") + what);
+    }
+
+    [[noreturn]] void fail(const char* what)
+    {
+        release();
+        throw std::runtime_error(std::string("MappedObjectPool: ") + what);
+    }
+};
+
+/**
+ * MappedObjectPool is a fixed ObjectPool of `capacity` slots stored in the
+ * file at `path`, for trivially copyable T (see ObjectPool::supports_image).
+ * A missing or empty file is created. An existing image is attached as it was
+ * left: its objects are live (unowned, see emplace_unowned()), the free list
+ * is intact and freed slots are reused first. Attaching maps the file and
+ * restores PoolImageState in O(1), without reading the slots (with
+ * OxiMemPool_Occupancy the bitmap is rebuilt from the free list).
+ *
+ * Objects are found again by the application: by slot index (at(),
+ * index_of()), for example from an index stored in the records themselves, or
+ * with for_each() when the occupancy bitmap is enabled.
+ *
+ * The destructor detaches: it saves the state and marks the image clean.
+ * Objects created through emplace() must be released, or their handles
+ * abandoned, before that; the objects stay in the image either way. Errors:
+ * std::system_error for failing system calls and when another process has
+ * the image attached, std::runtime_error for an image of another type, tag or
+ * capacity, or one that was not detached cleanly (crash). Pool errors are
+ * reported as in ObjectPool.
+ *
+ * The image reaches the disk as the kernel writes the page cache back: a
+ * restarted process always sees it; surviving a machine crash needs msync.
+ * An image in shared memory (e.g. /dev/shm) can be handed from one process to
+ * another, but only one process has it attached at a time (flock).
+ */
+template <typename T, PoolThreading Threading = kDefaultPoolThreading>
+class MappedObjectPool : private MappedPoolStorage<T, Threading>, public ObjectPool<T, Threading>
+{
+    using storage_type = MappedPoolStorage<T, Threading>;
+    using pool_type = ObjectPool<T, Threading>;
+
+    static_assert(pool_type::supports_image,
+                  "MappedObjectPool needs a trivially copyable T and an index-linked LIFO free list "
+                  "(PoolThreading::LockFree or SlotLayout::Dense), without OxiMemPool_Hardened");
+
+public:
+    /**
+     * Opens or creates the image at `path`. `type_tag` is stored in a new
+     * image and must match when attaching, e.g. a schema version of T.
+     */
+    MappedObjectPool(const std::string& path, size_t capacity, std::uint64_t type_tag = 0,
+                     LogFunction log = nullptr)
+        : storage_type(path, capacity, type_tag),
+          pool_type(storage_type::slots(), storage_type::state_, log)
+    {
+    }
+
+    ~MappedObjectPool() noexcept
+    {
+        storage_type::save(pool_type::detach_image());
+    }
+
+    MappedObjectPool(const MappedObjectPool&) = delete;
+    MappedObjectPool& operator=(const MappedObjectPool&) = delete;
+
+    // True if the image was created by this pool, false if it was attached.
+    bool created() const noexcept { return storage_type::created_; }
+
+    // The object in slot `index` (index_of()); the slot must hold a live object.
+    T* at(size_t index) const noexcept
+    {
+        return std::launder(reinterpret_cast<T*>(this->slot_address(index)));
+    }
+
+    // Slot index of an object of this pool, stable across restarts.
+    size_t index_of(const T* object) const noexcept { return this->slot_index(object); }
+};
@@ -0,0 +1,118 @@
+/**
+* @file numa_pool.hpp
+* @brief One ObjectPool per NUMA node, routing emplace() to the caller's node.
+*
+* Requires OxiMemPool_BackingMemory to be defined before object_pool.hpp is
+* first included.
+*
+*     #define OxiMemPool_BackingMemory
+*     #include "MemOx/numa_pool.hpp"
+*
+*     NumaObjectPool<Order> orders(1 << 20, BackingPolicy::pages(BackingPolicy::HugePages::Transparent));
+*     auto h = orders.emplace(42);   // slot on the node the calling thread runs on
+*
+* @author 0x1mer
+* @license MIT
+*/
+
+#pragma once
+
+#ifndef OxiMemPool_BackingMemory
+#error "numa_pool.hpp requires OxiMemPool_BackingMemory"
+#endif
+
+#include "object_pool.hpp"
+
+#include <memory>     // std::unique_ptr
+#include <vector>     // std::vector
+
+/**
+ * NumaObjectPool owns one ObjectPool per NUMA node, each with its slot memory
+ * bound to that node. emplace() allocates from the pool of the node the
+ * calling thread currently runs on; the returned handle frees back to the pool
+ * it came from, so objects handed to threads on other nodes stay valid.
+ *
+ * Every node pool is independent: exhaustion of the local node is reported as
+ * in ObjectPool::emplace() and does not spill over to other nodes
+ * (use emplace_on() for explicit placement).
+ */
+template <typename T, PoolThreading Threading = PoolThreading::Mutex>
+    requires std::destructible<T>
+class NumaObjectPool
+{
+    static_assert(Threading != PoolThreading::SingleThread && Threading != PoolThreading::OwnerThread,
+                  "NumaObjectPool is shared between threads on different nodes");
+
+public:
+    using pool_type = ObjectPool<T, Threading>;
+    using handle_type = typename pool_type::handle_type;
+
+private:
+    std::vector<std::unique_ptr<pool_type>> pools_; // indexed by node
+
+public:
+    /**
+     * Creates node_count() pools of `capacity_per_node` slots. `backing`
+     * selects page size and pre-faulting; its source and node are overridden
+     * so that each pool maps OS pages bound to its own node.
+     */
+    explicit NumaObjectPool(size_t capacity_per_node,
+                            BackingPolicy backing = BackingPolicy::pages(),
+                            GrowthPolicy growth = GrowthPolicy{},
+                            LogFunction log = nullptr)
+    {
+        const size_t nodes = BackingMemory::node_count();
+        pools_.reserve(nodes);
+        for (size_t node = 0; node < nodes; ++node)
+        {
+            BackingPolicy local = backing;
+            local.source = BackingPolicy::Source::Os;
+            local.numa_node = static_cast<int>(node);
+            pools_.push_back(std::make_unique<pool_type>(capacity_per_node, growth, local, log));
+        }
+    }
+
+    NumaObjectPool(const NumaObjectPool&) = delete;
+    NumaObjectPool& operator=(const NumaObjectPool&) = delete;
+
+    // Constructs an object in the pool of the calling thread's node.
+    template <typename... Args>
+    handle_type emplace(Args&&... args)
+    {
+        return local_pool().emplace(std::forward<Args>(args)...);
+    }
+
+    // Constructs an object in the pool of `node` (clamped to the last node).
+    template <typename... Args>
+    handle_type emplace_on(size_t node, Args&&... args)
+    {
+        return pool(node).emplace(std::forward<Args>(args)...);
+    }
+
+    pool_type& local_pool() noexcept { return pool(BackingMemory::current_node()); }
+
+    pool_type& pool(size_t node) noexcept
+    {
+        return *pools_[node < pools_.size() ? node : pools_.size() - 1];
+    }
+
+    size_t node_count() const noexcept { return pools_.size(); }
+
+    // Live objects over all nodes
+    size_t size() const noexcept
+    {
+        size_t total = 0;
+        for (const auto& p : pools_)
+            total += p->size();
+        return total;
+    }
+
+    // Committed slots over all nodes
+    size_t capacity() const noexcept
+    {
+        size_t total = 0;
+        for (const auto& p : pools_)
+            total += p->capacity();
+        return total;
+    }
+};
@@ -22,16 +22,74 @@
 * Features:
 * - Predictable memory usage (single allocation at construction time)
 * - Move-only RAII handle for automatic object lifetime management
-* - Optional logging via user-provided LogFunction
-* - Optional basic thread-safety via OxiMemPool_ThreadSafe (single mutex)
+* - Optional logging via user-provided LogFunction (compiled out by OxiMemPool_NoLogging)
+* - Optional allocation-free event hook via OxiMemPool_EventHook
+* - Optional allocation statistics (stats()) via OxiMemPool_Stats
+* - Optional huge-page / NUMA-aware backing memory via OxiMemPool_BackingMemory
+* - Per-pool threading policy (PoolThreading): single-threaded, single mutex,
+*   lock-free (tagged Treiber stack) or owner thread with a remote-free list;
+*   the default follows OxiMemPool_ThreadSafe / OxiMemPool_LockFree
+* - Optional per-thread slot caches via OxiMemPool_ThreadCache (magazines)
+* - Optional growth in chained chunks with stable addresses (GrowthPolicy)
+* - Batch allocation/release (emplace_n / release_bulk) in one lock acquisition
+* - Startup pre-faulting of slot memory (warm)
+* - Arena-style reset of all objects at once (emplace_unowned / release_all)
+* - Defragmentation of movable objects with reference patching (compact)
+* - Pointer-sized and 32-bit handles for pools with static storage duration
+* - Pools over a caller-supplied buffer or embedded storage (static_object_pool.hpp)
+* - Size-class front end for small heterogeneous types (size_class_pool.hpp)
+* - Pools for class hierarchies with emplace<Derived>() (polymorphic_pool.hpp)
+* - Position-independent pool images in a memory-mapped file (mapped_pool.hpp)
+* - std::pmr::memory_resource / allocator adapters for node containers (pool_resource.hpp)
+* - Optional generational weak references via OxiMemPool_WeakRefs
+* - Optional reference-counted shared handles (emplace_shared) via
+*   OxiMemPool_SharedHandles
+* - Optional occupancy bitmap with live-object iteration (for_each /
+*   parallel_for_each) via OxiMemPool_Occupancy
+* - Optional waiting on exhaustion (co_await async_emplace / emplace_wait) via
+*   OxiMemPool_AsyncEmplace
+* - Optional per-thread sharded live-object counter via OxiMemPool_ShardedCount
+* - Optional hardening (poisoned free slots, guard words, free-list and
+*   double-free checks, ASan annotations) via OxiMemPool_Hardened
 * - Optional user-defined error callback via OxiMemPool_ErrCallback
 * - Proper alignment and efficient storage reuse via a singly-linked free list
+* - Compile-time slot layout (SlotLayout): natural, cache-line padded against
+*   false sharing, or dense with 32-bit free-list links
+* - Compile-time slot reuse order (ReusePolicy): LIFO, lowest address first
+*   (free-slot bitmap) or FIFO
+* - Prefetch of the next free slot on every pop, plus peek_next_slot() /
+*   prefetch_next_slot() hints for pipelines
+* - Optional sampled call-site profiling of live objects
+*   (dump_live_allocations) via OxiMemPool_Profile
 *
 * Notes:
 * - The pool stores raw memory and explicitly constructs/destructs objects of T
 * using std::construct_at and std::destroy_at.
 * - T must satisfy std::destructible.
-* - When thread-safety is enabled, pool operations are serialized by a single mutex.
+* - A SingleThread pool uses no locks and no atomic read-modify-write operations.
+* - In Mutex mode, pool operations are serialized by a single mutex.
+* - In lock-free mode the free list is an index+tag Treiber stack and the bump
+*   index is advanced with an atomic fetch_add; capacity is limited to 2^32 - 2.
+* - In owner-thread mode only the owner allocates; slots freed by other threads
+*   are pushed onto an MPSC list (one CAS) that the owner takes in one exchange.
+* - With thread caches enabled, each thread keeps a small magazine of free slots
+*   per pool and exchanges them with the shared free list in batches.
+* - A growable pool never moves existing objects: new capacity is added as
+*   separate chunks and entirely free chunks are only released by shrink_to_fit().
+* - With weak references enabled, every slot has a 32-bit generation counter in a
+*   side array (slot size is unchanged) that is bumped each time an object dies.
+* - With the occupancy bitmap enabled, live slots are tracked by one bit per slot
+*   in a side array as well.
+* - With shared handles enabled, every slot has a 32-bit reference count in a
+*   side array too, so emplace_shared() allocates no control block.
+* - With waiting enabled, a freed slot is handed straight to the oldest waiter
+*   (FIFO); frees pay one load of the waiter count while nobody waits.
+* - With sharded counting, thread-safe pools track size() in 16 cache-line
+*   shards picked per thread instead of one shared atomic counter.
+* - With hardening enabled, every slot ends in a 64-bit guard word, so slots
+*   grow by 8 bytes (plus alignment to 8); detected corruption aborts.
+* - With profiling enabled, every slot has a 16-byte sample record (call site
+*   and time) in a side array; only sampled allocations write it.
 *
 * @author 0x1mer
 * @license MIT
@@ -51,20 +109,376 @@
 #include <string>     // std::string, std::to_string
 #include <atomic>     // std::atomic
 #include <limits>     // std::numeric_limits
+#include <type_traits> // std::remove_reference_t
 
 
 
 
 using LogFunction = void (*)(const std::string&);
 
-#ifdef OxiMemPool_ThreadSafe
-#include <mutex>      // std::mutex, std::lock_guard, std::unique_lock
+/**
+ * Pool events reported to an EventHook (OxiMemPool_EventHook).
+ * `slot` is the affected slot (or chunk) and `index` is its slot index, except
+ * where noted otherwise. Hooks are called synchronously, possibly while the pool
+ * lock is held, and must not re-enter the pool.
+ */
+enum class PoolEvent : std::uint8_t
+{
+    Init,           // slot = initial block, index = its slot count
+    AllocNew,       // slot taken from the untouched region
+    AllocReuse,     // slot taken from the free list
+    AllocBulk,      // slot = nullptr, index = slots reserved as one run
+    Free,           // slot returned to the free list
+    FreeBatch,      // slot = nullptr, index = slots spliced onto the free list at once
+    ObjectDestroy,  // object about to be destroyed
+    HandleDestroy,  // an owning handle released its object
+    CacheRefill,    // slot = nullptr, index = slots now in the thread's magazine
+    CacheFlush,     // slot = nullptr, index = slots moved back to the free list
+    Grow,           // slot = new chunk, index = slots added
+    Shrink,         // slot = nullptr, index = slots released
+    Warm,           // slot = nullptr, index = slots pre-faulted by warm()
+    Reset,          // slot = nullptr, index = objects released by release_all()
+    Compact,        // slot = nullptr, index = objects moved by compact()
+    RemoteReclaim,  // slot = nullptr, index = remotely freed slots taken back by the owner
+    Error,          // slot = nullptr, index = error code
+};
+
+#ifdef OxiMemPool_EventHook
+using EventHook = void (*)(PoolEvent event, const void* slot, size_t index);
+#endif
+
+#ifdef OxiMemPool_Stats
+/**
+ * Snapshot of the counters of one ObjectPool (OxiMemPool_Stats), see stats().
+ * Event counters are monotonic; the others are current values.
+ *
+ * With thread caches the allocation and free counters describe traffic of the
+ * shared free list, i.e. slots moved into and out of magazines.
+ */
+struct PoolStats
+{
+    size_t live = 0;                   // size()
+    size_t peak_live = 0;              // high-water mark of size() (an upper bound with OxiMemPool_ShardedCount)
+    size_t capacity = 0;               // capacity()
+    size_t touched_slots = 0;          // slots handed out from the untouched region (since release_all())
+    std::uint64_t fresh_allocs = 0;    // slots taken from the untouched region
+    std::uint64_t reused_allocs = 0;   // slots taken from the free list
+    std::uint64_t frees = 0;           // slots returned to the free list
+    std::uint64_t exhausted = 0;       // allocations that failed for lack of capacity
+    std::uint64_t grows = 0;           // chunks added (or re-committed)
+    std::uint64_t shrinks = 0;         // shrink_to_fit() calls that released memory
+    std::uint64_t lock_contended = 0;  // Mutex mode: lock acquisitions that had to wait
+    std::uint64_t lock_wait_ns = 0;    // Mutex mode: total time spent waiting for the lock
+};
+#endif
+
+#ifdef OxiMemPool_Profile
+// Age classes of PoolAllocationSite::age_histogram: < 1 ms, < 10 ms, < 100 ms,
+// < 1 s, < 10 s, < 100 s and older.
+inline constexpr size_t kPoolProfileAgeBuckets = 7;
+
+/**
+ * Live sampled objects of one call site (OxiMemPool_Profile), see
+ * ObjectPool::live_allocation_sites(). `site` is the return address of the
+ * emplace() call in the application's code.
+ */
+struct PoolAllocationSite
+{
+    const void* site = nullptr;
+    size_t sampled = 0;           // live objects sampled at this site
+    size_t estimated_live = 0;    // sampled * profile_interval()
+    std::uint64_t oldest_ns = 0;  // age of the oldest sampled object
+    size_t age_histogram[kPoolProfileAgeBuckets] = {};
+};
+#endif
+
+/**
+ * Allocation state of a fixed pool whose slots live in a caller-supplied
+ * buffer, see ObjectPool::image_state(). Together with the slot bytes it
+ * describes the pool completely, and it holds no addresses: a buffer copied,
+ * mapped at another address or reopened by another process is restored with
+ * ObjectPool(buffer, state).
+ */
+struct PoolImageState
+{
+    std::uint64_t free_head = 0; // slot index + 1 of the first free slot, 0 if none
+    std::uint64_t bump = 0;      // slots handed out from the untouched region
+    std::uint64_t live = 0;      // live objects
+};
+
+#if defined(OxiMemPool_ThreadSafe) && defined(OxiMemPool_LockFree)
+#error "OxiMemPool_ThreadSafe and OxiMemPool_LockFree are mutually exclusive"
+#endif
+
+#include <mutex>      // std::mutex, std::lock_guard
+#include <span>       // std::span
+#include <thread>     // std::this_thread::get_id
+#include <vector>     // std::vector
+#include <algorithm>  // std::sort
+#include <bit>        // std::countr_zero
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h> // madvise
+#include <unistd.h>   // sysconf
+#endif
+
+#ifdef OxiMemPool_Stats
+#include <chrono>     // std::chrono::steady_clock
+#endif
+
+#ifdef OxiMemPool_Profile
+#include <chrono>     // std::chrono::steady_clock
+#include <cstdio>     // std::snprintf
+#include <functional> // std::less
+#if defined(__unix__) || defined(__APPLE__)
+#include <dlfcn.h>    // dladdr
+#endif
+#ifndef OxiMemPool_ProfileInterval
+#define OxiMemPool_ProfileInterval 1024
+#endif
+// The allocating entry points are forced inline so that the out-of-line
+// sampling path sees the application's call site as its return address.
+#if defined(__GNUC__) || defined(__clang__)
+#define OxiMemPool_ProfileInline [[gnu::always_inline]]
+#define OxiMemPool_ProfileNoInline [[gnu::noinline]]
+#define OxiMemPool_ReturnAddress() __builtin_return_address(0)
+#elif defined(_MSC_VER)
+#include <intrin.h>   // _ReturnAddress
+#define OxiMemPool_ProfileInline __forceinline
+#define OxiMemPool_ProfileNoInline __declspec(noinline)
+#define OxiMemPool_ReturnAddress() _ReturnAddress()
+#else
+#error "OxiMemPool_Profile needs GCC, Clang or MSVC to capture call sites"
+#endif
+#else
+#define OxiMemPool_ProfileInline
+#endif
+
+#ifdef OxiMemPool_Hardened
+// Double frees are detected through the occupancy bitmap.
+#ifndef OxiMemPool_Occupancy
+#define OxiMemPool_Occupancy
+#endif
+#include <cstdlib>    // std::abort
+#include <cstring>    // std::memcpy, std::memset
+#if defined(__SANITIZE_ADDRESS__)
+#define OxiMemPool_AsanPoisoning
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define OxiMemPool_AsanPoisoning
+#endif
+#endif
+#ifdef OxiMemPool_AsanPoisoning
+#include <sanitizer/asan_interface.h> // ASAN_POISON_MEMORY_REGION
+#endif
+#endif
+
+// Under ThreadSanitizer the speculative free-list read of the lock-free mode
+// (see allocate_lock_free()) is excluded from race detection.
+#if defined(__SANITIZE_THREAD__)
+#define OxiMemPool_TsanAnnotations
+#elif defined(__has_feature)
+#if __has_feature(thread_sanitizer)
+#define OxiMemPool_TsanAnnotations
+#endif
+#endif
+#ifdef OxiMemPool_TsanAnnotations
+// Dynamic annotations provided by the TSan runtime.
+extern "C" void AnnotateIgnoreReadsBegin(const char* file, int line);
+extern "C" void AnnotateIgnoreReadsEnd(const char* file, int line);
+#endif
+
+#ifdef OxiMemPool_Occupancy
+#include <exception>  // std::exception_ptr
+#include <latch>      // std::latch
+#endif
+
+#ifdef OxiMemPool_AsyncEmplace
+#include <chrono>             // std::chrono::steady_clock
+#include <condition_variable> // std::condition_variable
+#include <coroutine>          // std::coroutine_handle
+#include <tuple>              // std::tuple, std::apply
+#endif
+
+#ifdef OxiMemPool_BackingMemory
+#include "backing_memory.hpp" // BackingPolicy, BackingMemory
+#endif
+
+/**
+ * Synchronization strategy of an ObjectPool, chosen per pool through its second
+ * template parameter, so thread-safe and single-threaded pools can be mixed in
+ * one translation unit:
+ *
+ * - SingleThread: no locks, plain counters, no fences
+ * - Mutex:        free-list operations are serialized by one std::mutex
+ * - LockFree:     index+tag Treiber stack and atomic bump index
+ * - OwnerThread:  one owner thread allocates and frees without locks; any
+ *                 other thread may destroy objects, and their slots are
+ *                 pushed onto a lock-free MPSC "remote free" list with a single
+ *                 CAS. When its free list runs dry the owner takes the whole
+ *                 remote list back with one exchange (delayed free, as in
+ *                 mimalloc). The constructing thread is the owner until
+ *                 set_owner_thread() is called.
+ *
+ * The default keeps the meaning of the configuration macros: LockFree with
+ * OxiMemPool_LockFree, Mutex with OxiMemPool_ThreadSafe, SingleThread otherwise.
+ */
+enum class PoolThreading { SingleThread, Mutex, LockFree, OwnerThread };
+
+#if defined(OxiMemPool_LockFree)
+inline constexpr PoolThreading kDefaultPoolThreading = PoolThreading::LockFree;
+#elif defined(OxiMemPool_ThreadSafe)
+inline constexpr PoolThreading kDefaultPoolThreading = PoolThreading::Mutex;
+#else
+inline constexpr PoolThreading kDefaultPoolThreading = PoolThreading::SingleThread;
+#endif
+
+#if defined(OxiMemPool_CacheLineSlots) && defined(OxiMemPool_DenseSlots)
+#error "OxiMemPool_CacheLineSlots and OxiMemPool_DenseSlots are mutually exclusive"
 #endif
 
+#if defined(OxiMemPool_ReuseLowestAddress) && defined(OxiMemPool_ReuseFifo)
+#error "OxiMemPool_ReuseLowestAddress and OxiMemPool_ReuseFifo are mutually exclusive"
+#endif
+
+/**
+ * Size of the unit of cache coherence that padded slots are aligned to. Fixed
+ * at 64 bytes (x86-64 and most arm64 cores) unless OxiMemPool_CacheLineSize
+ * is defined; std::hardware_destructive_interference_size is not used because
+ * it may differ between translation units compiled with different flags.
+ */
+#ifdef OxiMemPool_CacheLineSize
+inline constexpr size_t kPoolCacheLineSize = OxiMemPool_CacheLineSize;
+#else
+inline constexpr size_t kPoolCacheLineSize = 64;
+#endif
+
+static_assert((kPoolCacheLineSize & (kPoolCacheLineSize - 1)) == 0,
+              "OxiMemPool_CacheLineSize must be a power of two");
+
+/**
+ * Hints the CPU to load the cache line at `p` for writing. Never faults; a
+ * no-op on compilers without __builtin_prefetch.
+ */
+inline void pool_prefetch([[maybe_unused]] const void* p) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(p, 1, 3);
+#endif
+}
+
+/**
+ * Memory layout of the slots of an ObjectPool<T>:
+ *
+ * - Natural:   slot = T rounded up to the free-list link (pointer-sized, or
+ *              32-bit in lock-free mode)
+ * - CacheLine: every slot starts on its own cache line (kPoolCacheLineSize), so
+ *              objects written by different threads never share a line
+ * - Dense:     free slots are linked by a 32-bit index in every threading
+ *              policy, so types of 4 bytes or less are not padded to a pointer;
+ *              capacity is limited to 2^32 - 2 slots and a free costs an index
+ *              computation (intended for read-mostly types)
+ *
+ * The default is Natural, CacheLine with OxiMemPool_CacheLineSlots or Dense
+ * with OxiMemPool_DenseSlots. Specialize PoolSlotLayout to choose per type:
+ *
+ *     template <> struct PoolSlotLayout<ConnectionCounters>
+ *     {
+ *         static constexpr SlotLayout value = SlotLayout::CacheLine;
+ *     };
+ */
+enum class SlotLayout { Natural, CacheLine, Dense };
+
+#if defined(OxiMemPool_CacheLineSlots)
+inline constexpr SlotLayout kDefaultSlotLayout = SlotLayout::CacheLine;
+#elif defined(OxiMemPool_DenseSlots)
+inline constexpr SlotLayout kDefaultSlotLayout = SlotLayout::Dense;
+#else
+inline constexpr SlotLayout kDefaultSlotLayout = SlotLayout::Natural;
+#endif
+
+template <typename T>
+struct PoolSlotLayout
+{
+    static constexpr SlotLayout value = kDefaultSlotLayout;
+};
+
+/**
+ * Order in which an ObjectPool<T> hands out freed slots again:
+ *
+ * - Lifo:          the most recently freed slot first (cache-hot; default)
+ * - LowestAddress: the free slot with the lowest address first, found in a
+ *                  two-level bitmap of free slots; keeps live objects packed
+ *                  into the fewest pages and cache lines after random frees
+ * - Fifo:          the least recently freed slot first, so a freed slot is
+ *                  reused as late as possible (e.g. to widen the window in
+ *                  which stale pointers of user lock-free structures still see
+ *                  a dead object rather than a new one)
+ *
+ * Untouched slots are used only once the free slots are exhausted, as before.
+ * The policy applies to SingleThread and Mutex pools; lock-free pools always
+ * reuse LIFO (Treiber stack). Thread caches (OxiMemPool_ThreadCache) are
+ * LIFO by nature and are bypassed by the other policies.
+ *
+ * The default is Lifo, LowestAddress with OxiMemPool_ReuseLowestAddress or
+ * Fifo with OxiMemPool_ReuseFifo. Specialize PoolReusePolicy to choose per type:
+ *
+ *     template <> struct PoolReusePolicy<Particle>
+ *     {
+ *         static constexpr ReusePolicy value = ReusePolicy::LowestAddress;
+ *     };
+ */
+enum class ReusePolicy { Lifo, LowestAddress, Fifo };
+
+#if defined(OxiMemPool_ReuseLowestAddress)
+inline constexpr ReusePolicy kDefaultReusePolicy = ReusePolicy::LowestAddress;
+#elif defined(OxiMemPool_ReuseFifo)
+inline constexpr ReusePolicy kDefaultReusePolicy = ReusePolicy::Fifo;
+#else
+inline constexpr ReusePolicy kDefaultReusePolicy = ReusePolicy::Lifo;
+#endif
+
+template <typename T>
+struct PoolReusePolicy
+{
+    static constexpr ReusePolicy value = kDefaultReusePolicy;
+};
+
 #ifdef OxiMemPool_ErrCallback
 using ErrorCallback = void (*)(const char*, size_t);
 #endif
 
+/**
+ * GrowthPolicy describes how an ObjectPool adds capacity once the initial block
+ * is exhausted. Each growth step allocates one new chunk; chunks are never moved,
+ * so objects keep their addresses for the whole lifetime of the pool.
+ *
+ * - None:      fixed-capacity pool (default)
+ * - FixedStep: every new chunk holds `step` slots
+ * - Geometric: every new chunk holds `factor` times the slots of the previous one
+ *
+ * Growth stops at `max_capacity` total slots; the last chunk is clamped to it.
+ */
+struct GrowthPolicy
+{
+    enum class Mode { None, FixedStep, Geometric };
+
+    Mode mode = Mode::None;
+    size_t step = 0;          // FixedStep: slots per new chunk
+    size_t factor = 2;        // Geometric: size ratio between consecutive chunks
+    size_t max_capacity = 0;  // upper bound for the total number of slots
+
+    static constexpr GrowthPolicy fixed_step(size_t step, size_t max_capacity) noexcept
+    {
+        return GrowthPolicy{Mode::FixedStep, step, 2, max_capacity};
+    }
+
+    static constexpr GrowthPolicy geometric(size_t max_capacity, size_t factor = 2) noexcept
+    {
+        return GrowthPolicy{Mode::Geometric, 0, factor, max_capacity};
+    }
+};
+
 /**
  * ObjectPool manages a preallocated block of raw memory divided into fixed-size slots
  * and provides fast allocation/free for objects of type T.
@@ -73,29 +487,69 @@ using ErrorCallback = void (*)(const char*, size_t);
  *
  * Requirement: T must satisfy std::destructible (see requires clause).
  */
-template <typename T>
+template <typename T, PoolThreading Threading = kDefaultPoolThreading>
     requires std::destructible<T>
 class ObjectPool;
 
+template <auto& Pool>
+class CompactPoolHandle;
+
+template <auto& Pool>
+class PoolIndexHandle;
+
+template <typename T, PoolThreading Threading = kDefaultPoolThreading>
+class SlabHandle;
+
+template <PoolThreading Threading>
+class SizeClassPool;
+
+template <typename Base, size_t SlotSize, size_t SlotAlign, PoolThreading Threading>
+class PolymorphicPool;
+
+template <typename T, PoolThreading Threading>
+class MappedObjectPool;
+
+#ifdef OxiMemPool_WeakRefs
+template <typename T, PoolThreading Threading = kDefaultPoolThreading>
+    requires std::destructible<T>
+class PoolWeakRef;
+#endif
+
+#ifdef OxiMemPool_SharedHandles
+template <typename T, PoolThreading Threading = kDefaultPoolThreading>
+    requires std::destructible<T>
+class PoolSharedHandle;
+#endif
+
 /**
  * PoolHandle is a lightweight RAII wrapper for an object allocated from ObjectPool.
  * When the handle is destroyed, the object's destructor is called and the slot is
  * returned back to the pool.
  * Copying is disabled; move semantics are supported (move-only type).
  */
-template <typename T>
+template <typename T, PoolThreading Threading = kDefaultPoolThreading>
     requires std::destructible<T>
 class PoolHandle
 {
 private:
-    ObjectPool<T>* pool_ = nullptr; // owning pool
-    T* object_ = nullptr;           // managed object
+    ObjectPool<T, Threading>* pool_ = nullptr; // owning pool
+    T* object_ = nullptr;                      // managed object
 
-    friend class ObjectPool<T>;
+    friend class ObjectPool<T, Threading>;
+    template <auto& Pool> friend class CompactPoolHandle;
+    template <auto& Pool> friend class PoolIndexHandle;
+    template <PoolThreading> friend class SizeClassPool;
+    template <typename, size_t, size_t, PoolThreading> friend class PolymorphicPool;
+#ifdef OxiMemPool_WeakRefs
+    friend class PoolWeakRef<T, Threading>;
+#endif
+#ifdef OxiMemPool_SharedHandles
+    friend class PoolSharedHandle<T, Threading>;
+#endif
 
     PoolHandle() noexcept = default;
 
-    PoolHandle(ObjectPool<T>& pool, T* object) noexcept
+    PoolHandle(ObjectPool<T, Threading>& pool, T* object) noexcept
         : pool_(&pool), object_(object) {}
 
     /**
@@ -108,13 +562,10 @@ private:
         if (!pool_ || !object_)
             return;
 
-        if (pool_->log_function_)
-        {
-            pool_->log_function_(
-                "[PoolHandle][DESTROY] object=" +
-                std::to_string(reinterpret_cast<std::uintptr_t>(object_)) +
-                "\n");
-        }
+        pool_->trace_slot(PoolEvent::HandleDestroy, object_, [&] {
+            return "[PoolHandle][DESTROY] object=" +
+                   std::to_string(reinterpret_cast<std::uintptr_t>(object_)) + "\n";
+        });
 
         pool_->destroy_object(object_);
         pool_ = nullptr;
@@ -161,240 +612,4528 @@ public:
 /**
  * ObjectPool implementation.
  * Manages raw memory storage and a free-list of available slots.
- * Uses a simple LIFO free-list allocator with optional logging and error callbacks.
+ * Uses a LIFO free-list allocator by default (see ReusePolicy) with optional
+ * logging and error callbacks.
  */
-template <typename T>
+template <typename T, PoolThreading Threading>
     requires std::destructible<T>
 class ObjectPool
 {
 private:
-    struct FreeSlot
-    {
-        FreeSlot* next = nullptr; // singly-linked free list node
-    };
+    static constexpr bool kSingleThread = Threading == PoolThreading::SingleThread;
+    static constexpr bool kMutex = Threading == PoolThreading::Mutex;
+    static constexpr bool kLockFree = Threading == PoolThreading::LockFree;
+    static constexpr bool kOwnerThread = Threading == PoolThreading::OwnerThread;
 
-    size_t capacity_;               // maximum number of objects
-    std::byte* pool_memory_ = nullptr; // raw memory block
+    static constexpr ReusePolicy kReuse = kLockFree ? ReusePolicy::Lifo : PoolReusePolicy<T>::value;
+    static constexpr bool kLowestAddress = kReuse == ReusePolicy::LowestAddress;
+    static constexpr bool kFifo = kReuse == ReusePolicy::Fifo;
 
-#ifdef OxiMemPool_ErrCallback
-    ErrorCallback err_callback_ = nullptr; // optional error callback
+#ifdef OxiMemPool_ThreadCache
+    // Thread caches only make sense for pools whose free list is shared
+    // between threads, and their magazines would reorder a non-LIFO free list.
+    static constexpr bool kThreadCache = (kMutex || kLockFree) && kReuse == ReusePolicy::Lifo;
 #endif
 
-#ifdef OxiMemPool_ThreadSafe
-    mutable std::mutex mutex_; // protects free list and related state
+    // Every pop from a free list or magazine prefetches the slot the next
+    // allocation will get, so the dependent load of its free-list link does
+    // not miss; OxiMemPool_NoPrefetch turns this off.
+#ifdef OxiMemPool_NoPrefetch
+    static constexpr bool kPrefetchNext = false;
+#else
+    static constexpr bool kPrefetchNext = true;
 #endif
 
-    FreeSlot* free_head_ = nullptr;        // head of free-list
-    std::atomic<size_t> used_count_{0};    // number of live objects
-    size_t max_allocated_index_ = 0;       // number of slots ever handed out
+    // Stands in for a mutex the threading policy does not need.
+    struct NullMutex
+    {
+        void lock() noexcept {}
+        void unlock() noexcept {}
+    };
+
+    // Stands in for free-list state the reuse policy does not need.
+    struct NullState {};
 
-    LogFunction log_function_ = nullptr;   // optional logging function
+    struct LinkedSlot
+    {
+        LinkedSlot* next = nullptr; // singly-linked free list node
+    };
 
-    // Slot size and alignment calculation.
-    // Each slot must be able to store either T or FreeSlot and satisfy alignment.
-    static constexpr size_t kRawSlotSize =
-        sizeof(T) > sizeof(FreeSlot) ? sizeof(T) : sizeof(FreeSlot);
-    static constexpr size_t kSlotAlign =
-        alignof(T) > alignof(FreeSlot) ? alignof(T) : alignof(FreeSlot);
-    static constexpr size_t kSlotSize =
-        (kRawSlotSize + kSlotAlign - 1) / kSlotAlign * kSlotAlign;
+    struct IndexedSlot
+    {
+        std::uint32_t next = 0; // index + 1 of the next free slot, 0 terminates
+    };
 
-    friend class PoolHandle<T>;
+    static constexpr SlotLayout kLayout = PoolSlotLayout<T>::value;
 
-    // Allocate a raw slot without locking.
-    // Caller must hold the mutex if thread-safety is enabled.
-    // Never throws; returns nullptr if the pool is exhausted.
-    T* allocate_no_lock() noexcept
+    // Lock-free pools link free slots by index so the head fits a tagged word;
+    // dense pools do so to keep the link at 32 bits.
+    static constexpr bool kIndexedLinks = kLockFree || kLayout == SlotLayout::Dense;
+    using FreeSlot = std::conditional_t<kIndexedLinks, IndexedSlot, LinkedSlot>;
+
+    // The lock-free free-list head packs the slot index + 1 (low 32 bits) together
+    // with a modification tag (high 32 bits) so that a CAS fails on ABA reuse.
+    static constexpr std::uint64_t kIndexMask = 0xFFFFFFFFull;
+    static constexpr size_t kMaxLockFreeCapacity = 0xFFFFFFFEull;
+
+    static constexpr std::uint64_t pack_head(std::uint64_t index1, std::uint64_t tag) noexcept
+    {
+        return (tag << 32) | (index1 & kIndexMask);
+    }
+
+#ifdef OxiMemPool_Stats
+    // std::mutex that accounts for the time spent blocked in lock(). Both
+    // counters are written while the mutex is held, so relaxed loads and
+    // stores suffice. Uncontended acquisitions only pay for a try_lock().
+    struct TimedMutex
     {
-        if (free_head_)
+        std::mutex mutex;
+        std::atomic<std::uint64_t> contended{0};
+        std::atomic<std::uint64_t> wait_ns{0};
+
+        void lock()
         {
-            auto* node = free_head_;
-            free_head_ = node->next;
+            if (mutex.try_lock())
+                return;
 
-            if (log_function_)
-                log_function_("[Pool][ALLOC][REUSE] slot=" +
-                              std::to_string(reinterpret_cast<std::uintptr_t>(node)) +
-                              "\n");
+            const auto begin = std::chrono::steady_clock::now();
+            mutex.lock();
+            const auto waited = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - begin).count();
 
-            return reinterpret_cast<T*>(node);
+            contended.store(contended.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            wait_ns.store(wait_ns.load(std::memory_order_relaxed) + static_cast<std::uint64_t>(waited),
+                          std::memory_order_relaxed);
         }
 
-        if (max_allocated_index_ >= capacity_)
-        {
-            return nullptr; // pool exhausted
-        }
+        void unlock() noexcept { mutex.unlock(); }
+    };
 
-        const size_t idx = max_allocated_index_++;
-        std::byte* raw = pool_memory_ + kSlotSize * idx;
-        auto* ptr = std::launder(reinterpret_cast<T*>(raw));
+    using ListMutex = std::conditional_t<kMutex, TimedMutex, NullMutex>;
+#else
+    using ListMutex = std::conditional_t<kMutex, std::mutex, NullMutex>;
+#endif
+    using GrowthMutex = std::conditional_t<kLockFree, std::mutex, NullMutex>;
 
-        if (log_function_)
-            log_function_("[Pool][ALLOC][NEW] slot=" +
-                          std::to_string(reinterpret_cast<std::uintptr_t>(ptr)) +
-                          " index=" +
-                          std::to_string(idx) +
-                          "\n");
+    size_t capacity_;               // number of slots in the initial block
+    std::byte* pool_memory_ = nullptr; // raw memory block (initial chunk)
+    bool owns_memory_ = true;          // false for a caller-supplied buffer
 
-        return ptr;
-    }
+#ifdef OxiMemPool_ErrCallback
+    ErrorCallback err_callback_ = nullptr; // optional error callback
+#endif
 
-    // Return a slot to the free-list without locking.
-    // Caller must hold the mutex if thread-safety is enabled.
-    void free_no_lock(T* obj) noexcept
-    {
-        auto* node = reinterpret_cast<FreeSlot*>(obj);
-        node->next = free_head_;
-        free_head_ = node;
+    // Protects free list and related state (Mutex mode only).
+    [[no_unique_address]] mutable ListMutex mutex_;
 
-        if (log_function_)
-            log_function_("[Pool][FREE] slot=" +
-                          std::to_string(reinterpret_cast<std::uintptr_t>(obj)) +
-                          "\n");
-    }
+    // Tagged head (LockFree) or pointer to the first free slot.
+    std::conditional_t<kLockFree, std::atomic<std::uint64_t>, FreeSlot*> free_head_{};
+    // ReusePolicy::Fifo: last node of the free list (nullptr when empty).
+    [[no_unique_address]] std::conditional_t<kFifo, FreeSlot*, NullState> free_tail_{};
 
-    /**
-     * Destroys an object and returns its slot to the free-list.
-     * The destructor of T is executed before acquiring the pool lock
-     * (if enabled) to reduce the risk of re-entrancy issues.
-     *
-     * Requirement: T::~T() must not re-enter this pool in an unsafe manner.
-     */
-    void destroy_object(T* obj) noexcept
-    {
-        if (log_function_)
-            log_function_("[Pool][OBJ_DTOR] object=" +
-                          std::to_string(reinterpret_cast<std::uintptr_t>(obj)) +
-                          "\n");
+    // OwnerThread: slots freed by other threads (MPSC stack, pushed with a CAS
+    // and taken by the owner with one exchange) and the owning thread.
+    [[no_unique_address]] std::conditional_t<kOwnerThread, std::atomic<FreeSlot*>, NullState> remote_head_{};
+    [[no_unique_address]] std::conditional_t<kOwnerThread, std::thread::id, NullState> owner_{};
 
-        std::destroy_at(obj);
+    // Number of live objects; a plain counter for SingleThread pools.
+    std::conditional_t<kSingleThread, size_t, std::atomic<size_t>> used_count_{0};
 
-#ifdef OxiMemPool_ThreadSafe
-        std::lock_guard<std::mutex> guard(mutex_);
+    // Slots handed out by try_allocate_storage() and not given back yet. They
+    // hold no T (or a foreign object), so release_all() refuses to run.
+    std::conditional_t<kSingleThread, size_t, std::atomic<size_t>> storage_count_{0};
+
+#ifdef OxiMemPool_ShardedCount
+    // Thread-safe pools count live objects in per-thread shards instead of
+    // used_count_, so allocations and frees on different cores do not share a
+    // cache line; size() adds the shards up.
+    static constexpr bool kShardedCount = !kSingleThread;
+#else
+    static constexpr bool kShardedCount = false;
 #endif
-        free_no_lock(obj);
-        used_count_.fetch_sub(1, std::memory_order_acq_rel);
-    }
+    static constexpr size_t kCountShards = 16;
 
-    void report_error(const char* msg, size_t code)
+    struct alignas(kPoolCacheLineSize) CountShard
     {
-        if (log_function_)
-            log_function_("[Pool][ERROR] " + std::string(msg) +
-                          " code=" + std::to_string(code) +
-                          "\n");
-
-#ifdef OxiMemPool_ErrCallback
-        if (err_callback_)
-        {
-            err_callback_(msg, code);
-            return;
-        }
+        // Allocations minus frees made by the threads of this shard; wraps
+        // around when a shard frees more objects than it allocated.
+        std::atomic<size_t> delta{0};
+#ifdef OxiMemPool_Stats
+        // Highest delta so far (as a signed value); stats() adds them up.
+        std::atomic<size_t> peak{0};
 #endif
-        throw std::runtime_error(msg);
-    }
+    };
 
-    void initialize_pool_memory()
+    struct CountShards
     {
-        // Overflow check: kSlotSize * capacity_
-        if (capacity_ != 0 &&
-            kSlotSize > std::numeric_limits<size_t>::max() / capacity_)
-        {
-            report_error("ObjectPool size overflow", 2);
-        }
-
-        const size_t total_bytes = kSlotSize * capacity_;
+        CountShard shards[kCountShards];
+    };
 
-        pool_memory_ = static_cast<std::byte*>(
-            ::operator new(total_bytes, std::align_val_t{kSlotAlign}));
+    [[no_unique_address]] std::conditional_t<kShardedCount, CountShards, NullState> count_shards_{};
 
-        if (log_function_)
-            log_function_("[Pool][INIT] capacity=" +
-                        std::to_string(capacity_) +
-                        " bytes=" +
-                        std::to_string(total_bytes) +
-                        "\n");
-    }
+#ifdef OxiMemPool_AsyncEmplace
+    // OwnerThread pools only allocate on the owner, so a remote free could not
+    // hand its slot over; they do not support waiting.
+    static constexpr bool kWaiters = !kOwnerThread;
 
-public:
-    explicit ObjectPool(size_t capacity, LogFunction log = nullptr)
-        : capacity_(capacity), log_function_(log)
+    // A caller of async_emplace() / emplace_wait() waiting for a slot. Lives in
+    // the coroutine frame or on the waiting thread's stack.
+    struct Waiter
     {
-        if (capacity == 0)
-            report_error("Pool size cannot be 0", 0);
-        initialize_pool_memory();
-    }
+        Waiter* next = nullptr;                    // FIFO queue link
+        T* slot = nullptr;                         // set when the waiter is served
+        std::coroutine_handle<> coroutine{};       // async_emplace(): resumed by the freeing thread
+        std::condition_variable* signal = nullptr; // emplace_wait(): notified under wait_mutex_
+    };
 
-    ~ObjectPool() noexcept
-    {
-#ifndef NDEBUG
-        assert(used_count_.load(std::memory_order_acquire) == 0 &&
-               "ObjectPool destroyed with live objects");
+    using WaitMutex = std::conditional_t<kSingleThread, NullMutex, std::mutex>;
+
+    // Queue of waiters, oldest first, and its length for the lock-free check
+    // on every free.
+    [[no_unique_address]] mutable WaitMutex wait_mutex_;
+    Waiter* wait_head_ = nullptr;
+    Waiter* wait_tail_ = nullptr;
+    std::conditional_t<kSingleThread, size_t, std::atomic<size_t>> waiting_{0};
 #endif
-        ::operator delete(pool_memory_, std::align_val_t{kSlotAlign});
-    }
 
-    // Non-copyable, non-movable
-    ObjectPool(const ObjectPool&) = delete;
-    ObjectPool& operator=(const ObjectPool&) = delete;
-    ObjectPool(ObjectPool&&) = delete;
-    ObjectPool& operator=(ObjectPool&&) = delete;
+    // Number of slots ever handed out; may overshoot capacity_ in LockFree mode.
+    std::conditional_t<kLockFree, std::atomic<size_t>, size_t> max_allocated_index_{0};
 
-#ifdef OxiMemPool_ErrCallback
-    void set_error_callback(ErrorCallback cb) noexcept {
-        err_callback_ = cb;
-    }
+#ifndef OxiMemPool_NoLogging
+    LogFunction log_function_ = nullptr;   // optional logging function
 #endif
 
-    /**
-     * Constructs an object of type T in a free slot and returns a PoolHandle.
-     * Strong exception safety: if T's constructor throws, the slot is returned
-     * back to the free-list and the exception is propagated.
-     */
-    template <typename... Args>
-    PoolHandle<T> emplace(Args&&... args)
+#ifdef OxiMemPool_EventHook
+    EventHook event_hook_ = nullptr;       // optional structured event hook
+#endif
+
+    // Free slots of one block under ReusePolicy::LowestAddress: one bit per
+    // slot plus one summary bit per non-zero word, so the lowest free slot is
+    // found with two countr_zero scans. Accessed with the pool lock held.
+    struct FreeBitmap
     {
-        T* slot = nullptr;
+        std::unique_ptr<std::uint64_t[]> words;
+        std::unique_ptr<std::uint64_t[]> summary;
+        size_t summary_words = 0;
+        size_t hint = 0;  // no summary word below this one is non-zero
+        size_t count = 0; // free slots in the block
 
-#ifdef OxiMemPool_ThreadSafe
+        static constexpr size_t npos = static_cast<size_t>(-1);
+
+        bool allocate(size_t slots) noexcept
         {
-            std::lock_guard<std::mutex> g(mutex_);
-            slot = allocate_no_lock();
+            const size_t word_count = (slots + 63) / 64;
+            summary_words = (word_count + 63) / 64;
+            words.reset(new (std::nothrow) std::uint64_t[word_count]());
+            summary.reset(new (std::nothrow) std::uint64_t[summary_words]());
+            return words && summary;
         }
-#else
-        slot = allocate_no_lock();
+
+        void set(size_t slot) noexcept
+        {
+            const size_t w = slot / 64;
+            words[w] |= std::uint64_t{1} << (slot % 64);
+            summary[w / 64] |= std::uint64_t{1} << (w % 64);
+            if (w / 64 < hint)
+                hint = w / 64;
+            ++count;
+        }
+
+        void reset(size_t slot) noexcept
+        {
+            const size_t w = slot / 64;
+            words[w] &= ~(std::uint64_t{1} << (slot % 64));
+            if (words[w] == 0)
+                summary[w / 64] &= ~(std::uint64_t{1} << (w % 64));
+            --count;
+        }
+
+        // Lowest free slot, npos if none.
+        size_t lowest() noexcept
+        {
+            if (count == 0)
+                return npos;
+            while (summary[hint] == 0)
+                ++hint;
+            const size_t w = hint * 64 + static_cast<size_t>(std::countr_zero(summary[hint]));
+            return w * 64 + static_cast<size_t>(std::countr_zero(words[w]));
+        }
+
+        template <typename Fn>
+        void for_each(Fn&& fn) const
+        {
+            for (size_t s = 0; s < summary_words; ++s)
+            {
+                for (std::uint64_t sum = summary[s]; sum != 0; sum &= sum - 1)
+                {
+                    const size_t w = s * 64 + static_cast<size_t>(std::countr_zero(sum));
+                    for (std::uint64_t bits = words[w]; bits != 0; bits &= bits - 1)
+                        fn(w * 64 + static_cast<size_t>(std::countr_zero(bits)));
+                }
+            }
+        }
+
+        void clear() noexcept
+        {
+            if (count == 0)
+                return;
+            for (size_t s = 0; s < summary_words; ++s)
+            {
+                for (std::uint64_t sum = summary[s]; sum != 0; sum &= sum - 1)
+                    words[s * 64 + static_cast<size_t>(std::countr_zero(sum))] = 0;
+                summary[s] = 0;
+            }
+            hint = 0;
+            count = 0;
+        }
+    };
+
+#ifdef OxiMemPool_Profile
+    // Call site and allocation time of a sampled live object; `site` is
+    // nullptr while the slot holds no sampled object. Written only by the
+    // threads creating and destroying the object, read by live_allocation_sites().
+    struct AllocationSample
+    {
+        std::atomic<const void*> site{nullptr};
+        std::atomic<std::uint64_t> time_ns{0};
+    };
+#endif
+
+    // Additional chunks of a growable pool. The directory is sized once at
+    // construction so entries never move; readers only look at entries below
+    // chunk_count_, and an entry's index range never changes while it is in use.
+    struct Chunk
+    {
+        std::atomic<std::byte*> memory{nullptr}; // nullptr once released by shrink_to_fit()
+        size_t first_index = 0;                  // global index of the first slot
+        size_t slots = 0;                        // number of slots in this chunk
+#ifdef OxiMemPool_WeakRefs
+        // Kept across shrink_to_fit() so stale weak references stay stale.
+        std::unique_ptr<std::atomic<std::uint32_t>[]> generations;
+#endif
+#ifdef OxiMemPool_Occupancy
+        std::unique_ptr<std::atomic<std::uint64_t>[]> occupancy; // one bit per slot, set while live
+#endif
+#ifdef OxiMemPool_SharedHandles
+        std::unique_ptr<std::atomic<std::uint32_t>[]> refcounts; // PoolSharedHandle counts per slot
+#endif
+#ifdef OxiMemPool_Profile
+        std::unique_ptr<AllocationSample[]> samples;             // allocation samples per slot
+#endif
+        // ReusePolicy::LowestAddress: free slots of this chunk.
+        [[no_unique_address]] std::conditional_t<kLowestAddress, FreeBitmap, NullState> free_bits;
+    };
+
+    // ReusePolicy::LowestAddress: free slots of the initial block, and the
+    // lowest block (0 = initial, i + 1 = chunk i) that may hold free slots.
+    [[no_unique_address]] std::conditional_t<kLowestAddress, FreeBitmap, NullState> free_bits_;
+    [[no_unique_address]] std::conditional_t<kLowestAddress, size_t, NullState> free_block_hint_{};
+
+#ifdef OxiMemPool_WeakRefs
+    std::unique_ptr<std::atomic<std::uint32_t>[]> generations_; // per-slot generation, initial block
+#endif
+#ifdef OxiMemPool_Occupancy
+    std::unique_ptr<std::atomic<std::uint64_t>[]> occupancy_;   // occupancy bitmap, initial block
+#endif
+#ifdef OxiMemPool_SharedHandles
+    std::unique_ptr<std::atomic<std::uint32_t>[]> refcounts_;   // shared-handle counts, initial block
+#endif
+#ifdef OxiMemPool_Profile
+    std::unique_ptr<AllocationSample[]> samples_;               // allocation samples, initial block
+    std::atomic<size_t> profile_interval_{OxiMemPool_ProfileInterval}; // mean allocations per sample, 0 = off
+#endif
+
+    GrowthPolicy growth_{};
+#ifdef OxiMemPool_BackingMemory
+    BackingPolicy backing_{};                  // source of slot memory
+#endif
+    size_t max_capacity_ = 0;                  // hard cap on slot indices
+    std::unique_ptr<Chunk[]> chunks_;          // chunk directory (growable pools only)
+    size_t max_chunks_ = 0;                    // directory size
+    std::atomic<size_t> chunk_count_{0};       // directory entries in use
+    std::atomic<size_t> index_end_{0};         // end of the slot index space (bump limit)
+    std::atomic<size_t> committed_slots_{0};   // slots currently backed by memory
+
+    // Serializes growth and shrink_to_fit() in LockFree mode; never taken on the fast path.
+    [[no_unique_address]] GrowthMutex growth_mutex_;
+
+#ifdef OxiMemPool_Stats
+    enum StatCounter : size_t { kFresh, kReused, kFrees, kExhausted, kGrows, kShrinks, kStatCount };
+
+    // Event counters are sharded by thread so that counting never makes
+    // threads fight over one cache line; stats() sums the shards.
+    static constexpr size_t kStatShards = kSingleThread ? 1 : 16;
+
+    struct alignas(64) StatShard
+    {
+        std::atomic<std::uint64_t> counters[kStatCount] = {};
+    };
+
+    mutable StatShard stat_shards_[kStatShards];
+    std::conditional_t<kSingleThread, size_t, std::atomic<size_t>> peak_live_{0};
+#endif
+
+#ifdef OxiMemPool_ThreadCache
+public:
+    // Upper bound for set_magazine_size(); magazines are fixed arrays of this size.
+    static constexpr size_t kMaxMagazineSize = 64;
+    static constexpr size_t kDefaultMagazineSize = 32;
+
+private:
+    // Shared between the pool and every thread that cached slots from it.
+    // Outlives the pool so an exiting thread can tell whether it may flush.
+    struct Magazine
+    {
+        size_t count = 0;
+        T* slots[kMaxMagazineSize];
+    };
+
+    struct CacheAnchor
+    {
+        std::mutex mutex;                  // serializes thread-exit flush vs. pool destruction
+        ObjectPool* pool = nullptr;        // nullptr once the pool is destroyed
+        std::vector<Magazine*> magazines;  // magazines of all threads, for release_all()
+    };
+
+    struct ThreadCache
+    {
+        struct Entry
+        {
+            std::shared_ptr<CacheAnchor> anchor;
+            std::unique_ptr<Magazine> magazine; // stable address, registered in the anchor
+        };
+
+        std::vector<Entry> entries;
+
+        ~ThreadCache()
+        {
+            for (auto& entry : entries)
+            {
+#ifdef OxiMemPool_AsyncEmplace
+                ObjectPool* waited_on = nullptr;
+#endif
+                {
+                    std::lock_guard<std::mutex> g(entry.anchor->mutex);
+                    ObjectPool* pool = entry.anchor->pool;
+                    if (!pool)
+                        continue;
+
+                    pool->return_magazine_slots(*entry.magazine, entry.magazine->count);
+                    std::erase(entry.anchor->magazines, entry.magazine.get());
+#ifdef OxiMemPool_AsyncEmplace
+                    // A pool must outlive its waiters, so one that has any
+                    // can still be notified once the anchor is released.
+                    if (pool->waiters_pending())
+                        waited_on = pool;
+#endif
+                }
+#ifdef OxiMemPool_AsyncEmplace
+                if (waited_on)
+                    waited_on->notify_waiters();
+#endif
+            }
+        }
+    };
+
+    // Function-local rather than an inline static member: GCC 12 emits
+    // clashing TLS guards for the member when several specializations are
+    // instantiated from virtual functions (e.g. PoolMemoryResource).
+    static ThreadCache& tls_cache() noexcept
+    {
+        static thread_local ThreadCache cache;
+        return cache;
+    }
+
+    std::shared_ptr<CacheAnchor> cache_anchor_;                      // identity of this pool in thread caches
+    std::atomic<size_t> magazine_size_{kDefaultMagazineSize};        // per-thread cached slots, 0 disables
+#endif
+
+    // Slot size and alignment calculation.
+    // Each slot must be able to store either T or FreeSlot and satisfy alignment.
+    // Hardened pools append an aligned guard word after it.
+#ifdef OxiMemPool_Hardened
+    static constexpr size_t kGuardSize = sizeof(std::uint64_t);
+#else
+    static constexpr size_t kGuardSize = 0;
+#endif
+    static constexpr size_t kGuardAlign = kGuardSize ? alignof(std::uint64_t) : 1;
+    static constexpr size_t kObjectBytes =
+        sizeof(T) > sizeof(FreeSlot) ? sizeof(T) : sizeof(FreeSlot);
+    static constexpr size_t kGuardOffset = (kObjectBytes + kGuardAlign - 1) / kGuardAlign * kGuardAlign;
+    static constexpr size_t kRawSlotSize = kGuardOffset + kGuardSize;
+    static constexpr size_t kLinkAlign = alignof(FreeSlot) > kGuardAlign ? alignof(FreeSlot) : kGuardAlign;
+    static constexpr size_t kNaturalSlotAlign =
+        alignof(T) > kLinkAlign ? alignof(T) : kLinkAlign;
+    static constexpr size_t kSlotAlign =
+        kLayout == SlotLayout::CacheLine && kNaturalSlotAlign < kPoolCacheLineSize
+            ? kPoolCacheLineSize : kNaturalSlotAlign;
+    static constexpr size_t kSlotSize =
+        (kRawSlotSize + kSlotAlign - 1) / kSlotAlign * kSlotAlign;
+
+    friend class PoolHandle<T, Threading>;
+    template <auto& Pool> friend class CompactPoolHandle;
+    template <auto& Pool> friend class PoolIndexHandle;
+    template <typename U, PoolThreading> friend class SlabHandle;
+    template <typename, size_t, size_t, PoolThreading> friend class PolymorphicPool;
+    friend class MappedObjectPool<T, Threading>;
+#ifdef OxiMemPool_WeakRefs
+    friend class PoolWeakRef<T, Threading>;
+#endif
+#ifdef OxiMemPool_SharedHandles
+    friend class PoolSharedHandle<T, Threading>;
+#endif
+
+public:
+    using value_type = T;
+    using handle_type = PoolHandle<T, Threading>;
+    static constexpr PoolThreading threading = Threading;
+    static constexpr size_t slot_size = kSlotSize;   // bytes per slot
+    static constexpr size_t slot_align = kSlotAlign; // alignment of every slot
+
+    /**
+     * True if the slots of a buffer-backed pool form a position-independent
+     * image (image_state(), ObjectPool(buffer, state)): T is trivially
+     * copyable, and the free list is linked by 32-bit slot indices (LockFree
+     * pools or SlotLayout::Dense) in LIFO order. Hardened pools tie their
+     * guard words to slot addresses and do not qualify.
+     */
+#ifdef OxiMemPool_Hardened
+    static constexpr bool supports_image = false;
+#else
+    static constexpr bool supports_image = std::is_trivially_copyable_v<T> && kIndexedLinks &&
+                                           kReuse == ReusePolicy::Lifo;
+#endif
+
+private:
+
+    // Reports an event to the hook and a message to the log function. The
+    // message is only built when a log function is set; with OxiMemPool_NoLogging
+    // and without OxiMemPool_EventHook this compiles to nothing.
+    template <typename Message>
+    void trace(PoolEvent event, const void* slot, size_t index, Message&& message) const
+    {
+#ifdef OxiMemPool_Stats
+        count_event(event, index);
+#endif
+#ifdef OxiMemPool_EventHook
+        if (event_hook_)
+            event_hook_(event, slot, index);
+#else
+        (void)event; (void)slot; (void)index;
+#endif
+#ifndef OxiMemPool_NoLogging
+        if (log_function_)
+            log_function_(message());
+#else
+        (void)message;
+#endif
+    }
+
+    // Same as trace(), deriving the index from the slot only if a hook is set.
+    template <typename Message>
+    void trace_slot(PoolEvent event, const void* slot, Message&& message) const
+    {
+#ifdef OxiMemPool_Stats
+        count_event(event, 1);
+#endif
+#ifdef OxiMemPool_EventHook
+        if (event_hook_)
+            event_hook_(event, slot, slot_index(slot));
+#else
+        (void)event; (void)slot;
+#endif
+#ifndef OxiMemPool_NoLogging
+        if (log_function_)
+            log_function_(message());
+#else
+        (void)message;
+#endif
+    }
+
+    // Number of the calling thread for picking counter shards; threads are
+    // numbered round-robin.
+    static size_t thread_shard() noexcept
+    {
+        static std::atomic<size_t> next_shard{0};
+        thread_local const size_t shard = next_shard.fetch_add(1, std::memory_order_relaxed);
+        return shard;
+    }
+
+#ifdef OxiMemPool_Stats
+    // Shard of the calling thread.
+    static size_t stat_shard() noexcept
+    {
+        if constexpr (kStatShards == 1)
+            return 0;
+        return thread_shard() % kStatShards;
+    }
+
+    void bump_stat(StatCounter counter, std::uint64_t amount) const noexcept
+    {
+        auto& value = stat_shards_[stat_shard()].counters[counter];
+        if constexpr (kSingleThread)
+            value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+        else
+            value.fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    // Maps a traced event to its counter; `index` is the event's index argument.
+    void count_event(PoolEvent event, size_t index) const noexcept
+    {
+        switch (event)
+        {
+        case PoolEvent::AllocNew:   bump_stat(kFresh, 1); break;
+        case PoolEvent::AllocBulk:  bump_stat(kFresh, index); break;
+        case PoolEvent::AllocReuse: bump_stat(kReused, 1); break;
+        case PoolEvent::Free:       bump_stat(kFrees, 1); break;
+        case PoolEvent::FreeBatch:  bump_stat(kFrees, index); break;
+        case PoolEvent::Grow:       bump_stat(kGrows, 1); break;
+        case PoolEvent::Shrink:     bump_stat(kShrinks, 1); break;
+        case PoolEvent::Error:
+            if (index == 1)
+                bump_stat(kExhausted, 1);
+            break;
+        default: break;
+        }
+    }
+
+    void update_peak(size_t live) noexcept
+    {
+        if constexpr (kSingleThread)
+        {
+            if (live > peak_live_)
+                peak_live_ = live;
+        }
+        else
+        {
+            size_t peak = peak_live_.load(std::memory_order_relaxed);
+            while (live > peak &&
+                   !peak_live_.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+        }
+    }
+#endif
+
+    // Directory entry holding global slot index `idx` (idx >= capacity_).
+    size_t chunk_of_index(size_t idx) const noexcept
+    {
+        size_t lo = 0;
+        size_t hi = chunk_count_.load(std::memory_order_acquire);
+        while (hi - lo > 1)
+        {
+            const size_t mid = lo + (hi - lo) / 2;
+            if (chunks_[mid].first_index <= idx)
+                lo = mid;
+            else
+                hi = mid;
+        }
+        return lo;
+    }
+
+    // Address of the slot with global index `idx`.
+    std::byte* slot_address(size_t idx) const noexcept
+    {
+        if (idx < capacity_)
+            return pool_memory_ + kSlotSize * idx;
+
+        const Chunk& chunk = chunks_[chunk_of_index(idx)];
+        return chunk.memory.load(std::memory_order_relaxed) + kSlotSize * (idx - chunk.first_index);
+    }
+
+    FreeSlot* slot_at(size_t idx) const noexcept
+    {
+        return std::launder(reinterpret_cast<FreeSlot*>(slot_address(idx)));
+    }
+
+    // Global index of the slot at `p`. Linear in the number of chunks for slots
+    // outside the initial block.
+    size_t slot_index(const void* p) const noexcept
+    {
+        const auto addr = reinterpret_cast<std::uintptr_t>(p);
+        const auto base = reinterpret_cast<std::uintptr_t>(pool_memory_);
+        if (addr - base < kSlotSize * capacity_)
+            return static_cast<size_t>(addr - base) / kSlotSize;
+
+        const size_t count = chunk_count_.load(std::memory_order_acquire);
+        for (size_t i = 0; i < count; ++i)
+        {
+            const Chunk& chunk = chunks_[i];
+            const auto chunk_base = reinterpret_cast<std::uintptr_t>(
+                chunk.memory.load(std::memory_order_relaxed));
+            if (chunk_base != 0 && addr - chunk_base < kSlotSize * chunk.slots)
+                return chunk.first_index + static_cast<size_t>(addr - chunk_base) / kSlotSize;
+        }
+
+        assert(false && "pointer does not belong to this ObjectPool");
+        return 0;
+    }
+
+#ifdef OxiMemPool_Occupancy
+    static constexpr size_t occupancy_words(size_t slots) noexcept
+    {
+        return (slots + 63) / 64;
+    }
+
+    // Occupancy bitmap of the block holding global index `idx` and the first
+    // global index of that block.
+    std::atomic<std::uint64_t>* occupancy_block(size_t idx, size_t& first) const noexcept
+    {
+        if (idx < capacity_)
+        {
+            first = 0;
+            return occupancy_.get();
+        }
+        const Chunk& chunk = chunks_[chunk_of_index(idx)];
+        first = chunk.first_index;
+        return chunk.occupancy.get();
+    }
+
+    // Marks the slot of a constructed object live, or free just before its
+    // destruction. Objects sharing a bitmap word may be created and destroyed
+    // concurrently, so thread-safe pools update the word with an atomic RMW.
+    void set_occupied(const T* obj, bool live) noexcept
+    {
+        size_t first = 0;
+        const size_t idx = slot_index(obj);
+        std::atomic<std::uint64_t>& word = occupancy_block(idx, first)[(idx - first) / 64];
+        const std::uint64_t bit = std::uint64_t{1} << ((idx - first) % 64);
+
+        if constexpr (kSingleThread)
+        {
+            const std::uint64_t w = word.load(std::memory_order_relaxed);
+            word.store(live ? (w | bit) : (w & ~bit), std::memory_order_relaxed);
+        }
+        else if (live)
+            word.fetch_or(bit, std::memory_order_release);
+        else
+            word.fetch_and(~bit, std::memory_order_relaxed);
+    }
+
+#ifdef OxiMemPool_Hardened
+    bool occupied(const T* obj) const noexcept
+    {
+        size_t first = 0;
+        const size_t idx = slot_index(obj);
+        const std::atomic<std::uint64_t>& word = occupancy_block(idx, first)[(idx - first) / 64];
+        return (word.load(std::memory_order_acquire) >> ((idx - first) % 64)) & 1;
+    }
+
+    // Bytes of a free slot past its free-list link; overwritten with
+    // kPoisonByte (and poisoned for ASan) while the slot is free.
+    static constexpr size_t kPoisonOffset = sizeof(FreeSlot);
+    static constexpr unsigned char kPoisonByte = 0xDD;
+
+    // Expected guard word of `slot`: tied to the slot and the pool, so a guard
+    // copied from another slot does not pass.
+    std::uint64_t guard_of(const void* slot) const noexcept
+    {
+        return static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(slot) ^
+                                          reinterpret_cast<std::uintptr_t>(this)) ^
+               0xA5C3'96E1'5B0F'D247ull;
+    }
+
+    // Reports detected corruption and aborts: the free list or neighbouring
+    // objects can no longer be trusted, so the pool cannot go on.
+    [[noreturn]] void hardening_failure(const char* msg, size_t code, const void* slot) const noexcept
+    {
+        trace(PoolEvent::Error, slot, code, [&] {
+            return "[Pool][HARDENING] " + std::string(msg) + " slot=" +
+                   std::to_string(reinterpret_cast<std::uintptr_t>(slot)) + "\n";
+        });
+#ifdef OxiMemPool_ErrCallback
+        if (err_callback_)
+            err_callback_(msg, code);
+#endif
+        std::abort();
+    }
+
+    // A slot is handed out for an object or raw storage: it must not hold a
+    // live object. Arms its guard word (ASan builds poison it instead).
+    void acquire_checked(T* slot) noexcept
+    {
+        if (occupied(slot))
+            hardening_failure("ObjectPool free list handed out a live slot", 6, slot);
+
+        auto* bytes = reinterpret_cast<std::byte*>(slot);
+#ifdef OxiMemPool_AsanPoisoning
+        ASAN_UNPOISON_MEMORY_REGION(bytes, kGuardOffset);
+        ASAN_POISON_MEMORY_REGION(bytes + kGuardOffset, kSlotSize - kGuardOffset);
+#else
+        const std::uint64_t guard = guard_of(slot);
+        std::memcpy(bytes + kGuardOffset, &guard, sizeof(guard));
+#endif
+    }
+
+    // An object is about to be destroyed: it must be live, and its guard word
+    // intact (no overflow from this object or underflow from the next one).
+    void release_checked(const T* obj) const noexcept
+    {
+        if (!is_slot(obj) || !occupied(obj))
+            hardening_failure("ObjectPool double free or foreign object", 7, obj);
+#ifndef OxiMemPool_AsanPoisoning
+        std::uint64_t guard = 0;
+        std::memcpy(&guard, reinterpret_cast<const std::byte*>(obj) + kGuardOffset, sizeof(guard));
+        if (guard != guard_of(obj))
+            hardening_failure("ObjectPool slot guard word overwritten", 8, obj);
+#endif
+    }
+
+    // The object in `slot` was destroyed: poison the slot past its link.
+    static void poison_slot(T* slot) noexcept
+    {
+        auto* bytes = reinterpret_cast<std::byte*>(slot);
+        std::memset(bytes + kPoisonOffset, kPoisonByte, kGuardOffset - kPoisonOffset);
+#ifdef OxiMemPool_AsanPoisoning
+        ASAN_POISON_MEMORY_REGION(bytes + kPoisonOffset, kGuardOffset - kPoisonOffset);
+#endif
+    }
+
+    // True if `p` is the start of a slot of this pool.
+    bool is_slot(const void* p) const noexcept
+    {
+        return owns(p) && slot_address(slot_index(p)) == static_cast<const std::byte*>(p);
+    }
+
+    // Rejects a free-list link that does not point at a slot of this pool
+    // (typically a write through a dangling pointer to a freed object).
+    void check_link(const FreeSlot* node, const FreeSlot* next) const noexcept
+    {
+        if (next && !is_slot(next))
+            hardening_failure("ObjectPool free list corrupted", 6, node);
+    }
+
+    void check_link_index(const FreeSlot* node, std::uint32_t next1) const noexcept
+    {
+        if (next1 > index_end_.load(std::memory_order_relaxed))
+            hardening_failure("ObjectPool free list corrupted", 6, node);
+    }
+#endif
+
+    // Calls fn(T*) for every live object with a global index in [first, last),
+    // in address order. Scans the bitmap a word at a time: free words cost one
+    // load, and the set bits of a word are visited with countr_zero, so every
+    // object is reached without touching the memory of free slots.
+    template <typename Fn>
+    void for_each_live_in(size_t first, size_t last, Fn& fn) const
+    {
+        while (first < last)
+        {
+            const size_t block_last = block_end(first) < last ? block_end(first) : last;
+            size_t base = 0;
+            const std::atomic<std::uint64_t>* bits = occupancy_block(first, base);
+            const std::byte* memory = first < capacity_
+                ? pool_memory_
+                : chunks_[chunk_of_index(first)].memory.load(std::memory_order_acquire);
+
+            if (memory) // a chunk released by shrink_to_fit() holds no objects
+            {
+                const size_t end = block_last - base;
+                for (size_t local = first - base; local < end; local = (local / 64 + 1) * 64)
+                {
+                    const size_t word_index = local / 64;
+                    std::uint64_t w = bits[word_index].load(std::memory_order_acquire);
+                    w &= ~std::uint64_t{0} << (local % 64);
+                    if (end - word_index * 64 < 64)
+                        w &= (std::uint64_t{1} << (end - word_index * 64)) - 1;
+
+                    while (w != 0)
+                    {
+                        const size_t slot = word_index * 64 + static_cast<size_t>(std::countr_zero(w));
+                        w &= w - 1;
+                        fn(std::launder(reinterpret_cast<T*>(
+                            const_cast<std::byte*>(memory) + kSlotSize * slot)));
+                    }
+                }
+            }
+            first = block_last;
+        }
+    }
+
+    // Clears every occupancy bit below global index `last`. Caller holds all locks.
+    void clear_occupancy_no_lock(size_t last) noexcept
+    {
+        for (size_t idx = 0; idx < last;)
+        {
+            const size_t block_last = block_end(idx) < last ? block_end(idx) : last;
+            size_t base = 0;
+            std::atomic<std::uint64_t>* bits = occupancy_block(idx, base);
+            for (size_t w = 0; w < occupancy_words(block_last - base); ++w)
+                bits[w].store(0, std::memory_order_relaxed);
+            idx = block_last;
+        }
+    }
+#endif
+
+#ifdef OxiMemPool_WeakRefs
+    // Generation counter of the slot with global index `idx`.
+    std::atomic<std::uint32_t>& generation(size_t idx) const noexcept
+    {
+        if (idx < capacity_)
+            return generations_[idx];
+
+        const Chunk& chunk = chunks_[chunk_of_index(idx)];
+        return chunk.generations[idx - chunk.first_index];
+    }
+
+    // Invalidates weak references to a slot whose object was just destroyed.
+    // Only the thread that destroys the object writes its counter.
+    void bump_generation(const T* obj) noexcept
+    {
+        auto& gen = generation(slot_index(obj));
+        gen.store(gen.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+#endif
+
+#ifdef OxiMemPool_SharedHandles
+    // Shared-handle reference count of the slot with global index `idx`.
+    std::atomic<std::uint32_t>& refcount(size_t idx) const noexcept
+    {
+        if (idx < capacity_)
+            return refcounts_[idx];
+
+        const Chunk& chunk = chunks_[chunk_of_index(idx)];
+        return chunk.refcounts[idx - chunk.first_index];
+    }
+#endif
+
+#ifdef OxiMemPool_Profile
+    // Allocation sample of the slot with global index `idx`.
+    AllocationSample& sample_at(size_t idx) const noexcept
+    {
+        if (idx < capacity_)
+            return samples_[idx];
+
+        const Chunk& chunk = chunks_[chunk_of_index(idx)];
+        return chunk.samples[idx - chunk.first_index];
+    }
+
+    static std::uint64_t profile_now_ns() noexcept
+    {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    // Allocations the calling thread makes before its next sample (0 until
+    // its first allocation). Shared by all pools of this type, like the
+    // per-thread sampling counter of tcmalloc.
+    static size_t& sample_countdown() noexcept
+    {
+        static thread_local size_t countdown = 0;
+        return countdown;
+    }
+
+    // Distance to the next sample, uniform in [1, 2 * interval - 1]: the mean
+    // is `interval`, and allocation patterns with a fixed period cannot
+    // alias with the sampling.
+    static size_t next_sample_gap(size_t interval) noexcept
+    {
+        static thread_local std::uint64_t state = 0x9E3779B97F4A7C15ull * (thread_shard() + 1);
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return 1 + static_cast<size_t>(state % (2 * interval - 1));
+    }
+
+    // Counts an allocation of the calling thread and samples `obj` when its
+    // countdown expires. Inlined up to the public entry point, so that
+    // record_sample() is called from the application's code.
+    OxiMemPool_ProfileInline void maybe_sample(T* obj) noexcept
+    {
+        const size_t interval = profile_interval_.load(std::memory_order_relaxed);
+        if (interval == 0)
+            return;
+        size_t& countdown = sample_countdown();
+        if (countdown == 0)
+            countdown = next_sample_gap(interval);
+        if (--countdown == 0)
+            record_sample(obj, interval);
+    }
+
+    // Out of line: its return address is the call site of emplace().
+    OxiMemPool_ProfileNoInline void record_sample(T* obj, size_t interval) noexcept
+    {
+        sample_countdown() = next_sample_gap(interval);
+        AllocationSample& sample = sample_at(slot_index(obj));
+        sample.time_ns.store(profile_now_ns(), std::memory_order_relaxed);
+        sample.site.store(OxiMemPool_ReturnAddress(), std::memory_order_release);
+    }
+
+    // Forgets the sample of an object that is being destroyed. Unsampled
+    // slots (nearly all) are only read.
+    void clear_sample(const T* obj) noexcept
+    {
+        AllocationSample& sample = sample_at(slot_index(obj));
+        if (sample.site.load(std::memory_order_relaxed) != nullptr)
+            sample.site.store(nullptr, std::memory_order_relaxed);
+    }
+
+    // compact(): the sample follows the object.
+    void move_sample(const T* from, const T* to) noexcept
+    {
+        AllocationSample& source = sample_at(slot_index(from));
+        const void* site = source.site.load(std::memory_order_relaxed);
+        if (site == nullptr)
+            return;
+        AllocationSample& target = sample_at(slot_index(to));
+        target.time_ns.store(source.time_ns.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        target.site.store(site, std::memory_order_release);
+        source.site.store(nullptr, std::memory_order_relaxed);
+    }
+
+    // Clears every sample below global index `last`. Caller holds all locks.
+    void clear_samples_no_lock(size_t last) noexcept
+    {
+        for (size_t idx = 0; idx < last;)
+        {
+            const size_t block_last = block_end(idx) < last ? block_end(idx) : last;
+            AllocationSample* samples = &sample_at(idx);
+            for (size_t i = 0; i < block_last - idx; ++i)
+                samples[i].site.store(nullptr, std::memory_order_relaxed);
+            idx = block_last;
+        }
+    }
+#endif
+
+    // Slot memory for `slots` slots (initial block or chunk); nullptr on failure.
+    std::byte* allocate_block(size_t slots) noexcept
+    {
+#ifdef OxiMemPool_BackingMemory
+        return static_cast<std::byte*>(BackingMemory::allocate(backing_, kSlotSize * slots, kSlotAlign));
+#else
+        return static_cast<std::byte*>(::operator new(
+            kSlotSize * slots, std::align_val_t{kSlotAlign}, std::nothrow));
+#endif
+    }
+
+    void release_block(std::byte* memory, size_t slots) noexcept
+    {
+#ifdef OxiMemPool_AsanPoisoning
+        ASAN_UNPOISON_MEMORY_REGION(memory, kSlotSize * slots);
+#endif
+#ifdef OxiMemPool_BackingMemory
+        BackingMemory::release(backing_, memory, kSlotSize * slots, kSlotAlign);
+#else
+        (void)slots;
+        ::operator delete(memory, std::align_val_t{kSlotAlign});
+#endif
+    }
+
+    // Writes one byte per page of [memory, memory + bytes) so that the OS
+    // backs the range before the first object is constructed in it.
+    static void touch_memory(std::byte* memory, size_t bytes) noexcept
+    {
+        constexpr size_t kTouchStride = 4096; // smallest common page size
+        if (bytes == 0)
+            return;
+
+#ifdef OxiMemPool_AsanPoisoning
+        ASAN_UNPOISON_MEMORY_REGION(memory, bytes); // untouched slots hold no object
+#endif
+        auto* p = reinterpret_cast<volatile unsigned char*>(memory);
+        for (size_t offset = 0; offset < bytes; offset += kTouchStride)
+            p[offset] = 0;
+        p[bytes - 1] = 0;
+    }
+
+    // One past the last global index of the block (initial or chunk) holding `idx`.
+    size_t block_end(size_t idx) const noexcept
+    {
+        if (idx < capacity_)
+            return capacity_;
+        const Chunk& chunk = chunks_[chunk_of_index(idx)];
+        return chunk.first_index + chunk.slots;
+    }
+
+    // First global index of the block holding `idx`.
+    size_t block_begin(size_t idx) const noexcept
+    {
+        return idx < capacity_ ? 0 : chunks_[chunk_of_index(idx)].first_index;
+    }
+
+    // One past the highest global index that ever held an object.
+    size_t touched_end() const noexcept
+    {
+        size_t bump = 0;
+        if constexpr (kLockFree)
+            bump = max_allocated_index_.load(std::memory_order_acquire);
+        else if constexpr (kMutex)
+        {
+            std::lock_guard<ListMutex> g(mutex_);
+            bump = max_allocated_index_;
+        }
+        else
+            bump = max_allocated_index_;
+
+        const size_t end = index_end_.load(std::memory_order_acquire);
+        return bump < end ? bump : end; // the lock-free bump index may overshoot
+    }
+
+    // Size of the chunk that follows a chunk of `previous` slots, clamped so
+    // that the index space never exceeds max_capacity_. Returns 0 at the cap.
+    size_t next_chunk_slots(size_t previous, size_t index_end) const noexcept
+    {
+        if (index_end >= max_capacity_)
+            return 0;
+
+        const size_t room = max_capacity_ - index_end;
+        size_t slots = 0;
+        if (growth_.mode == GrowthPolicy::Mode::FixedStep)
+            slots = growth_.step;
+        else if (growth_.mode == GrowthPolicy::Mode::Geometric)
+            slots = previous > room / growth_.factor ? room : previous * growth_.factor;
+
+        return slots < room ? slots : room;
+    }
+
+    // Push every slot of [memory, memory + slots) onto the free list so that
+    // they are handed out in address order. Caller must hold the mutex if
+    // thread-safety is enabled.
+    void push_chunk_no_lock(std::byte* memory, size_t first_index, size_t slots) noexcept
+    {
+        if constexpr (kLockFree)
+        {
+            for (size_t i = 0; i + 1 < slots; ++i)
+            {
+                auto* node = reinterpret_cast<FreeSlot*>(memory + kSlotSize * i);
+                std::atomic_ref<std::uint32_t>(node->next)
+                    .store(static_cast<std::uint32_t>(first_index + i + 2), std::memory_order_relaxed);
+            }
+
+            auto* tail = reinterpret_cast<FreeSlot*>(memory + kSlotSize * (slots - 1));
+            std::uint64_t head = free_head_.load(std::memory_order_relaxed);
+            do
+            {
+                std::atomic_ref<std::uint32_t>(tail->next)
+                    .store(static_cast<std::uint32_t>(head & kIndexMask), std::memory_order_relaxed);
+            } while (!free_head_.compare_exchange_weak(head, pack_head(first_index + 1, (head >> 32) + 1),
+                                                       std::memory_order_release,
+                                                       std::memory_order_relaxed));
+        }
+        else if constexpr (kLowestAddress)
+        {
+            (void)memory;
+            for (size_t i = 0; i < slots; ++i)
+                mark_free_no_lock(first_index + i);
+        }
+        else if constexpr (kFifo)
+        {
+            (void)first_index;
+            if (slots == 0)
+                return;
+            for (size_t i = 0; i + 1 < slots; ++i)
+                set_next(reinterpret_cast<FreeSlot*>(memory + kSlotSize * i),
+                         reinterpret_cast<FreeSlot*>(memory + kSlotSize * (i + 1)));
+            splice_no_lock(reinterpret_cast<FreeSlot*>(memory),
+                           reinterpret_cast<FreeSlot*>(memory + kSlotSize * (slots - 1)));
+        }
+        else
+        {
+            (void)first_index;
+            for (size_t i = slots; i-- > 0;)
+            {
+                auto* node = reinterpret_cast<FreeSlot*>(memory + kSlotSize * i);
+                set_next(node, free_head_);
+                free_head_ = node;
+            }
+        }
+    }
+
+    // ReusePolicy::LowestAddress: block number of global index `idx`
+    // (0 = initial block, i + 1 = chunk i) and the bitmap of a block.
+    size_t block_number(size_t idx) const noexcept
+    {
+        return idx < capacity_ ? 0 : chunk_of_index(idx) + 1;
+    }
+
+    FreeBitmap& block_bits(size_t block) noexcept
+    {
+        return block == 0 ? free_bits_ : chunks_[block - 1].free_bits;
+    }
+
+    size_t block_first(size_t block) const noexcept
+    {
+        return block == 0 ? 0 : chunks_[block - 1].first_index;
+    }
+
+    // ReusePolicy::LowestAddress: adds the slot with global index `idx` to the free set.
+    void mark_free_no_lock(size_t idx) noexcept
+    {
+        const size_t block = block_number(idx);
+        block_bits(block).set(idx - block_first(block));
+        if (block < free_block_hint_)
+            free_block_hint_ = block;
+    }
+
+    // Takes the next slot from the shared free list according to the reuse
+    // policy; nullptr if it is empty. SingleThread and Mutex pools only.
+    FreeSlot* pop_free_no_lock() noexcept
+    {
+        if constexpr (kLowestAddress)
+        {
+            const size_t blocks = chunk_count_.load(std::memory_order_relaxed) + 1;
+            for (; free_block_hint_ < blocks; ++free_block_hint_)
+            {
+                FreeBitmap& bits = block_bits(free_block_hint_);
+                const size_t local = bits.lowest();
+                if (local == FreeBitmap::npos)
+                    continue;
+                bits.reset(local);
+                return slot_at(block_first(free_block_hint_) + local);
+            }
+            return nullptr;
+        }
+        else
+        {
+            FreeSlot* node = free_head_;
+            if (node)
+            {
+#ifdef OxiMemPool_Hardened
+                if constexpr (kIndexedLinks)
+                    check_link_index(node, node->next);
+                else
+                    check_link(node, node->next);
+#endif
+                free_head_ = get_next(node);
+                if constexpr (kFifo)
+                {
+                    if (!free_head_)
+                        free_tail_ = nullptr;
+                }
+                if constexpr (kPrefetchNext)
+                    pool_prefetch(free_head_);
+            }
+            return node;
+        }
+    }
+
+    // Empties the shared free list (the slots are not touched).
+    void clear_free_list_no_lock() noexcept
+    {
+        if constexpr (kLockFree)
+            free_head_.store(pack_head(0, (free_head_.load(std::memory_order_relaxed) >> 32) + 1),
+                             std::memory_order_release);
+        else if constexpr (kLowestAddress)
+        {
+            const size_t blocks = chunk_count_.load(std::memory_order_relaxed) + 1;
+            for (size_t b = 0; b < blocks; ++b)
+                block_bits(b).clear();
+            free_block_hint_ = 0;
+        }
+        else
+        {
+            free_head_ = nullptr;
+            if constexpr (kFifo)
+                free_tail_ = nullptr;
+        }
+    }
+
+    // Adds capacity to a growable pool: re-commits the lowest chunk released by
+    // shrink_to_fit() (its slots go to the free list), or appends a new chunk
+    // past index_end_. Caller must hold the mutex (growth mutex in lock-free mode).
+    // Returns false if the pool cannot grow any further.
+    bool grow_no_lock() noexcept
+    {
+        const size_t count = chunk_count_.load(std::memory_order_relaxed);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            Chunk& chunk = chunks_[i];
+            if (chunk.memory.load(std::memory_order_relaxed))
+                continue;
+
+            std::byte* memory = allocate_block(chunk.slots);
+            if (!memory)
+                return false;
+
+            // The generation array of a released chunk stays allocated.
+            chunk.memory.store(memory, std::memory_order_release);
+            committed_slots_.fetch_add(chunk.slots, std::memory_order_relaxed);
+            push_chunk_no_lock(memory, chunk.first_index, chunk.slots);
+
+            trace(PoolEvent::Grow, memory, chunk.slots, [&] {
+                return "[Pool][GROW][RECOMMIT] slots=" + std::to_string(chunk.slots) +
+                       " first_index=" + std::to_string(chunk.first_index) + "\n";
+            });
+            return true;
+        }
+
+        if (count >= max_chunks_)
+            return false;
+
+        const size_t end = index_end_.load(std::memory_order_relaxed);
+        const size_t previous = count == 0 ? capacity_ : chunks_[count - 1].slots;
+        const size_t slots = next_chunk_slots(previous, end);
+        if (slots == 0)
+            return false;
+
+        std::byte* memory = allocate_block(slots);
+        if (!memory)
+            return false;
+
+        Chunk& chunk = chunks_[count];
+#ifdef OxiMemPool_WeakRefs
+        // An entry dropped by shrink_to_fit() is re-appended with the same
+        // index range (the chunk sequence is deterministic) and keeps counting.
+        assert(!chunk.generations || (chunk.first_index == end && chunk.slots == slots));
+        if (!chunk.generations)
+        {
+            chunk.generations.reset(new (std::nothrow) std::atomic<std::uint32_t>[slots]());
+            if (!chunk.generations)
+            {
+                release_block(memory, slots);
+                return false;
+            }
+        }
+#endif
+#ifdef OxiMemPool_Occupancy
+        // Same as the generations; a released chunk had no live bits left.
+        assert(!chunk.occupancy || (chunk.first_index == end && chunk.slots == slots));
+        if (!chunk.occupancy)
+        {
+            chunk.occupancy.reset(new (std::nothrow) std::atomic<std::uint64_t>[occupancy_words(slots)]());
+            if (!chunk.occupancy)
+            {
+                release_block(memory, slots);
+                return false;
+            }
+        }
+#endif
+#ifdef OxiMemPool_SharedHandles
+        // A count is only meaningful while its slot holds a shared object.
+        if (!chunk.refcounts)
+        {
+            chunk.refcounts.reset(new (std::nothrow) std::atomic<std::uint32_t>[slots]());
+            if (!chunk.refcounts)
+            {
+                release_block(memory, slots);
+                return false;
+            }
+        }
+#endif
+#ifdef OxiMemPool_Profile
+        // A released chunk held no objects, so its samples are all clear.
+        if (!chunk.samples)
+        {
+            chunk.samples.reset(new (std::nothrow) AllocationSample[slots]);
+            if (!chunk.samples)
+            {
+                release_block(memory, slots);
+                return false;
+            }
+        }
+#endif
+        if constexpr (kLowestAddress)
+        {
+            // Kept across shrink_to_fit() like the side arrays above.
+            if (!chunk.free_bits.words && !chunk.free_bits.allocate(slots))
+            {
+                release_block(memory, slots);
+                return false;
+            }
+        }
+        chunk.first_index = end;
+        chunk.slots = slots;
+        chunk.memory.store(memory, std::memory_order_relaxed);
+
+        chunk_count_.store(count + 1, std::memory_order_release);
+        committed_slots_.fetch_add(slots, std::memory_order_relaxed);
+        index_end_.store(end + slots, std::memory_order_release);
+
+        trace(PoolEvent::Grow, memory, slots, [&] {
+            return "[Pool][GROW] slots=" + std::to_string(slots) + " capacity=" +
+                   std::to_string(committed_slots_.load(std::memory_order_relaxed)) + "\n";
+        });
+        return true;
+    }
+
+    // Slow path of a lock-free allocation that found neither a free slot nor
+    // bump space. Returns true if another attempt may succeed.
+    bool grow_locked() noexcept
+    {
+        if (growth_.mode == GrowthPolicy::Mode::None)
+            return false;
+
+        std::lock_guard<GrowthMutex> g(growth_mutex_);
+
+        // Somebody else grew or freed a slot while we were waiting.
+        if ((free_head_.load(std::memory_order_acquire) & kIndexMask) != 0 ||
+            max_allocated_index_.load(std::memory_order_relaxed) <
+                index_end_.load(std::memory_order_acquire))
+            return true;
+
+        return grow_no_lock();
+    }
+
+    // Reads the link of `node`, the head of the lock-free free list when the
+    // caller loaded it. Another thread may pop the slot and construct an
+    // object in it in the meantime; the tagged CAS in allocate_lock_free()
+    // then fails and the value is discarded. That overlap with the plain
+    // constructor write is a deliberate, known race, hidden from TSan.
+    static std::uint32_t load_speculative_link(FreeSlot* node) noexcept
+    {
+#ifdef OxiMemPool_TsanAnnotations
+        AnnotateIgnoreReadsBegin(__FILE__, __LINE__);
+#endif
+        const std::uint32_t next =
+            std::atomic_ref<std::uint32_t>(node->next).load(std::memory_order_relaxed);
+#ifdef OxiMemPool_TsanAnnotations
+        AnnotateIgnoreReadsEnd(__FILE__, __LINE__);
+#endif
+        return next;
+    }
+
+    // Lock-free allocation: Treiber-stack pop, then the atomic bump index.
+    // Never throws; returns nullptr if the pool is exhausted.
+    T* allocate_lock_free() noexcept
+    {
+    retry:
+        std::uint64_t head = free_head_.load(std::memory_order_acquire);
+        while (head & kIndexMask)
+        {
+            const size_t idx = static_cast<size_t>((head & kIndexMask) - 1);
+            auto* node = slot_at(idx);
+
+            const std::uint32_t next = load_speculative_link(node);
+
+            if (free_head_.compare_exchange_weak(head, pack_head(next, (head >> 32) + 1),
+                                                 std::memory_order_acquire,
+                                                 std::memory_order_acquire))
+            {
+#ifdef OxiMemPool_Hardened
+                // Only a successful pop saw the link of a free slot.
+                check_link_index(node, next);
+#endif
+                if (kPrefetchNext && next != 0)
+                    pool_prefetch(slot_at(next - 1));
+                trace(PoolEvent::AllocReuse, node, idx, [&] {
+                    return "[Pool][ALLOC][REUSE] slot=" +
+                           std::to_string(reinterpret_cast<std::uintptr_t>(node)) + "\n";
+                });
+
+                return reinterpret_cast<T*>(node);
+            }
+        }
+
+        size_t idx = 0;
+        if (growth_.mode == GrowthPolicy::Mode::None)
+        {
+            if (max_allocated_index_.load(std::memory_order_relaxed) >= capacity_)
+            {
+                return nullptr; // pool exhausted
+            }
+
+            idx = max_allocated_index_.fetch_add(1, std::memory_order_relaxed);
+            if (idx >= capacity_)
+            {
+                return nullptr; // lost the race for the last bump slots
+            }
+        }
+        else
+        {
+            // A growable pool must not overshoot index_end_: an overshot index
+            // would be skipped forever once the next chunk is appended.
+            idx = max_allocated_index_.load(std::memory_order_relaxed);
+            do
+            {
+                if (idx >= index_end_.load(std::memory_order_acquire))
+                {
+                    if (!grow_locked())
+                        return nullptr; // pool exhausted at max_capacity()
+                    goto retry;
+                }
+            } while (!max_allocated_index_.compare_exchange_weak(idx, idx + 1,
+                                                                 std::memory_order_relaxed));
+        }
+
+        return new_slot(idx);
+    }
+
+    // Allocation for SingleThread, Mutex and OwnerThread pools: free list,
+    // then (OwnerThread) the remote-free list, then bump index.
+    // Caller must hold the mutex in Mutex mode.
+    // Never throws; returns nullptr if the pool is exhausted.
+    T* allocate_locked() noexcept
+    {
+        if constexpr (kOwnerThread)
+            assert(on_owner_thread() && "OwnerThread pools allocate on the owner thread only");
+
+    retry:
+        if (FreeSlot* node = pop_free_no_lock())
+        {
+            trace_slot(PoolEvent::AllocReuse, node, [&] {
+                return "[Pool][ALLOC][REUSE] slot=" +
+                       std::to_string(reinterpret_cast<std::uintptr_t>(node)) + "\n";
+            });
+
+            return reinterpret_cast<T*>(node);
+        }
+
+        if constexpr (kOwnerThread)
+        {
+            if (reclaim_remote_no_lock() != 0)
+                goto retry;
+        }
+
+        if (max_allocated_index_ >= index_end_.load(std::memory_order_relaxed))
+        {
+            if (growth_.mode != GrowthPolicy::Mode::None && grow_no_lock())
+                goto retry;
+            return nullptr; // pool exhausted
+        }
+
+        return new_slot(max_allocated_index_++);
+    }
+
+    // First use of the slot with global index `idx` taken from the bump region.
+    T* new_slot(size_t idx) noexcept
+    {
+        std::byte* raw = slot_address(idx);
+        auto* ptr = std::launder(reinterpret_cast<T*>(raw));
+
+        trace(PoolEvent::AllocNew, ptr, idx, [&] {
+            return "[Pool][ALLOC][NEW] slot=" +
+                   std::to_string(reinterpret_cast<std::uintptr_t>(ptr)) + " index=" +
+                   std::to_string(idx) + "\n";
+        });
+
+        return ptr;
+    }
+
+    // Allocate a raw slot without locking.
+    // In lock-free mode this is the Treiber-stack pop and needs no lock at all.
+    // Caller must hold the mutex in Mutex mode.
+    // Never throws; returns nullptr if the pool is exhausted.
+    T* allocate_no_lock() noexcept
+    {
+        if constexpr (kLockFree)
+            return allocate_lock_free();
+        else
+            return allocate_locked();
+    }
+
+    // Return a slot to the free-list without locking.
+    // Caller must hold the mutex if thread-safety is enabled.
+    // In lock-free mode this is the Treiber-stack push.
+    void free_no_lock(T* obj) noexcept
+    {
+        auto* node = reinterpret_cast<FreeSlot*>(obj);
+        if constexpr (kLockFree)
+        {
+            const auto index1 = static_cast<std::uint64_t>(slot_index(node) + 1);
+            std::uint64_t head = free_head_.load(std::memory_order_relaxed);
+            do
+            {
+                std::atomic_ref<std::uint32_t>(node->next)
+                    .store(static_cast<std::uint32_t>(head & kIndexMask), std::memory_order_relaxed);
+            } while (!free_head_.compare_exchange_weak(head, pack_head(index1, (head >> 32) + 1),
+                                                       std::memory_order_release,
+                                                       std::memory_order_relaxed));
+        }
+        else if constexpr (kLowestAddress)
+        {
+            mark_free_no_lock(slot_index(node));
+        }
+        else if constexpr (kFifo)
+        {
+            set_next(node, nullptr);
+            if (free_tail_)
+                set_next(free_tail_, node);
+            else
+                free_head_ = node;
+            free_tail_ = node;
+        }
+        else
+        {
+            set_next(node, free_head_);
+            free_head_ = node;
+        }
+
+        trace_slot(PoolEvent::Free, obj, [&] {
+            return "[Pool][FREE] slot=" + std::to_string(reinterpret_cast<std::uintptr_t>(obj)) +
+                   "\n";
+        });
+    }
+
+    // Links `node` in front of `next` (free list and private chains of bulk
+    // reservations and releases). With indexed links the link is an index; in
+    // lock-free mode it is written atomically since stale poppers may still read it.
+    void set_next(FreeSlot* node, FreeSlot* next) noexcept
+    {
+        if constexpr (kIndexedLinks)
+        {
+            const auto next1 = next ? static_cast<std::uint32_t>(slot_index(next) + 1) : 0u;
+            if constexpr (kLockFree)
+                std::atomic_ref<std::uint32_t>(node->next).store(next1, std::memory_order_relaxed);
+            else
+                node->next = next1;
+        }
+        else
+        {
+            node->next = next;
+        }
+    }
+
+    FreeSlot* get_next(FreeSlot* node) const noexcept
+    {
+        if constexpr (kIndexedLinks)
+        {
+            std::uint32_t next1;
+            if constexpr (kLockFree)
+                next1 = std::atomic_ref<std::uint32_t>(node->next).load(std::memory_order_relaxed);
+            else
+                next1 = node->next;
+            return next1 ? slot_at(next1 - 1) : nullptr;
+        }
+        else
+        {
+            return node->next;
+        }
+    }
+
+    // Splices a private chain first..last onto the free-list in one step.
+    // Caller must hold the mutex if thread-safety is enabled.
+    // In lock-free mode this is a single CAS.
+    void splice_no_lock(FreeSlot* first, FreeSlot* last) noexcept
+    {
+        if constexpr (kLockFree)
+        {
+            const auto first1 = static_cast<std::uint64_t>(slot_index(first) + 1);
+            std::uint64_t head = free_head_.load(std::memory_order_relaxed);
+            do
+            {
+                std::atomic_ref<std::uint32_t>(last->next)
+                    .store(static_cast<std::uint32_t>(head & kIndexMask), std::memory_order_relaxed);
+            } while (!free_head_.compare_exchange_weak(head, pack_head(first1, (head >> 32) + 1),
+                                                       std::memory_order_release,
+                                                       std::memory_order_relaxed));
+        }
+        else if constexpr (kLowestAddress)
+        {
+            for (FreeSlot* node = first;;)
+            {
+                FreeSlot* next = get_next(node);
+                mark_free_no_lock(slot_index(node));
+                if (node == last)
+                    break;
+                node = next;
+            }
+        }
+        else if constexpr (kFifo)
+        {
+            set_next(last, nullptr);
+            if (free_tail_)
+                set_next(free_tail_, first);
+            else
+                free_head_ = first;
+            free_tail_ = last;
+        }
+        else
+        {
+            set_next(last, free_head_);
+            free_head_ = first;
+        }
+    }
+
+    // Return several slots to the free-list at once.
+    // Caller must hold the mutex if thread-safety is enabled.
+    // The slots are linked privately and spliced in one step.
+    void free_batch_no_lock(T* const* objs, size_t count) noexcept
+    {
+        if (count == 0)
+            return;
+
+        for (size_t i = 0; i + 1 < count; ++i)
+            set_next(reinterpret_cast<FreeSlot*>(objs[i]), reinterpret_cast<FreeSlot*>(objs[i + 1]));
+
+        splice_no_lock(reinterpret_cast<FreeSlot*>(objs[0]),
+                       reinterpret_cast<FreeSlot*>(objs[count - 1]));
+
+        trace(PoolEvent::FreeBatch, nullptr, count, [&] {
+            return "[Pool][FREE][BATCH] count=" + std::to_string(count) + "\n";
+        });
+    }
+
+    // Slots reserved by emplace_n(): either one contiguous run taken from the
+    // untouched bump region, or a private chain of individually popped slots.
+    struct BulkReservation
+    {
+        size_t run_first = 0;        // global index of the first run slot
+        size_t run_count = 0;        // slots left in the run
+        FreeSlot* chain = nullptr;   // private chain of popped slots
+        size_t chain_count = 0;      // slots left in the chain
+
+        size_t size() const noexcept { return run_count + chain_count; }
+    };
+
+    // Try to take `count` contiguous slots from the bump region.
+    bool reserve_run_no_lock(size_t count, BulkReservation& r) noexcept
+    {
+        size_t bump = 0;
+        if constexpr (kLockFree)
+        {
+            bump = max_allocated_index_.load(std::memory_order_relaxed);
+            do
+            {
+                const size_t end = index_end_.load(std::memory_order_acquire);
+                if (bump >= end || end - bump < count)
+                    return false;
+            } while (!max_allocated_index_.compare_exchange_weak(bump, bump + count,
+                                                                 std::memory_order_relaxed));
+        }
+        else
+        {
+            bump = max_allocated_index_;
+            const size_t end = index_end_.load(std::memory_order_relaxed);
+            if (bump >= end || end - bump < count)
+                return false;
+            max_allocated_index_ = bump + count;
+        }
+
+        // A run never crosses a chunk boundary, so its slots are contiguous.
+        if (bump < capacity_ ? bump + count > capacity_
+                             : bump + count > chunks_[chunk_of_index(bump)].first_index +
+                                              chunks_[chunk_of_index(bump)].slots)
+        {
+            if constexpr (!kLockFree)
+            {
+                max_allocated_index_ = bump;
+                return false;
+            }
+
+            // The slots are taken already: keep them as a private chain.
+            for (size_t i = 0; i < count; ++i)
+            {
+                auto* node = slot_at(bump + i);
+                set_next(node, r.chain);
+                r.chain = node;
+            }
+            r.chain_count += count;
+        }
+        else
+        {
+            r.run_first = bump;
+            r.run_count = count;
+        }
+
+        // Reported the same way for a run and a chain of fresh slots.
+        trace(PoolEvent::AllocBulk, nullptr, count, [&] {
+            return "[Pool][ALLOC][BULK] index=" + std::to_string(bump) + " count=" +
+                   std::to_string(count) + "\n";
+        });
+        return true;
+    }
+
+    // Reserve exactly `count` slots, all or nothing.
+    // Caller must hold the mutex if thread-safety is enabled.
+    bool reserve_bulk_no_lock(size_t count, BulkReservation& r) noexcept
+    {
+        if (reserve_run_no_lock(count, r))
+            return true;
+
+        while (r.chain_count < count)
+        {
+            T* slot = allocate_no_lock();
+            if (!slot)
+            {
+                release_reservation_no_lock(r);
+                return false;
+            }
+
+            auto* node = reinterpret_cast<FreeSlot*>(slot);
+            set_next(node, r.chain);
+            r.chain = node;
+            ++r.chain_count;
+        }
+        return true;
+    }
+
+    T* take_reserved(BulkReservation& r) noexcept
+    {
+        if (r.run_count)
+        {
+            --r.run_count;
+            return std::launder(reinterpret_cast<T*>(slot_address(r.run_first++)));
+        }
+
+        FreeSlot* node = r.chain;
+        r.chain = get_next(node);
+        --r.chain_count;
+        return reinterpret_cast<T*>(node);
+    }
+
+    // Give every slot still held by a reservation back to the free-list.
+    // Caller must hold the mutex if thread-safety is enabled.
+    void release_reservation_no_lock(BulkReservation& r) noexcept
+    {
+        while (r.run_count)
+        {
+            auto* node = slot_at(r.run_first++);
+            set_next(node, r.chain);
+            r.chain = node;
+            --r.run_count;
+            ++r.chain_count;
+        }
+
+        if (!r.chain)
+            return;
+
+        FreeSlot* last = r.chain;
+        while (FreeSlot* next = get_next(last))
+            last = next;
+
+        splice_no_lock(r.chain, last);
+        r.chain = nullptr;
+        r.chain_count = 0;
+    }
+
+    // Visits every node on the shared free list. Caller must hold the mutex
+    // (in lock-free mode: no concurrent operations).
+    template <typename Fn>
+    void for_each_free_slot_no_lock(Fn&& fn) const
+    {
+        if constexpr (kLockFree)
+        {
+            for (std::uint64_t index1 = free_head_.load(std::memory_order_acquire) & kIndexMask; index1 != 0;)
+            {
+                FreeSlot* node = slot_at(static_cast<size_t>(index1 - 1));
+                index1 = node->next;
+                fn(node);
+            }
+        }
+        else if constexpr (kLowestAddress)
+        {
+            const size_t blocks = chunk_count_.load(std::memory_order_relaxed) + 1;
+            for (size_t b = 0; b < blocks; ++b)
+            {
+                const size_t first = block_first(b);
+                const FreeBitmap& bits = b == 0 ? free_bits_ : chunks_[b - 1].free_bits;
+                bits.for_each([&](size_t local) { fn(slot_at(first + local)); });
+            }
+        }
+        else
+        {
+            for (FreeSlot* node = free_head_; node;)
+            {
+                FreeSlot* next = get_next(node);
+                fn(node);
+                node = next;
+            }
+        }
+    }
+
+    // Relinks the shared free list keeping only nodes for which keep(node) is
+    // true, in their original order. Same locking rules as above.
+    template <typename Keep>
+    void rebuild_free_list_no_lock(Keep&& keep)
+    {
+        if constexpr (kLockFree)
+        {
+            std::uint64_t head = free_head_.load(std::memory_order_acquire);
+            std::uint32_t* link = nullptr;
+            std::uint64_t new_first = 0;
+            for (std::uint64_t index1 = head & kIndexMask; index1 != 0;)
+            {
+                const size_t idx = static_cast<size_t>(index1 - 1);
+                FreeSlot* node = slot_at(idx);
+                index1 = node->next;
+                if (!keep(node))
+                    continue;
+                if (link)
+                    *link = static_cast<std::uint32_t>(idx + 1);
+                else
+                    new_first = idx + 1;
+                link = &node->next;
+            }
+            if (link)
+                *link = 0;
+            free_head_.store(pack_head(new_first, (head >> 32) + 1), std::memory_order_release);
+        }
+        else if constexpr (kLowestAddress)
+        {
+            const size_t blocks = chunk_count_.load(std::memory_order_relaxed) + 1;
+            for (size_t b = 0; b < blocks; ++b)
+            {
+                const size_t first = block_first(b);
+                FreeBitmap& bits = block_bits(b);
+                bits.for_each([&](size_t local) {
+                    if (!keep(slot_at(first + local)))
+                        bits.reset(local);
+                });
+            }
+        }
+        else
+        {
+            FreeSlot* last = nullptr;
+            for (FreeSlot* node = free_head_; node;)
+            {
+                FreeSlot* next = get_next(node);
+                if (keep(node))
+                {
+                    if (last)
+                        set_next(last, node);
+                    else
+                        free_head_ = node;
+                    last = node;
+                }
+                node = next;
+            }
+            if (last)
+                set_next(last, nullptr);
+            else
+                free_head_ = nullptr;
+            if constexpr (kFifo)
+                free_tail_ = last;
+        }
+    }
+
+    // Take a slot from the shared free list, locking if thread-safety is enabled.
+    T* allocate_shared_list() noexcept
+    {
+        std::lock_guard<ListMutex> g(mutex_);
+        return allocate_no_lock();
+    }
+
+    // Return a slot to the shared free list, locking if thread-safety is enabled.
+    void free_shared_list(T* obj) noexcept
+    {
+        std::lock_guard<ListMutex> g(mutex_);
+        free_no_lock(obj);
+    }
+
+    // OwnerThread: true if the calling thread owns the pool.
+    bool on_owner_thread() const noexcept
+    {
+        return std::this_thread::get_id() == owner_;
+    }
+
+    // OwnerThread: pushes the private chain first..last onto the remote-free
+    // list with a single CAS. The chain is only read by the owner after the
+    // exchange that takes it, so the links need no atomics; the head pointer
+    // alone decides the CAS, which makes a push immune to ABA.
+    void push_remote(FreeSlot* first, FreeSlot* last) noexcept
+    {
+        FreeSlot* head = remote_head_.load(std::memory_order_relaxed);
+        do
+        {
+            set_next(last, head);
+        } while (!remote_head_.compare_exchange_weak(head, first,
+                                                     std::memory_order_release,
+                                                     std::memory_order_relaxed));
+    }
+
+    // OwnerThread: takes every slot freed by other threads in one exchange and
+    // splices it onto the free list. Called by the owner when its free list
+    // runs dry and before operations that scan the free list. Returns the
+    // number of slots reclaimed.
+    size_t reclaim_remote_no_lock() noexcept
+    {
+        FreeSlot* first = remote_head_.exchange(nullptr, std::memory_order_acquire);
+        if (!first)
+            return 0;
+
+        // The walk finds the tail for the splice (and is needed anyway by the
+        // bitmap and FIFO policies).
+        size_t count = 1;
+        FreeSlot* last = first;
+        while (FreeSlot* next = get_next(last))
+        {
+            last = next;
+            ++count;
+        }
+        splice_no_lock(first, last);
+
+        trace(PoolEvent::RemoteReclaim, nullptr, count, [&] {
+            return "[Pool][FREE][RECLAIM] count=" + std::to_string(count) + "\n";
+        });
+        return count;
+    }
+
+#ifdef OxiMemPool_ThreadCache
+    // Magazine of the calling thread for this pool, created on first use.
+    Magazine& thread_magazine()
+    {
+        auto& entries = tls_cache().entries;
+        for (auto& entry : entries)
+        {
+            if (entry.anchor == cache_anchor_)
+                return *entry.magazine;
+        }
+
+        // Drop entries of pools that no longer exist before growing the list.
+        std::erase_if(entries, [](const typename ThreadCache::Entry& entry) {
+            std::lock_guard<std::mutex> g(entry.anchor->mutex);
+            return entry.anchor->pool == nullptr;
+        });
+
+        auto magazine = std::make_unique<Magazine>();
+        entries.reserve(entries.size() + 1);
+        {
+            std::lock_guard<std::mutex> g(cache_anchor_->mutex);
+            cache_anchor_->magazines.push_back(magazine.get());
+        }
+        entries.push_back(typename ThreadCache::Entry{cache_anchor_, std::move(magazine)});
+        return *entries.back().magazine;
+    }
+
+    // Move up to `count` slots from the front of a magazine back to the shared list
+    // in a single lock acquisition (or a single CAS in lock-free mode) and hand
+    // them to waiters.
+    void flush_magazine(Magazine& mag, size_t count) noexcept
+    {
+        return_magazine_slots(mag, count);
+#ifdef OxiMemPool_AsyncEmplace
+        notify_waiters(); // after the pool lock is released
+#endif
+    }
+
+    // flush_magazine() without serving waiters, for callers that hold the
+    // cache anchor mutex or notify themselves.
+    void return_magazine_slots(Magazine& mag, size_t count) noexcept
+    {
+        if (count == 0)
+            return;
+
+        {
+            std::lock_guard<ListMutex> g(mutex_);
+            free_batch_no_lock(mag.slots, count);
+        }
+
+        for (size_t i = count; i < mag.count; ++i)
+            mag.slots[i - count] = mag.slots[i];
+        mag.count -= count;
+
+        trace(PoolEvent::CacheFlush, nullptr, count, [&] {
+            return "[Pool][CACHE][FLUSH] count=" + std::to_string(count) + "\n";
+        });
+    }
+
+    // Refill an empty magazine with up to `count` slots in a single lock acquisition.
+    void refill_magazine(Magazine& mag, size_t count) noexcept
+    {
+        {
+            std::lock_guard<ListMutex> g(mutex_);
+            while (mag.count < count)
+            {
+                T* slot = allocate_no_lock();
+                if (!slot)
+                    break;
+                mag.slots[mag.count++] = slot;
+            }
+        }
+
+        trace(PoolEvent::CacheRefill, nullptr, mag.count, [&] {
+            return "[Pool][CACHE][REFILL] count=" + std::to_string(mag.count) + "\n";
+        });
+    }
+#endif
+
+    // Take a slot for a new object: from the thread cache when enabled,
+    // otherwise from the shared free list. Returns nullptr if exhausted.
+    T* allocate_slot()
+    {
+#ifdef OxiMemPool_ThreadCache
+        const size_t limit = kThreadCache ? magazine_size_.load(std::memory_order_relaxed) : 0;
+        if (limit != 0)
+        {
+            Magazine& mag = thread_magazine();
+            if (mag.count == 0)
+                refill_magazine(mag, (limit + 1) / 2);
+            if (mag.count == 0)
+                return nullptr;
+            T* slot = mag.slots[--mag.count];
+            if (kPrefetchNext && mag.count != 0)
+                pool_prefetch(mag.slots[mag.count - 1]);
+            return slot;
+        }
+#endif
+        return allocate_shared_list();
+    }
+
+    // Give a slot back: to the thread cache when enabled (flushing half of a
+    // full magazine in one batch), to the remote-free list when an OwnerThread
+    // pool is used from another thread, otherwise to the shared free list.
+    void free_slot(T* obj) noexcept
+    {
+#ifdef OxiMemPool_ThreadCache
+        const size_t limit = kThreadCache ? magazine_size_.load(std::memory_order_relaxed) : 0;
+        if (limit != 0)
+        {
+            // Only reached for threads that already own a magazine entry or can
+            // create one; a failed allocation falls back to the shared list.
+            Magazine* mag = nullptr;
+            try {
+                mag = &thread_magazine();
+            }
+            catch (...) {
+                free_shared_list(obj);
+                return;
+            }
+
+            // The caller serves waiters once the slot is back.
+            if (mag->count >= limit)
+                return_magazine_slots(*mag, mag->count - limit / 2);
+            mag->slots[mag->count++] = obj;
+            return;
+        }
+#endif
+        if constexpr (kOwnerThread)
+        {
+            if (!on_owner_thread())
+            {
+                auto* node = reinterpret_cast<FreeSlot*>(obj);
+                push_remote(node, node);
+                trace_slot(PoolEvent::Free, obj, [&] {
+                    return "[Pool][FREE][REMOTE] slot=" +
+                           std::to_string(reinterpret_cast<std::uintptr_t>(obj)) + "\n";
+                });
+                return;
+            }
+        }
+        free_shared_list(obj);
+    }
+
+    /**
+     * Destroys an object and returns its slot to the free-list.
+     * The destructor of T is executed before acquiring the pool lock
+     * (if enabled) to reduce the risk of re-entrancy issues.
+     *
+     * Requirement: T::~T() must not re-enter this pool in an unsafe manner.
+     */
+    void destroy_object(T* obj) noexcept
+    {
+        trace_slot(PoolEvent::ObjectDestroy, obj, [&] {
+            return "[Pool][OBJ_DTOR] object=" +
+                   std::to_string(reinterpret_cast<std::uintptr_t>(obj)) + "\n";
+        });
+
+#ifdef OxiMemPool_Hardened
+        release_checked(obj);
+#endif
+#ifdef OxiMemPool_Occupancy
+        set_occupied(obj, false);
+#endif
+#ifdef OxiMemPool_Profile
+        clear_sample(obj);
+#endif
+        std::destroy_at(obj);
+#ifdef OxiMemPool_WeakRefs
+        bump_generation(obj);
+#endif
+#ifdef OxiMemPool_Hardened
+        poison_slot(obj);
+#endif
+
+        // Decrement before the slot becomes visible to other threads so that
+        // size() never exceeds capacity() while the slot is being reused.
+        sub_used(1);
+        free_slot(obj);
+#ifdef OxiMemPool_AsyncEmplace
+        notify_waiters();
+#endif
+    }
+
+#ifdef OxiMemPool_AsyncEmplace
+    size_t waiting_count() const noexcept
+    {
+        if constexpr (kSingleThread)
+            return waiting_;
+        else
+            return waiting_.load(std::memory_order_relaxed);
+    }
+
+    void set_waiting(size_t count) noexcept
+    {
+        if constexpr (kSingleThread)
+            waiting_ = count;
+        else
+            waiting_.store(count, std::memory_order_relaxed);
+    }
+
+    // True if a waiter may need the slots just given back (see notify_waiters()).
+    bool waiters_pending() noexcept
+    {
+        if constexpr (kWaiters)
+        {
+            if constexpr (kLockFree)
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+            return waiting_count() != 0;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    // Called after slots were given back. A waiter publishes itself (waiting_)
+    // before it tries to allocate and a free publishes its slot before it
+    // reads waiting_, so one of the two always sees the other. Mutex pools get
+    // that order from mutex_, lock-free pools from the fences here and in
+    // enqueue_waiter_locked().
+    void notify_waiters() noexcept
+    {
+        if constexpr (kWaiters)
+        {
+            if (!waiters_pending())
+                return;
+
+            Waiter* ready = nullptr;
+            {
+                std::lock_guard<WaitMutex> g(wait_mutex_);
+                ready = serve_waiters_locked(nullptr);
+            }
+            resume_waiters(ready);
+        }
+    }
+
+    // Appends `w` to the queue and serves the queue once, so that a slot freed
+    // while `w` was not yet visible is not missed. Caller holds wait_mutex_.
+    Waiter* enqueue_waiter_locked(Waiter& w) noexcept
+    {
+        w.next = nullptr;
+        if (wait_tail_)
+            wait_tail_->next = &w;
+        else
+            wait_head_ = &w;
+        wait_tail_ = &w;
+        set_waiting(waiting_count() + 1);
+        if constexpr (kLockFree)
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        return serve_waiters_locked(&w);
+    }
+
+    // Hands free slots to queued waiters, oldest first, until the pool runs
+    // dry. Thread waiters are notified here; served coroutines other than
+    // `self` are returned as a chain and resumed once the lock is released.
+    // Caller holds wait_mutex_.
+    Waiter* serve_waiters_locked(Waiter* self) noexcept
+    {
+        Waiter* ready = nullptr;
+        Waiter** ready_tail = &ready;
+        while (wait_head_)
+        {
+            T* slot = nullptr;
+            try {
+                slot = allocate_slot();
+            }
+            catch (...) {
+                // No magazine for this thread; a later free serves the queue.
+            }
+            if (!slot)
+                break;
+
+            Waiter* w = wait_head_;
+            wait_head_ = w->next;
+            if (!wait_head_)
+                wait_tail_ = nullptr;
+            set_waiting(waiting_count() - 1);
+
+            w->slot = slot;
+            w->next = nullptr;
+            if (w->signal)
+            {
+                w->signal->notify_one();
+            }
+            else if (w != self)
+            {
+                *ready_tail = w;
+                ready_tail = &w->next;
+            }
+        }
+        return ready;
+    }
+
+    // Removes a waiter that gave up (emplace_wait() timeout). Caller holds wait_mutex_.
+    void remove_waiter_locked(Waiter& w) noexcept
+    {
+        Waiter* prev = nullptr;
+        for (Waiter* it = wait_head_; it; prev = it, it = it->next)
+        {
+            if (it != &w)
+                continue;
+            (prev ? prev->next : wait_head_) = w.next;
+            if (wait_tail_ == &w)
+                wait_tail_ = prev;
+            set_waiting(waiting_count() - 1);
+            return;
+        }
+    }
+
+    // Resumes served coroutines in the order they were served. A resumed
+    // coroutine may destroy its frame (and its Waiter), so the link is read first.
+    static void resume_waiters(Waiter* ready) noexcept
+    {
+        while (ready)
+        {
+            Waiter* w = ready;
+            ready = w->next;
+            w->coroutine.resume();
+        }
+    }
+#endif
+
+    void add_used(size_t count) noexcept
+    {
+        size_t live = 0;
+        if constexpr (kSingleThread)
+        {
+            live = used_count_ += count;
+        }
+        else if constexpr (kShardedCount)
+        {
+            CountShard& shard = count_shards_.shards[thread_shard() % kCountShards];
+            const size_t delta = shard.delta.fetch_add(count, std::memory_order_relaxed) + count;
+#ifdef OxiMemPool_Stats
+            // Only the local shard is touched; stats() combines the peaks.
+            size_t peak = shard.peak.load(std::memory_order_relaxed);
+            while (static_cast<std::ptrdiff_t>(delta) > static_cast<std::ptrdiff_t>(peak) &&
+                   !shard.peak.compare_exchange_weak(peak, delta, std::memory_order_relaxed)) {}
+#else
+            (void)delta;
+#endif
+            return;
+        }
+        else
+        {
+            live = used_count_.fetch_add(count, std::memory_order_acq_rel) + count;
+        }
+#ifdef OxiMemPool_Stats
+        update_peak(live);
+#else
+        (void)live;
+#endif
+    }
+
+    void sub_used(size_t count) noexcept
+    {
+        if constexpr (kSingleThread)
+            used_count_ -= count;
+        else if constexpr (kShardedCount)
+            count_shards_.shards[thread_shard() % kCountShards].delta.fetch_sub(
+                count, std::memory_order_relaxed);
+        else
+            used_count_.fetch_sub(count, std::memory_order_acq_rel);
+    }
+
+    void add_storage(std::ptrdiff_t delta) noexcept
+    {
+        if constexpr (kSingleThread)
+            storage_count_ += static_cast<size_t>(delta);
+        else
+            storage_count_.fetch_add(static_cast<size_t>(delta), std::memory_order_relaxed);
+    }
+
+    size_t storage_in_use() const noexcept
+    {
+        if constexpr (kSingleThread)
+            return storage_count_;
+        else
+            return storage_count_.load(std::memory_order_relaxed);
+    }
+
+    void report_error(const char* msg, size_t code)
+    {
+        trace(PoolEvent::Error, nullptr, code, [&] {
+            return "[Pool][ERROR] " + std::string(msg) + " code=" + std::to_string(code) + "\n";
+        });
+
+#ifdef OxiMemPool_ErrCallback
+        if (err_callback_)
+        {
+            err_callback_(msg, code);
+            return;
+        }
+#endif
+        throw std::runtime_error(msg);
+    }
+
+    // Validates the growth policy and sizes the chunk directory so that it
+    // never has to be reallocated while other threads read it.
+    void initialize_growth()
+    {
+        index_end_.store(capacity_, std::memory_order_relaxed);
+        committed_slots_.store(capacity_, std::memory_order_relaxed);
+        max_capacity_ = capacity_;
+
+        if (growth_.mode == GrowthPolicy::Mode::None)
+            return;
+
+        if (growth_.max_capacity < capacity_ ||
+            (growth_.mode == GrowthPolicy::Mode::FixedStep && growth_.step == 0) ||
+            (growth_.mode == GrowthPolicy::Mode::Geometric && growth_.factor < 2))
+        {
+            report_error("Invalid ObjectPool growth policy", 4);
+            growth_ = GrowthPolicy{};
+            return;
+        }
+
+        max_capacity_ = growth_.max_capacity;
+        if (kSlotSize > std::numeric_limits<size_t>::max() / max_capacity_)
+        {
+            report_error("ObjectPool size overflow", 2);
+            growth_ = GrowthPolicy{};
+            max_capacity_ = capacity_;
+            return;
+        }
+
+        // The chunk sequence is deterministic, so simulate it once.
+        size_t end = capacity_;
+        size_t previous = capacity_;
+        while (const size_t slots = next_chunk_slots(previous, end))
+        {
+            end += slots;
+            previous = slots;
+            ++max_chunks_;
+        }
+
+        chunks_ = std::make_unique<Chunk[]>(max_chunks_);
+    }
+
+    // Allocates the initial block, or adopts `memory` (caller-supplied buffer).
+    void initialize_pool_memory(std::byte* memory)
+    {
+        // Overflow check: kSlotSize * capacity_
+        if (capacity_ != 0 &&
+            kSlotSize > std::numeric_limits<size_t>::max() / capacity_)
+        {
+            report_error("ObjectPool size overflow", 2);
+        }
+
+        const size_t total_bytes = kSlotSize * capacity_;
+
+        pool_memory_ = memory ? memory : allocate_block(capacity_);
+        if (!pool_memory_)
+            throw std::bad_alloc();
+#ifdef OxiMemPool_WeakRefs
+        generations_ = std::make_unique<std::atomic<std::uint32_t>[]>(capacity_);
+#endif
+#ifdef OxiMemPool_Occupancy
+        occupancy_ = std::make_unique<std::atomic<std::uint64_t>[]>(occupancy_words(capacity_));
+#endif
+#ifdef OxiMemPool_SharedHandles
+        refcounts_ = std::make_unique<std::atomic<std::uint32_t>[]>(capacity_);
+#endif
+#ifdef OxiMemPool_Profile
+        samples_ = std::make_unique<AllocationSample[]>(capacity_);
+#endif
+        if constexpr (kLowestAddress)
+        {
+            if (!free_bits_.allocate(capacity_))
+                throw std::bad_alloc();
+        }
+
+        trace(PoolEvent::Init, pool_memory_, capacity_, [&] {
+            return "[Pool][INIT] capacity=" + std::to_string(capacity_) + " bytes=" +
+                   std::to_string(total_bytes) + "\n";
+        });
+    }
+
+    // Constructor body shared by the heap-backed and the buffer-backed pools.
+    void initialize(LogFunction log, std::byte* memory)
+    {
+#ifndef OxiMemPool_NoLogging
+        log_function_ = log;
+#else
+        (void)log; // logging is compiled out
+#endif
+        if (capacity_ == 0)
+            report_error("Pool size cannot be 0", 0);
+        initialize_growth();
+        if constexpr (kIndexedLinks)
+        {
+            if (max_capacity_ > kMaxLockFreeCapacity)
+                report_error("ObjectPool capacity exceeds 32-bit free-list index range", 3);
+        }
+        initialize_pool_memory(memory);
+        if constexpr (kOwnerThread)
+            owner_ = std::this_thread::get_id();
+#ifdef OxiMemPool_ThreadCache
+        if constexpr (kThreadCache)
+        {
+            cache_anchor_ = std::make_shared<CacheAnchor>();
+            cache_anchor_->pool = this;
+        }
+#endif
+    }
+
+    // First slot-aligned byte of a caller-supplied buffer (its end if none).
+    static std::byte* buffer_slots(std::span<std::byte> buffer) noexcept
+    {
+        const auto addr = reinterpret_cast<std::uintptr_t>(buffer.data());
+        const size_t offset = static_cast<size_t>((kSlotAlign - addr % kSlotAlign) % kSlotAlign);
+        return buffer.data() + (offset < buffer.size() ? offset : buffer.size());
+    }
+
+    // Number of whole slots that fit a caller-supplied buffer.
+    static size_t buffer_capacity(std::span<std::byte> buffer) noexcept
+    {
+        return static_cast<size_t>(buffer.data() + buffer.size() - buffer_slots(buffer)) / kSlotSize;
+    }
+
+    // Adopts the free list, bump index and live count of an image. The free
+    // list is only walked (and checked) when the occupancy bitmap has to be
+    // rebuilt; otherwise restoring is O(1) and the image is trusted.
+    void restore_image(const PoolImageState& state)
+    {
+        if (state.bump > capacity_ || state.free_head > state.bump || state.live > state.bump)
+        {
+            report_error("Invalid ObjectPool image state", 9);
+            return; // the error callback keeps the pool empty
+        }
+
+#ifdef OxiMemPool_Occupancy
+        for (size_t idx = 0; idx < state.bump; ++idx)
+            set_occupied(reinterpret_cast<const T*>(slot_address(idx)), true);
+
+        const std::uint64_t free_count = state.bump - state.live;
+        std::uint64_t seen = 0;
+        for (std::uint64_t index1 = state.free_head; index1 != 0; ++seen)
+        {
+            if (index1 > state.bump || seen == free_count)
+            {
+                clear_occupancy_no_lock(state.bump);
+                report_error("Invalid ObjectPool image state", 9);
+                return;
+            }
+            FreeSlot* node = slot_at(static_cast<size_t>(index1 - 1));
+            set_occupied(reinterpret_cast<const T*>(node), false);
+            index1 = node->next;
+        }
+        if (seen != free_count)
+        {
+            clear_occupancy_no_lock(state.bump);
+            report_error("Invalid ObjectPool image state", 9);
+            return;
+        }
+#endif
+
+        if constexpr (kLockFree)
+        {
+            max_allocated_index_.store(static_cast<size_t>(state.bump), std::memory_order_relaxed);
+            free_head_.store(pack_head(state.free_head, 0), std::memory_order_relaxed);
+        }
+        else
+        {
+            max_allocated_index_ = static_cast<size_t>(state.bump);
+            free_head_ = state.free_head != 0 ? slot_at(static_cast<size_t>(state.free_head - 1)) : nullptr;
+        }
+        add_used(static_cast<size_t>(state.live));
+    }
+
+    // Constructs the object of emplace() / try_emplace() in an allocated slot.
+    template <typename... Args>
+    OxiMemPool_ProfileInline PoolHandle<T, Threading> construct_handle(T* slot, Args&&... args)
+    {
+#ifdef OxiMemPool_Hardened
+        acquire_checked(slot);
+#endif
+        try {
+            std::construct_at(slot, std::forward<Args>(args)...);
+        }
+        catch (...) {
+#ifdef OxiMemPool_Hardened
+            poison_slot(slot);
+#endif
+            free_slot(slot);
+#ifdef OxiMemPool_AsyncEmplace
+            notify_waiters();
+#endif
+            throw;
+        }
+
+        add_used(1);
+#ifdef OxiMemPool_Occupancy
+        set_occupied(slot, true);
+#endif
+#ifdef OxiMemPool_Profile
+        maybe_sample(slot);
+#endif
+
+        return PoolHandle<T, Threading>(*this, slot);
+    }
+
+public:
+    explicit ObjectPool(size_t capacity, LogFunction log = nullptr)
+        : ObjectPool(capacity, GrowthPolicy{}, log)
+    {
+    }
+
+    /**
+     * Creates a pool with `capacity` slots in its initial block that grows in
+     * additional chunks according to `growth`, up to growth.max_capacity slots.
+     */
+    ObjectPool(size_t capacity, GrowthPolicy growth, LogFunction log = nullptr)
+#ifdef OxiMemPool_BackingMemory
+        : ObjectPool(capacity, growth, BackingPolicy{}, log)
+    {
+    }
+
+    // Same as above with slot memory (initial block and chunks) taken
+    // according to `backing`, e.g. huge pages bound to one NUMA node.
+    ObjectPool(size_t capacity, BackingPolicy backing, LogFunction log = nullptr)
+        : ObjectPool(capacity, GrowthPolicy{}, backing, log)
+    {
+    }
+
+    ObjectPool(size_t capacity, GrowthPolicy growth, BackingPolicy backing, LogFunction log = nullptr)
+        : capacity_(capacity), growth_(growth), backing_(backing)
+#else
+        : capacity_(capacity), growth_(growth)
+#endif
+    {
+        initialize(log, nullptr);
+    }
+
+    /**
+     * Creates a fixed-capacity pool whose slots are carved out of `buffer`
+     * instead of heap memory: as many slots as fit after aligning its start to
+     * the slot alignment (see slot_size / slot_align). The buffer must outlive
+     * the pool and is never released by it; the pool does not grow.
+     *
+     * Nothing is allocated for the slots. The optional side arrays (weak
+     * references, occupancy, shared handles, the lowest-address bitmap) and
+     * thread caches still allocate when enabled, and so do log messages, the
+     * temporaries of release_all() / compact() and the
+     * exception of an error reported without an error callback.
+     */
+    explicit ObjectPool(std::span<std::byte> buffer, LogFunction log = nullptr)
+        : capacity_(buffer_capacity(buffer)), owns_memory_(false)
+    {
+        initialize(log, buffer_slots(buffer));
+    }
+
+    /**
+     * Re-attaches to the slots of `buffer` as left by a pool whose
+     * image_state() was `state`: the objects in it are live again (as unowned
+     * objects, see emplace_unowned()) and freed slots are reused first. The
+     * buffer must hold the same bytes at the same offset from its slot
+     * alignment, but may be mapped at any address. With OxiMemPool_Occupancy
+     * the bitmap is rebuilt by walking the free list, which also validates it;
+     * an inconsistent state is reported as error 9.
+     */
+    ObjectPool(std::span<std::byte> buffer, const PoolImageState& state, LogFunction log = nullptr)
+        requires supports_image
+        : ObjectPool(buffer, log)
+    {
+        restore_image(state);
+    }
+
+    ~ObjectPool() noexcept
+    {
+#ifndef NDEBUG
+        assert(size() == 0 &&
+               "ObjectPool destroyed with live objects");
+#endif
+#ifdef OxiMemPool_ThreadCache
+        if constexpr (kThreadCache)
+        {
+            // Slots cached by other threads die with the pool memory.
+            std::lock_guard<std::mutex> g(cache_anchor_->mutex);
+            cache_anchor_->pool = nullptr;
+        }
+#endif
+        const size_t count = chunk_count_.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (std::byte* memory = chunks_[i].memory.load(std::memory_order_relaxed))
+                release_block(memory, chunks_[i].slots);
+        }
+        if (owns_memory_)
+            release_block(pool_memory_, capacity_);
+#ifdef OxiMemPool_AsanPoisoning
+        else
+            ASAN_UNPOISON_MEMORY_REGION(pool_memory_, kSlotSize * capacity_); // the caller's buffer again
+#endif
+    }
+
+    // Non-copyable, non-movable
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+    ObjectPool(ObjectPool&&) = delete;
+    ObjectPool& operator=(ObjectPool&&) = delete;
+
+#ifdef OxiMemPool_ErrCallback
+    void set_error_callback(ErrorCallback cb) noexcept {
+        err_callback_ = cb;
+    }
+#endif
+
+#ifdef OxiMemPool_EventHook
+    // Installs an allocation-free hook receiving every pool event (nullptr disables).
+    // Events raised while the constructor runs (Init) are not reported.
+    void set_event_hook(EventHook hook) noexcept {
+        event_hook_ = hook;
+    }
+#endif
+
+    /**
+     * OwnerThread pools: makes the calling thread the owner, e.g. after the
+     * pool was constructed during startup on another thread. Only the owner
+     * may allocate (emplace(), try_emplace(), emplace_n(), emplace_unowned(),
+     * try_allocate_storage()) or call warm(), shrink_to_fit(), compact(),
+     * release_all(), for_each() or stats(); objects may be destroyed, and
+     * handles released, on any thread. Must not run concurrently with any
+     * other operation on the pool.
+     */
+    void set_owner_thread() noexcept
+        requires (Threading == PoolThreading::OwnerThread)
+    {
+        owner_ = std::this_thread::get_id();
+    }
+
+    /**
+     * Constructs an object of type T in a free slot and returns a PoolHandle.
+     * Strong exception safety: if T's constructor throws, the slot is returned
+     * back to the free-list and the exception is propagated.
+     */
+    template <typename... Args>
+    OxiMemPool_ProfileInline PoolHandle<T, Threading> emplace(Args&&... args)
+    {
+        T* slot = allocate_slot();
+
+        if (!slot) {
+#ifdef OxiMemPool_ErrCallback
+            // If an error callback is set, invoke it and return an empty handle
+            if (err_callback_) {
+                trace(PoolEvent::Error, nullptr, 1, [&] {
+                    return "[Pool][ERROR] exhausted -> calling err_callback\n";
+                });
+                err_callback_("ObjectPool exhausted", 1);
+                return PoolHandle<T, Threading>{};
+            }
+#endif
+            report_error("ObjectPool exhausted", 1);
+        }
+
+        return construct_handle(slot, std::forward<Args>(args)...);
+    }
+
+    /**
+     * Like emplace(), but exhaustion is an expected outcome rather than an
+     * error: returns an empty handle without throwing, logging or calling the
+     * error callback, whatever the configuration macros. Exceptions thrown by
+     * T's constructor still propagate, with the slot returned first.
+     */
+    template <typename... Args>
+    OxiMemPool_ProfileInline PoolHandle<T, Threading> try_emplace(Args&&... args)
+    {
+        T* slot = allocate_slot();
+        if (!slot)
+        {
+#ifdef OxiMemPool_Stats
+            bump_stat(kExhausted, 1);
+#endif
+            return PoolHandle<T, Threading>{};
+        }
+
+        return construct_handle(slot, std::forward<Args>(args)...);
+    }
+
+#ifdef OxiMemPool_AsyncEmplace
+    /**
+     * Awaitable returned by async_emplace(). It holds references to the
+     * arguments, so it must be awaited in the full-expression that creates it.
+     */
+    template <typename... Args>
+    class [[nodiscard]] EmplaceAwaiter
+    {
+        friend class ObjectPool;
+
+        ObjectPool& pool_;
+        std::tuple<Args&&...> args_;
+        Waiter waiter_{};
+
+        explicit EmplaceAwaiter(ObjectPool& pool, Args&&... args) noexcept
+            : pool_(pool), args_(std::forward<Args>(args)...)
+        {
+        }
+
+    public:
+        EmplaceAwaiter(const EmplaceAwaiter&) = delete;
+        EmplaceAwaiter& operator=(const EmplaceAwaiter&) = delete;
+
+        // Takes a free slot unless older waiters are queued.
+        bool await_ready()
+        {
+            if (pool_.waiting_count() == 0)
+                waiter_.slot = pool_.allocate_slot();
+            return waiter_.slot != nullptr;
+        }
+
+        // Queues the coroutine; does not suspend if it was served right away.
+        bool await_suspend(std::coroutine_handle<> coroutine) noexcept
+        {
+            waiter_.coroutine = coroutine;
+            Waiter* ready = nullptr;
+            bool queued = false;
+            {
+                std::lock_guard<WaitMutex> g(pool_.wait_mutex_);
+                ready = pool_.enqueue_waiter_locked(waiter_);
+                queued = waiter_.slot == nullptr;
+            }
+            // Once queued, this awaiter may already be resumed and gone.
+            resume_waiters(ready);
+            return queued;
+        }
+
+        OxiMemPool_ProfileInline PoolHandle<T, Threading> await_resume()
+        {
+            return std::apply([this](auto&&... args) {
+                return pool_.construct_handle(waiter_.slot, std::forward<Args>(args)...);
+            }, std::move(args_));
+        }
+    };
+
+    /**
+     * co_await pool.async_emplace(args...) constructs an object like emplace()
+     * but suspends the coroutine while the pool is exhausted instead of
+     * reporting an error. Waiters are served in FIFO order: the thread that
+     * frees the next slot (destroy_object(), release_bulk(), release_all())
+     * hands it to the oldest waiter and resumes that coroutine inline, before
+     * its own call returns. A new call queues behind existing waiters;
+     * emplace() and try_emplace() do not, and may take a slot first.
+     *
+     * Resumption runs inside a noexcept destruction path, so the coroutine's
+     * promise must not rethrow from unhandled_exception(). A suspended
+     * coroutine must not be destroyed, nor the pool, while it waits. With
+     * thread caches, slots parked in other threads' magazines are only handed
+     * over once flushed: when a magazine overflows, its thread exits or calls
+     * drain_thread_cache(). Not available for OwnerThread pools.
+     */
+    template <typename... Args>
+    EmplaceAwaiter<Args...> async_emplace(Args&&... args) noexcept
+        requires (Threading != PoolThreading::OwnerThread)
+    {
+        return EmplaceAwaiter<Args...>(*this, std::forward<Args>(args)...);
+    }
+
+    /**
+     * Blocking counterpart of async_emplace() for thread-based code: waits up to
+     * `timeout` for a slot (in the same FIFO queue) and returns an empty handle
+     * if none became free in time. Exceptions thrown by T's constructor
+     * propagate as in emplace().
+     */
+    template <typename Rep, typename Period, typename... Args>
+    OxiMemPool_ProfileInline PoolHandle<T, Threading> emplace_wait(std::chrono::duration<Rep, Period> timeout, Args&&... args)
+        requires (Threading == PoolThreading::Mutex || Threading == PoolThreading::LockFree)
+    {
+        T* slot = waiting_count() == 0 ? allocate_slot() : nullptr;
+        if (!slot)
+        {
+            const auto deadline = std::chrono::steady_clock::now() + timeout;
+            std::condition_variable signal;
+            Waiter w;
+            w.signal = &signal;
+
+            std::unique_lock<std::mutex> lock(wait_mutex_);
+            if (Waiter* ready = enqueue_waiter_locked(w))
+            {
+                lock.unlock();
+                resume_waiters(ready);
+                lock.lock();
+            }
+            while (!w.slot && signal.wait_until(lock, deadline) == std::cv_status::no_timeout)
+            {
+            }
+            if (!w.slot)
+            {
+                remove_waiter_locked(w);
+#ifdef OxiMemPool_Stats
+                bump_stat(kExhausted, 1);
+#endif
+                return PoolHandle<T, Threading>{};
+            }
+            slot = w.slot;
+        }
+
+        return construct_handle(slot, std::forward<Args>(args)...);
+    }
+#endif
+
+#ifdef OxiMemPool_SharedHandles
+    /**
+     * Like emplace(), but returns a reference-counted PoolSharedHandle. The
+     * count lives in the pool's side array, so nothing is allocated besides
+     * the slot itself; the last handle destroys the object through the same
+     * path as PoolHandle. Exhaustion is reported as in emplace() (an empty
+     * handle when the error callback is set).
+     */
+    template <typename... Args>
+    OxiMemPool_ProfileInline PoolSharedHandle<T, Threading> emplace_shared(Args&&... args)
+    {
+        return PoolSharedHandle<T, Threading>(emplace(std::forward<Args>(args)...));
+    }
+#endif
+
+    /**
+     * Constructs an object without an owning handle, for arena-style use: it
+     * lives until destroy_unowned() or the next release_all(). Errors are
+     * reported as in emplace(); returns nullptr if an error callback handled
+     * exhaustion.
+     */
+    template <typename... Args>
+    OxiMemPool_ProfileInline T* emplace_unowned(Args&&... args)
+    {
+        PoolHandle<T, Threading> handle = emplace(std::forward<Args>(args)...);
+        T* object = handle.object_;
+        handle.pool_ = nullptr;
+        handle.object_ = nullptr;
+        return object;
+    }
+
+    // Destroys an object created by emplace_unowned() and frees its slot.
+    void destroy_unowned(T* object) noexcept
+    {
+        if (object)
+            destroy_object(object);
+    }
+
+    /**
+     * Constructs `count` objects of type T, each from copies of `args`, and
+     * writes their handles to `out`. Returns the advanced output iterator.
+     *
+     * All slots are reserved in one lock acquisition (one CAS for a run in
+     * lock-free mode) and used_count_ is updated once. A contiguous run from
+     * the untouched region of the pool is preferred, so a batch is usually
+     * adjacent in memory. Thread caches are bypassed.
+     *
+     * All or nothing with respect to capacity: if fewer than `count` slots are
+     * available nothing is allocated and exhaustion is reported as in emplace().
+     * If a constructor throws, handles already written to `out` stay valid,
+     * the remaining slots go back to the pool and the exception is propagated.
+     */
+    template <typename OutIt, typename... Args>
+    OxiMemPool_ProfileInline OutIt emplace_n(size_t count, OutIt out, const Args&... args)
+    {
+        if (count == 0)
+            return out;
+
+        BulkReservation r;
+        bool reserved = false;
+        {
+            std::lock_guard<ListMutex> g(mutex_);
+            reserved = reserve_bulk_no_lock(count, r);
+        }
+
+        if (!reserved) {
+#ifdef OxiMemPool_ErrCallback
+            if (err_callback_) {
+                trace(PoolEvent::Error, nullptr, 1, [&] {
+                    return "[Pool][ERROR] exhausted -> calling err_callback\n";
+                });
+                err_callback_("ObjectPool exhausted", 1);
+                return out;
+            }
+#endif
+            report_error("ObjectPool exhausted", 1);
+            return out;
+        }
+
+        add_used(count);
+
+        T* pending = nullptr; // reserved slot whose constructor is running
+        try {
+            while (r.size())
+            {
+                T* slot = take_reserved(r);
+                pending = slot;
+#ifdef OxiMemPool_Hardened
+                acquire_checked(slot);
+#endif
+                std::construct_at(slot, args...);
+                pending = nullptr;
+#ifdef OxiMemPool_Occupancy
+                set_occupied(slot, true);
+#endif
+#ifdef OxiMemPool_Profile
+                maybe_sample(slot);
+#endif
+
+                *out = PoolHandle<T, Threading>(*this, slot);
+                ++out;
+            }
+        }
+        catch (...) {
+            size_t unused = r.size();
+            {
+                std::lock_guard<ListMutex> g(mutex_);
+                if (pending)
+                {
+#ifdef OxiMemPool_Hardened
+                    poison_slot(pending); // acquire_checked() unpoisoned it
+#endif
+                    auto* node = reinterpret_cast<FreeSlot*>(pending);
+                    set_next(node, r.chain);
+                    r.chain = node;
+                    ++r.chain_count;
+                    ++unused;
+                }
+                release_reservation_no_lock(r);
+            }
+            sub_used(unused);
+#ifdef OxiMemPool_AsyncEmplace
+            notify_waiters();
+#endif
+            throw;
+        }
+
+        return out;
+    }
+
+    /**
+     * Destroys the objects owned by every handle in [first, last), resets the
+     * handles and returns all slots to the free-list in one splice (one lock
+     * acquisition, or one CAS in lock-free mode). Empty handles are skipped and
+     * handles owned by another pool are simply reset.
+     *
+     * Requirement: T::~T() must not re-enter this pool in an unsafe manner.
+     */
+    template <typename It>
+    void release_bulk(It first, It last) noexcept
+    {
+        FreeSlot* head = nullptr;
+        FreeSlot* tail = nullptr;
+        size_t count = 0;
+
+        for (; first != last; ++first)
+        {
+            PoolHandle<T, Threading>& h = *first;
+            if (!h.object_)
+                continue;
+            if (h.pool_ != this)
+            {
+                h.reset();
+                continue;
+            }
+
+#ifdef OxiMemPool_Hardened
+            release_checked(h.object_);
+#endif
+#ifdef OxiMemPool_Occupancy
+            set_occupied(h.object_, false);
+#endif
+#ifdef OxiMemPool_Profile
+            clear_sample(h.object_);
+#endif
+            std::destroy_at(h.object_);
+#ifdef OxiMemPool_WeakRefs
+            bump_generation(h.object_);
+#endif
+#ifdef OxiMemPool_Hardened
+            poison_slot(h.object_);
+#endif
+
+            auto* node = reinterpret_cast<FreeSlot*>(h.object_);
+            set_next(node, head);
+            head = node;
+            if (!tail)
+                tail = node;
+            ++count;
+
+            h.pool_ = nullptr;
+            h.object_ = nullptr;
+        }
+
+        if (count == 0)
+            return;
+
+        sub_used(count);
+
+        if constexpr (kOwnerThread)
+        {
+            if (!on_owner_thread())
+                push_remote(head, tail);
+            else
+                splice_no_lock(head, tail);
+        }
+        else
+        {
+            std::lock_guard<ListMutex> g(mutex_);
+            splice_no_lock(head, tail);
+        }
+
+        trace(PoolEvent::FreeBatch, nullptr, count, [&] {
+            return "[Pool][FREE][BULK] count=" + std::to_string(count) + "\n";
+        });
+#ifdef OxiMemPool_AsyncEmplace
+        notify_waiters();
+#endif
+    }
+
+    /**
+     * Raw slot access for allocator adapters (pool_resource.hpp). Returns
+     * uninitialized storage for one T taken like emplace() takes it (thread
+     * cache, free list, bump index, growth), or nullptr if the pool is
+     * exhausted; exhaustion is not reported as an error. The slot counts
+     * towards size() until it is given back with deallocate_storage(), and
+     * release_all() is rejected meanwhile.
+     */
+    T* try_allocate_storage()
+    {
+        T* slot = allocate_slot();
+        if (slot)
+        {
+#ifdef OxiMemPool_Hardened
+            acquire_checked(slot);
+#endif
+            add_storage(1);
+            add_used(1);
+        }
+        return slot;
+    }
+
+    // Returns storage from try_allocate_storage(); no destructor is run.
+    void deallocate_storage(T* slot) noexcept
+    {
+#ifdef OxiMemPool_Hardened
+        poison_slot(slot);
+#endif
+        add_storage(-1);
+        sub_used(1);
+        free_slot(slot);
+#ifdef OxiMemPool_AsyncEmplace
+        notify_waiters();
+#endif
+    }
+
+    // True if `p` points into a slot of this pool (initial block or a committed chunk).
+    bool owns(const void* p) const noexcept
+    {
+        const auto addr = reinterpret_cast<std::uintptr_t>(p);
+        if (addr - reinterpret_cast<std::uintptr_t>(pool_memory_) < kSlotSize * capacity_)
+            return true;
+
+        const size_t count = chunk_count_.load(std::memory_order_acquire);
+        for (size_t i = 0; i < count; ++i)
+        {
+            const auto chunk_base = reinterpret_cast<std::uintptr_t>(
+                chunks_[i].memory.load(std::memory_order_relaxed));
+            if (chunk_base != 0 && addr - chunk_base < kSlotSize * chunks_[i].slots)
+                return true;
+        }
+        return false;
+    }
+
+    /**
+     * Slot the next emplace() on the calling thread will most likely use: the
+     * top of its magazine, the head of the free list (the lowest free slot
+     * under ReusePolicy::LowestAddress) or the next untouched slot. nullptr if
+     * the pool would have to grow or is exhausted.
+     *
+     * Only a hint: in thread-safe pools another thread may take the slot first,
+     * an empty magazine is refilled before it is used, and OwnerThread pools
+     * may reclaim remote frees first. The slot holds no object and must not be
+     * accessed. Takes the lock in Mutex mode.
+     */
+    const void* peek_next_slot() noexcept
+    {
+#ifdef OxiMemPool_ThreadCache
+        if (kThreadCache && magazine_size_.load(std::memory_order_relaxed) != 0)
+        {
+            // Looks the magazine up without creating one.
+            for (const auto& entry : tls_cache().entries)
+            {
+                if (entry.anchor == cache_anchor_ && entry.magazine->count != 0)
+                    return entry.magazine->slots[entry.magazine->count - 1];
+            }
+        }
+#endif
+        if constexpr (kLockFree)
+        {
+            const std::uint64_t head = free_head_.load(std::memory_order_acquire);
+            if (head & kIndexMask)
+                return slot_at(static_cast<size_t>((head & kIndexMask) - 1));
+            const size_t bump = max_allocated_index_.load(std::memory_order_relaxed);
+            return bump < index_end_.load(std::memory_order_acquire) ? slot_address(bump) : nullptr;
+        }
+        else
+        {
+            std::lock_guard<ListMutex> g(mutex_);
+            if constexpr (kLowestAddress)
+            {
+                const size_t blocks = chunk_count_.load(std::memory_order_relaxed) + 1;
+                for (size_t block = free_block_hint_; block < blocks; ++block)
+                {
+                    const size_t local = block_bits(block).lowest();
+                    if (local != FreeBitmap::npos)
+                        return slot_address(block_first(block) + local);
+                }
+            }
+            else if (free_head_)
+            {
+                return free_head_;
+            }
+            if constexpr (kOwnerThread)
+            {
+                if (FreeSlot* remote = remote_head_.load(std::memory_order_acquire))
+                    return remote;
+            }
+            const size_t bump = max_allocated_index_;
+            return bump < index_end_.load(std::memory_order_relaxed) ? slot_address(bump) : nullptr;
+        }
+    }
+
+    /**
+     * Prefetches the slot of peek_next_slot(), so that a pipeline can warm the
+     * slot of its next emplace() while it still works on the current item.
+     */
+    void prefetch_next_slot() noexcept
+    {
+        if (const void* slot = peek_next_slot())
+            pool_prefetch(slot);
+    }
+
+    /**
+     * Current number of live objects.
+     *
+     * Exact for SingleThread pools and whenever no other thread allocates or
+     * frees concurrently. Otherwise it is a snapshot: with a single counter
+     * (the default) it is the exact count at some instant during the call;
+     * with OxiMemPool_ShardedCount the shards are read one after another, so
+     * the sum may mix instants and is clamped to [0, max_capacity()]. Both
+     * are exact again once the pool is quiescent.
+     */
+    size_t size() const noexcept
+    {
+        if constexpr (kSingleThread)
+        {
+            return used_count_;
+        }
+        else if constexpr (kShardedCount)
+        {
+            size_t sum = 0;
+            for (const CountShard& shard : count_shards_.shards)
+                sum += shard.delta.load(std::memory_order_relaxed);
+            // Modular sum: a free read before the allocation it follows can
+            // leave it (transiently) below zero.
+            if (static_cast<std::ptrdiff_t>(sum) < 0)
+                return 0;
+            return sum < max_capacity_ ? sum : max_capacity_;
+        }
+        else
+        {
+            return used_count_.load(std::memory_order_acquire);
+        }
+    }
+
+    // Number of slots currently backed by memory (initial block plus chunks)
+    size_t capacity() const noexcept { return committed_slots_.load(std::memory_order_relaxed); }
+
+    // Upper bound capacity() may grow to; equals capacity() for fixed pools
+    size_t max_capacity() const noexcept { return max_capacity_; }
+
+#ifdef OxiMemPool_Stats
+    /**
+     * Returns a snapshot of the pool counters. Shards are read with relaxed
+     * loads, so under concurrent use the fields are individually (not
+     * mutually) consistent.
+     */
+    PoolStats stats() const noexcept
+    {
+        std::uint64_t totals[kStatCount] = {};
+        for (const StatShard& shard : stat_shards_)
+        {
+            for (size_t i = 0; i < kStatCount; ++i)
+                totals[i] += shard.counters[i].load(std::memory_order_relaxed);
+        }
+
+        PoolStats st;
+        st.live = size();
+        st.capacity = capacity();
+        if constexpr (kSingleThread)
+        {
+            st.peak_live = peak_live_;
+            st.touched_slots = max_allocated_index_;
+        }
+        else if constexpr (kMutex)
+        {
+            st.peak_live = peak_live_.load(std::memory_order_relaxed);
+            std::lock_guard<ListMutex> g(mutex_);
+            st.touched_slots = max_allocated_index_;
+        }
+        else if constexpr (kOwnerThread)
+        {
+            st.peak_live = peak_live_.load(std::memory_order_relaxed);
+            st.touched_slots = max_allocated_index_; // written by the owner only
+        }
+        else
+        {
+            st.peak_live = peak_live_.load(std::memory_order_relaxed);
+            // The bump index may overshoot the end of the index space.
+            const size_t bump = max_allocated_index_.load(std::memory_order_relaxed);
+            const size_t end = index_end_.load(std::memory_order_relaxed);
+            st.touched_slots = bump < end ? bump : end;
+        }
+        if constexpr (kShardedCount)
+        {
+            // Sum of the shard highs: never below the real peak, but above it
+            // when the shards peaked at different times or objects are freed
+            // by other threads than the ones that created them.
+            size_t peak = 0;
+            for (const CountShard& shard : count_shards_.shards)
+            {
+                const size_t high = shard.peak.load(std::memory_order_relaxed);
+                if (static_cast<std::ptrdiff_t>(high) > 0)
+                    peak += high;
+            }
+            peak = peak < max_capacity_ ? peak : max_capacity_;
+            st.peak_live = peak > st.live ? peak : st.live;
+        }
+        st.fresh_allocs = totals[kFresh];
+        st.reused_allocs = totals[kReused];
+        st.frees = totals[kFrees];
+        st.exhausted = totals[kExhausted];
+        st.grows = totals[kGrows];
+        st.shrinks = totals[kShrinks];
+        if constexpr (kMutex)
+        {
+            st.lock_contended = mutex_.contended.load(std::memory_order_relaxed);
+            st.lock_wait_ns = mutex_.wait_ns.load(std::memory_order_relaxed);
+        }
+        return st;
+    }
+#endif
+
+#ifdef OxiMemPool_Profile
+    /**
+     * Sets the mean number of allocations between two samples of the
+     * allocation profiler (OxiMemPool_ProfileInterval by default): objects
+     * created by emplace(), try_emplace(), emplace_unowned(), emplace_n() and
+     * the other emplace variants are sampled with probability 1 / interval, and
+     * a sampled object records its call site and creation time until it is
+     * destroyed. 1 samples every object; 0 stops sampling, while existing
+     * samples stay until their objects die. The countdown to the next sample
+     * is kept per thread and shared by the pools of one type.
+     */
+    void set_profile_interval(size_t interval) noexcept
+    {
+        constexpr size_t kMax = std::numeric_limits<size_t>::max() / 2;
+        profile_interval_.store(interval < kMax ? interval : kMax, std::memory_order_relaxed);
+    }
+
+    size_t profile_interval() const noexcept
+    {
+        return profile_interval_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Aggregates the sampled live objects by call site, the site with the
+     * most samples first. estimated_live scales the samples by the current
+     * interval. O(touched slots); other threads may create and destroy
+     * objects meanwhile, which may or may not be counted. OwnerThread pools:
+     * owner thread only.
+     */
+    std::vector<PoolAllocationSite> live_allocation_sites() const
+    {
+        const size_t end = touched_end();
+        const std::uint64_t now = profile_now_ns();
+
+        std::vector<std::pair<const void*, std::uint64_t>> live; // site, age
+        for (size_t idx = 0; idx < end;)
+        {
+            const size_t block_last = block_end(idx) < end ? block_end(idx) : end;
+            const AllocationSample* samples = &sample_at(idx);
+            for (size_t i = 0; i < block_last - idx; ++i)
+            {
+                const void* site = samples[i].site.load(std::memory_order_acquire);
+                if (site == nullptr)
+                    continue;
+                const std::uint64_t time = samples[i].time_ns.load(std::memory_order_relaxed);
+                live.emplace_back(site, now > time ? now - time : 0);
+            }
+            idx = block_last;
+        }
+        std::sort(live.begin(), live.end(), [](const auto& a, const auto& b) {
+            return std::less<const void*>{}(a.first, b.first);
+        });
+
+        const size_t interval = profile_interval();
+        std::vector<PoolAllocationSite> sites;
+        for (const auto& [site, age] : live)
+        {
+            if (sites.empty() || sites.back().site != site)
+            {
+                sites.emplace_back();
+                sites.back().site = site;
+            }
+            PoolAllocationSite& entry = sites.back();
+            ++entry.sampled;
+            entry.estimated_live += interval ? interval : 1;
+            entry.oldest_ns = age > entry.oldest_ns ? age : entry.oldest_ns;
+
+            size_t bucket = 0;
+            for (std::uint64_t limit = 1'000'000; bucket + 1 < kPoolProfileAgeBuckets && age >= limit; limit *= 10)
+                ++bucket;
+            ++entry.age_histogram[bucket];
+        }
+        std::stable_sort(sites.begin(), sites.end(), [](const PoolAllocationSite& a, const PoolAllocationSite& b) {
+            return a.sampled > b.sampled;
+        });
+        return sites;
+    }
+
+    /**
+     * live_allocation_sites() as a text report, one line per call site:
+     *
+     *     [Pool][PROFILE] live=10240 sampled=10 interval=1024 sites=2
+     *         ~live sampled   <1ms  <10ms <100ms    <1s   <10s  <100s >=100s  oldest_ms  site
+     *          8192       8      0      0      0      2      6      0      0       8210  0x55d4c3a2f1e7 /srv/app+0x2f1e6 (_Z10make_orderv)
+     *
+     * On POSIX systems the site is followed by its module and the offset of
+     * the call instruction within it (for addr2line -f -C -i -e module offset) and the
+     * enclosing symbol when it is exported; glibc before 2.34 needs -ldl.
+     */
+    std::string dump_live_allocations() const
+    {
+        const std::vector<PoolAllocationSite> sites = live_allocation_sites();
+        size_t sampled = 0;
+        for (const PoolAllocationSite& site : sites)
+            sampled += site.sampled;
+
+        std::string out = "[Pool][PROFILE] live=" + std::to_string(size()) +
+                          " sampled=" + std::to_string(sampled) +
+                          " interval=" + std::to_string(profile_interval()) +
+                          " sites=" + std::to_string(sites.size()) + "\n";
+        out += "    ~live sampled   <1ms  <10ms <100ms    <1s   <10s  <100s >=100s  oldest_ms  site\n";
+        for (const PoolAllocationSite& site : sites)
+        {
+            char line[160];
+            const size_t* h = site.age_histogram;
+            std::snprintf(line, sizeof(line), "%9zu %7zu %6zu %6zu %6zu %6zu %6zu %6zu %6zu %10llu  ",
+                          site.estimated_live, site.sampled, h[0], h[1], h[2], h[3], h[4], h[5], h[6],
+                          static_cast<unsigned long long>(site.oldest_ns / 1'000'000));
+            out += line;
+            out += describe_site(site.site);
+            out += "\n";
+        }
+        return out;
+    }
+
+private:
+    // Address of a call site, with module+offset and symbol where available.
+    static std::string describe_site(const void* site)
+    {
+        char text[64];
+        std::snprintf(text, sizeof(text), "%p", site);
+        std::string out = text;
+#if defined(__unix__) || defined(__APPLE__)
+        Dl_info info{};
+        if (::dladdr(site, &info) != 0 && info.dli_fname != nullptr)
+        {
+            // The return address follows the call; one byte back is inside it.
+            const auto offset = reinterpret_cast<std::uintptr_t>(site) - 1 -
+                                reinterpret_cast<std::uintptr_t>(info.dli_fbase);
+            std::snprintf(text, sizeof(text), "+0x%llx", static_cast<unsigned long long>(offset));
+            out += std::string(" ") + info.dli_fname + text;
+            if (info.dli_sname != nullptr)
+                out += std::string(" (") + info.dli_sname + ")";
+        }
+#endif
+        return out;
+    }
+
+public:
+#endif
+
+    /**
+     * Releases every additional chunk whose slots are all free back to the OS
+     * and returns the number of slots released. The initial block is kept.
+     * Slots held in thread caches count as used. Live objects never move.
+     *
+     * O(free slots + chunks). In lock-free mode this must not run concurrently
+     * with any other operation on the pool.
+     */
+    size_t shrink_to_fit()
+    {
+        std::lock_guard<ListMutex> g(mutex_);
+        std::lock_guard<GrowthMutex> growth_guard(growth_mutex_);
+        return shrink_no_lock();
+    }
+
+private:
+    // shrink_to_fit() with both pool locks held.
+    size_t shrink_no_lock()
+    {
+        size_t count = chunk_count_.load(std::memory_order_relaxed);
+        if (count == 0)
+            return 0;
+
+        if constexpr (kOwnerThread)
+            reclaim_remote_no_lock();
+
+        size_t bump = max_allocated_index_;
+
+        // Free slots per chunk: free-list entries plus the untouched bump tail.
+        std::vector<size_t> free_in(count, 0);
+        for_each_free_slot_no_lock([&](FreeSlot* node) {
+            const size_t idx = slot_index(node);
+            if (idx >= capacity_)
+                ++free_in[chunk_of_index(idx)];
+        });
+
+        std::vector<bool> release(count, false);
+        bool any = false;
+        for (size_t i = 0; i < count; ++i)
+        {
+            const Chunk& chunk = chunks_[i];
+            const size_t end = chunk.first_index + chunk.slots;
+            const size_t untouched = bump >= end ? 0
+                                   : end - (bump > chunk.first_index ? bump : chunk.first_index);
+            release[i] = chunk.memory.load(std::memory_order_relaxed) != nullptr &&
+                         free_in[i] + untouched == chunk.slots;
+            any = any || release[i];
+        }
+
+        if (!any)
+            return 0;
+
+        // Unlink every slot of a released chunk, keeping the order of the rest.
+        rebuild_free_list_no_lock([&](FreeSlot* node) {
+            const size_t idx = slot_index(node);
+            return idx < capacity_ || !release[chunk_of_index(idx)];
+        });
+
+        size_t released = 0;
+        auto release_memory = [&](Chunk& chunk) {
+            if (std::byte* memory = chunk.memory.load(std::memory_order_relaxed))
+            {
+                release_block(memory, chunk.slots);
+                chunk.memory.store(nullptr, std::memory_order_relaxed);
+                released += chunk.slots;
+            }
+        };
+
+        // Trailing chunks (and holes left by earlier shrinks) leave the index space.
+        while (count > 0 && (release[count - 1] ||
+                             chunks_[count - 1].memory.load(std::memory_order_relaxed) == nullptr))
+        {
+            Chunk& chunk = chunks_[count - 1];
+            release_memory(chunk);
+            if (bump > chunk.first_index)
+                bump = chunk.first_index;
+            --count;
+        }
+
+        // Chunks in the middle keep their index range and are re-committed first.
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (release[i])
+                release_memory(chunks_[i]);
+        }
+
+        max_allocated_index_ = bump;
+        chunk_count_.store(count, std::memory_order_release);
+        index_end_.store(count == 0 ? capacity_ : chunks_[count - 1].first_index + chunks_[count - 1].slots,
+                         std::memory_order_release);
+        committed_slots_.fetch_sub(released, std::memory_order_relaxed);
+
+        trace(PoolEvent::Shrink, nullptr, released, [&] {
+            return "[Pool][SHRINK] released=" + std::to_string(released) + "\n";
+        });
+
+        return released;
+    }
+
+    // Gives the whole pages inside [begin, end) back to the OS; their contents
+    // read as zero (or stale) afterwards and are faulted in again on first use.
+    static void discard_pages(std::byte* begin, std::byte* end) noexcept
+    {
+#if defined(__unix__) || defined(__APPLE__)
+        const long page_size = sysconf(_SC_PAGESIZE);
+        if (page_size <= 0)
+            return;
+        const auto page = static_cast<std::uintptr_t>(page_size);
+        const std::uintptr_t first = (reinterpret_cast<std::uintptr_t>(begin) + page - 1) / page * page;
+        const std::uintptr_t last = reinterpret_cast<std::uintptr_t>(end) / page * page;
+        if (first < last)
+            madvise(reinterpret_cast<void*>(first), last - first, MADV_DONTNEED);
+#else
+        (void)begin;
+        (void)end;
+#endif
+    }
+
+public:
+    /**
+     * Defragments the pool: the objects referenced by [first, last) are moved
+     * into the lowest free slots, the references are patched, and memory past
+     * the last live object is released (free growth chunks as in
+     * shrink_to_fit(), whole pages of the rest of the block with
+     * madvise(MADV_DONTNEED)). Later allocations continue in address order
+     * right after the compacted objects. Returns the number of objects moved.
+     *
+     * The range holds PoolHandles of this pool or T* to objects of this pool
+     * (e.g. from emplace_unowned()); anything else is skipped. Live objects
+     * that are not referenced by the range stay where they are, so a partial
+     * range compacts around them. Every other pointer to a moved object
+     * becomes dangling, and weak references to it expire. Slots held in
+     * thread caches are reclaimed.
+     *
+     * Objects are relocated by move construction followed by destruction of
+     * the source. Must not run concurrently with any other operation on the
+     * pool. May throw std::bad_alloc (before anything is moved).
+     */
+    template <typename It>
+        requires std::is_nothrow_move_constructible_v<T>
+    size_t compact(It first, It last)
+    {
+        using Ref = std::remove_cvref_t<decltype(*first)>;
+        static_assert(std::is_same_v<Ref, PoolHandle<T, Threading>> || std::is_same_v<Ref, T*>,
+                      "compact() expects a range of PoolHandle<T> or T*");
+
+#ifdef OxiMemPool_ThreadCache
+        std::unique_lock<std::mutex> anchor_guard;
+        if constexpr (kThreadCache)
+            anchor_guard = std::unique_lock<std::mutex>(cache_anchor_->mutex);
+#endif
+        std::lock_guard<ListMutex> g(mutex_);
+        std::lock_guard<GrowthMutex> growth_guard(growth_mutex_);
+        if constexpr (kOwnerThread)
+            reclaim_remote_no_lock();
+
+        const size_t end = index_end_.load(std::memory_order_relaxed);
+        const size_t touched = max_allocated_index_; // may overshoot end in lock-free mode
+        const size_t bump = touched < end ? touched : end;
+
+        // Slot states below the bump index; the free ones are found by marking.
+        enum : std::uint8_t { kUsed, kFree, kGone };
+        std::vector<std::uint8_t> state(bump, kUsed);
+        for_each_free_slot_no_lock([&](FreeSlot* node) { state[slot_index(node)] = kFree; });
+#ifdef OxiMemPool_ThreadCache
+        if constexpr (kThreadCache)
+        {
+            for (const Magazine* mag : cache_anchor_->magazines)
+                for (size_t i = 0; i < mag->count; ++i)
+                    state[slot_index(mag->slots[i])] = kFree;
+        }
+#endif
+        for (size_t i = 0; i < chunk_count_.load(std::memory_order_relaxed); ++i)
+        {
+            const Chunk& chunk = chunks_[i];
+            if (chunk.memory.load(std::memory_order_relaxed) != nullptr)
+                continue;
+            for (size_t idx = chunk.first_index; idx < chunk.first_index + chunk.slots && idx < bump; ++idx)
+                state[idx] = kGone; // released by shrink_to_fit()
+        }
+
+        // Objects to move, highest slot first.
+        std::vector<std::pair<size_t, Ref*>> movable;
+        for (; first != last; ++first)
+        {
+            Ref& ref = *first;
+            T* object = nullptr;
+            if constexpr (std::is_same_v<Ref, T*>)
+                object = owns(ref) ? ref : nullptr;
+            else
+                object = ref.pool_ == this ? ref.object_ : nullptr;
+            if (object)
+                movable.emplace_back(slot_index(object), &ref);
+        }
+        std::sort(movable.begin(), movable.end(),
+                  [](const auto& a, const auto& b) { return a.first > b.first; });
+
+#ifdef OxiMemPool_ThreadCache
+        if constexpr (kThreadCache)
+        {
+            for (Magazine* mag : cache_anchor_->magazines)
+                mag->count = 0;
+        }
+#endif
+
+        size_t moved = 0;
+        size_t hole = 0;
+        for (const auto& [source, ref] : movable)
+        {
+            while (hole < source && state[hole] != kFree)
+                ++hole;
+            if (hole >= source)
+                break;
+
+            T* from = std::launder(reinterpret_cast<T*>(slot_address(source)));
+            T* to = reinterpret_cast<T*>(slot_address(hole));
+#ifdef OxiMemPool_Hardened
+            release_checked(from);
+            acquire_checked(to);
+#endif
+#ifdef OxiMemPool_Occupancy
+            set_occupied(from, false);
+#endif
+            std::construct_at(to, std::move(*from));
+            std::destroy_at(from);
+#ifdef OxiMemPool_WeakRefs
+            bump_generation(from);
+#endif
+#ifdef OxiMemPool_Hardened
+            poison_slot(from);
+#endif
+#ifdef OxiMemPool_Occupancy
+            set_occupied(to, true);
+#endif
+#ifdef OxiMemPool_Profile
+            move_sample(from, to);
+#endif
+            if constexpr (std::is_same_v<Ref, T*>)
+                *ref = to;
+            else
+                ref->object_ = to;
+
+            state[hole] = kUsed;
+            state[source] = kFree;
+            ++moved;
+        }
+
+        // Everything above the last used slot goes back to the bump region;
+        // the free slots below it are queued in address order.
+        size_t new_bump = bump;
+        while (new_bump > 0 && state[new_bump - 1] != kUsed)
+            --new_bump;
+
+        clear_free_list_no_lock();
+        for (size_t idx = new_bump; idx-- > 0;)
+        {
+            if (state[idx] == kFree)
+                push_chunk_no_lock(slot_address(idx), idx, 1);
+        }
+        max_allocated_index_ = new_bump;
+
+        shrink_no_lock();
+
+        // Pages of the block holding the new bump index that no slot below it uses.
+        if (new_bump < capacity_)
+            discard_pages(pool_memory_ + kSlotSize * new_bump, pool_memory_ + kSlotSize * capacity_);
+        else if (new_bump < index_end_.load(std::memory_order_relaxed))
+        {
+            const Chunk& chunk = chunks_[chunk_of_index(new_bump)];
+            if (std::byte* memory = chunk.memory.load(std::memory_order_relaxed))
+                discard_pages(memory + kSlotSize * (new_bump - chunk.first_index),
+                              memory + kSlotSize * chunk.slots);
+        }
+
+        trace(PoolEvent::Compact, nullptr, moved, [&] {
+            return "[Pool][COMPACT] moved=" + std::to_string(moved) +
+                   " touched=" + std::to_string(new_bump) + "\n";
+        });
+
+        return moved;
+    }
+
+    /**
+     * Arena-style reset: destroys every live object and returns the pool to
+     * its freshly constructed state, so that later allocations are handed out
+     * in sequential bump order again. Returns the number of objects released.
+     *
+     * The destructor loop is skipped entirely when T is trivially
+     * destructible (and weak references are disabled); otherwise live slots
+     * are found by marking the free list, O(touched slots), or from the
+     * occupancy bitmap when OxiMemPool_Occupancy is enabled. Slots cached by
+     * any thread are reclaimed. Committed growth chunks are kept; if
+     * shrink_to_fit() left a hole in the index space, the touched slots are
+     * queued on the free list in address order instead of the bump region.
+     *
+     * Every object must be unowned (emplace_unowned()) or its handle must not
+     * be used or destroyed afterwards. Must not run concurrently with any
+     * other operation on the pool. May throw std::bad_alloc (before anything
+     * is destroyed) when the destructor loop needs its scratch bitmap.
+     *
+     * Raw storage from try_allocate_storage() (pool_resource.hpp) holds no
+     * T, so while any of it is outstanding the call is reported as an error
+     * (code 10) and releases nothing.
+     */
+    size_t release_all()
+    {
+        if (storage_in_use() != 0)
+        {
+            report_error("ObjectPool raw storage in use, cannot release_all()", 10);
+            return 0;
+        }
+
+        const size_t live = release_all_locked();
+#ifdef OxiMemPool_AsyncEmplace
+        notify_waiters(); // after the pool locks are released
+#endif
+        return live;
+    }
+
+    /**
+     * Allocation state of a fixed pool over a caller-supplied buffer (see
+     * PoolImageState): with the buffer bytes it is enough to restore the pool
+     * with ObjectPool(buffer, state), in this process or another one. Slots
+     * cached by any thread and remote frees are returned to the free list
+     * first. Must not run concurrently with any other operation on the pool.
+     */
+    PoolImageState image_state() noexcept
+        requires supports_image
+    {
+#ifdef OxiMemPool_ThreadCache
+        if constexpr (kThreadCache)
+        {
+            std::lock_guard<std::mutex> anchor_guard(cache_anchor_->mutex);
+            for (Magazine* mag : cache_anchor_->magazines)
+                return_magazine_slots(*mag, mag->count);
+        }
+#endif
+        std::lock_guard<ListMutex> g(mutex_);
+        if constexpr (kOwnerThread)
+            reclaim_remote_no_lock();
+
+        PoolImageState state;
+        if constexpr (kLockFree)
+        {
+            const size_t bump = max_allocated_index_.load(std::memory_order_relaxed);
+            state.bump = bump < capacity_ ? bump : capacity_; // fetch_add may overshoot
+            state.free_head = free_head_.load(std::memory_order_acquire) & kIndexMask;
+        }
+        else
+        {
+            state.bump = max_allocated_index_;
+            state.free_head = free_head_ ? slot_index(free_head_) + 1 : 0;
+        }
+        state.live = size();
+        return state;
+    }
+
+    /**
+     * image_state() for a pool that is about to be destroyed while its
+     * objects live on in the buffer: the pool forgets them, so destroying it
+     * neither runs destructors (T is trivially copyable) nor asserts. The pool
+     * must not be used afterwards except to be destroyed.
+     */
+    PoolImageState detach_image() noexcept
+        requires supports_image
+    {
+        const PoolImageState state = image_state();
+        sub_used(static_cast<size_t>(state.live));
+        return state;
+    }
+
+private:
+    size_t release_all_locked()
+    {
+#ifdef OxiMemPool_ThreadCache
+        // Same lock order as a thread exit: anchor, then the pool lock.
+        std::unique_lock<std::mutex> anchor_guard;
+        if constexpr (kThreadCache)
+            anchor_guard = std::unique_lock<std::mutex>(cache_anchor_->mutex);
+#endif
+        std::lock_guard<ListMutex> g(mutex_);
+        std::lock_guard<GrowthMutex> growth_guard(growth_mutex_);
+        if constexpr (kOwnerThread)
+            reclaim_remote_no_lock(); // those slots must not be destroyed again
+
+        const size_t live = size();
+        const size_t end = index_end_.load(std::memory_order_relaxed);
+        const size_t touched = max_allocated_index_; // may overshoot end in lock-free mode
+        const size_t bump = touched < end ? touched : end;
+
+#ifdef OxiMemPool_WeakRefs
+        constexpr bool kDestroyLoop = true;
+#else
+        constexpr bool kDestroyLoop = !std::is_trivially_destructible_v<T>;
+#endif
+        if constexpr (kDestroyLoop)
+        {
+            if (live != 0)
+            {
+#ifdef OxiMemPool_Occupancy
+                auto destroy = [this](T* object) {
+                    std::destroy_at(object);
+#ifdef OxiMemPool_WeakRefs
+                    bump_generation(object);
+#else
+                    (void)this;
+#endif
+                };
+                for_each_live_in(0, bump, destroy);
+#else
+                std::vector<bool> is_free(bump, false);
+                for_each_free_slot_no_lock([&](FreeSlot* node) { is_free[slot_index(node)] = true; });
+#ifdef OxiMemPool_ThreadCache
+                if constexpr (kThreadCache)
+                {
+                    for (const Magazine* mag : cache_anchor_->magazines)
+                        for (size_t i = 0; i < mag->count; ++i)
+                            is_free[slot_index(mag->slots[i])] = true;
+                }
+#endif
+                for (size_t idx = 0; idx < bump;)
+                {
+                    const size_t stop = block_end(idx) < bump ? block_end(idx) : bump;
+                    if (idx >= capacity_ &&
+                        chunks_[chunk_of_index(idx)].memory.load(std::memory_order_relaxed) == nullptr)
+                    {
+                        idx = stop; // released by shrink_to_fit(), holds no objects
+                        continue;
+                    }
+                    for (; idx < stop; ++idx)
+                    {
+                        if (is_free[idx])
+                            continue;
+                        T* object = std::launder(reinterpret_cast<T*>(slot_address(idx)));
+                        std::destroy_at(object);
+#ifdef OxiMemPool_WeakRefs
+                        bump_generation(object);
+#endif
+                    }
+                }
+#endif
+            }
+        }
+#ifdef OxiMemPool_Occupancy
+        clear_occupancy_no_lock(bump);
+#endif
+#ifdef OxiMemPool_Profile
+        clear_samples_no_lock(bump);
+#endif
+
+#ifdef OxiMemPool_ThreadCache
+        if constexpr (kThreadCache)
+        {
+            for (Magazine* mag : cache_anchor_->magazines)
+                mag->count = 0;
+        }
+#endif
+
+        clear_free_list_no_lock();
+
+        // Holes left by shrink_to_fit() always lie below the bump index, which
+        // must not run into them: in that case the bump index is kept and the
+        // touched slots are queued on the free list in address order instead.
+        const size_t count = chunk_count_.load(std::memory_order_relaxed);
+        bool has_hole = false;
+        for (size_t i = 0; i < count && !has_hole; ++i)
+            has_hole = chunks_[i].first_index < bump &&
+                       chunks_[i].memory.load(std::memory_order_relaxed) == nullptr;
+
+        if (!has_hole)
+        {
+            max_allocated_index_ = 0;
+        }
+        else
+        {
+            for (size_t i = count; i-- > 0;)
+            {
+                const Chunk& chunk = chunks_[i];
+                std::byte* memory = chunk.memory.load(std::memory_order_relaxed);
+                if (memory && chunk.first_index < bump)
+                    push_chunk_no_lock(memory, chunk.first_index,
+                                       bump - chunk.first_index < chunk.slots ? bump - chunk.first_index
+                                                                              : chunk.slots);
+            }
+            push_chunk_no_lock(pool_memory_, 0, bump < capacity_ ? bump : capacity_);
+        }
+
+        sub_used(live);
+
+        trace(PoolEvent::Reset, nullptr, live, [&] {
+            return "[Pool][RESET] released=" + std::to_string(live) + "\n";
+        });
+
+        return live;
+    }
+
+public:
+#ifdef OxiMemPool_Occupancy
+    /**
+     * Calls fn(T&) for every live object in address order: the initial block
+     * first, then the growth chunks. Free slots are skipped a 64-slot bitmap
+     * word at a time, so the walk is a linear sweep over the slots that hold
+     * objects. Objects from emplace(), emplace_n() and emplace_unowned() are
+     * visited; raw storage from try_allocate_storage() is not.
+     *
+     * fn must not create or destroy objects of this pool. In thread-safe
+     * modes other threads may do so meanwhile: objects created or destroyed
+     * during the walk may or may not be visited, and an object must not be
+     * destroyed while fn runs on it.
+     */
+    template <typename Fn>
+    void for_each(Fn&& fn)
+    {
+        auto visit = [&fn](T* object) { fn(*object); };
+        for_each_live_in(0, touched_end(), visit);
+    }
+
+    template <typename Fn>
+    void for_each(Fn&& fn) const
+    {
+        auto visit = [&fn](const T* object) { fn(*object); };
+        for_each_live_in(0, touched_end(), visit);
+    }
+
+    /**
+     * for_each() split into `tasks` ranges of whole bitmap words (by default
+     * one per 16384 slots). The calling thread runs the first range itself;
+     * every other range is passed as a nullary callable to executor(task),
+     * which must run it exactly once on some thread (e.g. submit it to a
+     * thread pool). Returns after all ranges have finished, so fn is called
+     * concurrently for distinct objects only. If fn throws, the remaining
+     * objects of that range are skipped and the first exception is rethrown
+     * once every range is done. The rules of for_each() apply.
+     */
+    template <typename Fn, typename Executor>
+    void parallel_for_each(Fn&& fn, Executor&& executor, size_t tasks = 0)
+    {
+        constexpr size_t kDefaultRange = 16384;
+
+        const size_t end = touched_end();
+        const size_t words = occupancy_words(end);
+        if (words == 0)
+            return;
+        if (tasks == 0)
+            tasks = (end + kDefaultRange - 1) / kDefaultRange;
+        if (tasks > words)
+            tasks = words;
+
+        std::latch done(static_cast<std::ptrdiff_t>(tasks));
+        std::mutex error_mutex;
+        std::exception_ptr error;
+
+        // Ranges are cut at word boundaries of the global index space; a range
+        // crossing a block boundary simply continues in the next block.
+        auto run = [&, end, words, tasks](size_t task) noexcept {
+            const size_t first = words * task / tasks * 64;
+            const size_t next = words * (task + 1) / tasks * 64;
+            try {
+                auto visit = [&fn](T* object) { fn(*object); };
+                for_each_live_in(first, next < end ? next : end, visit);
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> g(error_mutex);
+                if (!error)
+                    error = std::current_exception();
+            }
+            done.count_down();
+        };
+
+        for (size_t task = 1; task < tasks; ++task)
+        {
+            try {
+                executor([&run, task] { run(task); });
+            }
+            catch (...) {
+                // Ranges that were never submitted run here.
+                {
+                    std::lock_guard<std::mutex> g(error_mutex);
+                    if (!error)
+                        error = std::current_exception();
+                }
+                for (; task < tasks; ++task)
+                    run(task);
+                break;
+            }
+        }
+        run(0);
+        done.wait();
+
+        if (error)
+            std::rethrow_exception(error);
+    }
 #endif
 
-        if (!slot) {
-#ifdef OxiMemPool_ErrCallback
-            // If an error callback is set, invoke it and return an empty handle
-            if (err_callback_) {
-                if (log_function_)
-                    log_function_("[Pool][ERROR] exhausted -> calling err_callback\n");
-                err_callback_("ObjectPool exhausted", 1);
-                return PoolHandle<T>{};
+    /**
+     * Pre-faults the memory of up to `slots` slots of the untouched region, so
+     * that their first use inside emplace() does not take a page fault. Call it
+     * once at startup; only committed memory is touched (a growable pool does
+     * not grow). With `thread_free_list` the warmed slots are also linked onto
+     * the free list in address order. Returns the number of slots warmed.
+     *
+     * In lock-free mode this must not run concurrently with any other
+     * operation on the pool.
+     */
+    size_t warm(size_t slots = std::numeric_limits<size_t>::max(), bool thread_free_list = false)
+    {
+        std::lock_guard<ListMutex> g(mutex_);
+        std::lock_guard<GrowthMutex> growth_guard(growth_mutex_);
+
+        const size_t end = index_end_.load(std::memory_order_relaxed);
+        const size_t bump = max_allocated_index_;
+        if (bump >= end || slots == 0)
+            return 0;
+
+        const size_t stop = end - bump < slots ? end : bump + slots;
+
+        // The untouched region is always backed: shrink_to_fit() only
+        // releases chunks below the bump index or drops them entirely.
+        for (size_t idx = bump; idx < stop;)
+        {
+            const size_t piece_end = block_end(idx) < stop ? block_end(idx) : stop;
+            touch_memory(slot_address(idx), kSlotSize * (piece_end - idx));
+            idx = piece_end;
+        }
+
+        if (thread_free_list)
+        {
+            // Highest block first, so the lowest address ends up on top.
+            for (size_t hi = stop; hi > bump;)
+            {
+                const size_t lo = block_begin(hi - 1) > bump ? block_begin(hi - 1) : bump;
+                push_chunk_no_lock(slot_address(lo), lo, hi - lo);
+                hi = lo;
             }
+            max_allocated_index_ = stop;
+        }
+
+        const size_t warmed = stop - bump;
+        trace(PoolEvent::Warm, nullptr, warmed, [&] {
+            return "[Pool][WARM] slots=" + std::to_string(warmed) +
+                   (thread_free_list ? " threaded\n" : "\n");
+        });
+        return warmed;
+    }
+
+#ifdef OxiMemPool_ThreadCache
+    /**
+     * Sets how many free slots each thread may cache for this pool
+     * (clamped to kMaxMagazineSize, 0 disables the thread cache).
+     * Magazines exchange half of this amount with the shared list per batch.
+     * Slots cached by one thread are invisible to the others, so emplace() may
+     * report exhaustion while up to threads * size slots sit in magazines.
+     * SingleThread pools never use magazines.
+     */
+    void set_magazine_size(size_t size) noexcept
+    {
+        magazine_size_.store(size < kMaxMagazineSize ? size : kMaxMagazineSize,
+                             std::memory_order_relaxed);
+    }
+
+    size_t magazine_size() const noexcept { return magazine_size_.load(std::memory_order_relaxed); }
+
+    /**
+     * Returns every slot cached by the calling thread back to the shared list.
+     * Runs automatically when a thread exits; call it explicitly before a
+     * long-lived thread stops using the pool or before changing magazine_size().
+     */
+    void drain_thread_cache() noexcept
+    {
+        auto& entries = tls_cache().entries;
+        for (auto it = entries.begin(); it != entries.end(); ++it)
+        {
+            if (it->anchor == cache_anchor_)
+            {
+                flush_magazine(*it->magazine, it->magazine->count);
+                {
+                    std::lock_guard<std::mutex> g(cache_anchor_->mutex);
+                    std::erase(cache_anchor_->magazines, it->magazine.get());
+                }
+                entries.erase(it);
+                return;
+            }
+        }
+    }
 #endif
-            report_error("ObjectPool exhausted", 1);
+};
+
+/**
+ * CompactPoolHandle is a PoolHandle for a pool with static storage duration.
+ * The pool is a template argument, so the handle stores only the object
+ * pointer: sizeof(CompactPoolHandle) == sizeof(void*). The RAII semantics are
+ * the same as PoolHandle (move-only, destroys the object on scope exit).
+ *
+ *     ObjectPool<Foo> g_foos(4096);
+ *     auto h = CompactPoolHandle<g_foos>::emplace(1, 2);
+ */
+template <auto& Pool>
+class CompactPoolHandle
+{
+public:
+    using pool_type = std::remove_reference_t<decltype(Pool)>;
+    using value_type = typename pool_type::value_type;
+
+private:
+    value_type* object_ = nullptr; // managed object
+
+    void destroy_handle() noexcept
+    {
+        if (!object_)
+            return;
+
+        Pool.trace_slot(PoolEvent::HandleDestroy, object_, [&] {
+            return "[CompactPoolHandle][DESTROY] object=" +
+                   std::to_string(reinterpret_cast<std::uintptr_t>(object_)) + "\n";
+        });
+
+        Pool.destroy_object(object_);
+        object_ = nullptr;
+    }
+
+public:
+    CompactPoolHandle() noexcept = default;
+
+    // Takes ownership from a handle of the same pool.
+    explicit CompactPoolHandle(typename pool_type::handle_type&& handle) noexcept
+        : object_(handle.object_)
+    {
+        assert((!handle.object_ || handle.pool_ == &Pool) &&
+               "PoolHandle belongs to a different pool");
+        handle.pool_ = nullptr;
+        handle.object_ = nullptr;
+    }
+
+    // Same as Pool.emplace(args...), including its error reporting.
+    template <typename... Args>
+    static CompactPoolHandle emplace(Args&&... args)
+    {
+        return CompactPoolHandle(Pool.emplace(std::forward<Args>(args)...));
+    }
+
+    // Same as Pool.try_emplace(args...): empty on exhaustion, never reported.
+    template <typename... Args>
+    static CompactPoolHandle try_emplace(Args&&... args)
+    {
+        return CompactPoolHandle(Pool.try_emplace(std::forward<Args>(args)...));
+    }
+
+    CompactPoolHandle(const CompactPoolHandle&) = delete;
+    CompactPoolHandle& operator=(const CompactPoolHandle&) = delete;
+
+    CompactPoolHandle(CompactPoolHandle&& other) noexcept
+        : object_(other.object_)
+    {
+        other.object_ = nullptr;
+    }
+
+    CompactPoolHandle& operator=(CompactPoolHandle&& other) noexcept
+    {
+        if (this != &other)
+        {
+            destroy_handle();
+            object_ = other.object_;
+            other.object_ = nullptr;
         }
+        return *this;
+    }
 
-        try {
-            std::construct_at(slot, std::forward<Args>(args)...);
+    ~CompactPoolHandle() noexcept
+    {
+        destroy_handle();
+    }
+
+    void reset() noexcept { destroy_handle(); }
+
+    value_type* get() const noexcept { return object_; }
+    value_type& operator*() const noexcept { return *object_; }
+    value_type* operator->() const noexcept { return object_; }
+    explicit operator bool() const noexcept { return object_ != nullptr; }
+};
+
+/**
+ * PoolIndexHandle is the smallest owning handle: a 32-bit slot index into a
+ * pool with static storage duration (sizeof(PoolIndexHandle) == 4). get()
+ * resolves the index against the pool, which is a multiply-add for the initial
+ * block and a binary search over chunks for slots of a grown pool.
+ * The pool's max_capacity() must fit in 32 bits.
+ */
+template <auto& Pool>
+class PoolIndexHandle
+{
+public:
+    using pool_type = std::remove_reference_t<decltype(Pool)>;
+    using value_type = typename pool_type::value_type;
+
+private:
+    static constexpr size_t kMaxIndex = 0xFFFFFFFEull;
+
+    std::uint32_t index1_ = 0; // slot index + 1, 0 when empty
+
+    void destroy_handle() noexcept
+    {
+        if (!index1_)
+            return;
+
+        value_type* object = get();
+
+        Pool.trace(PoolEvent::HandleDestroy, object, index1_ - 1, [&] {
+            return "[PoolIndexHandle][DESTROY] index=" + std::to_string(index1_ - 1) + "\n";
+        });
+
+        Pool.destroy_object(object);
+        index1_ = 0;
+    }
+
+public:
+    PoolIndexHandle() noexcept = default;
+
+    // Takes ownership from a handle of the same pool.
+    explicit PoolIndexHandle(typename pool_type::handle_type&& handle) noexcept
+    {
+        if (!handle.object_)
+            return;
+
+        assert(handle.pool_ == &Pool && "PoolHandle belongs to a different pool");
+        const size_t idx = Pool.slot_index(handle.object_);
+        assert(idx <= kMaxIndex && "slot index does not fit PoolIndexHandle");
+
+        index1_ = static_cast<std::uint32_t>(idx + 1);
+        handle.pool_ = nullptr;
+        handle.object_ = nullptr;
+    }
+
+    // Same as Pool.emplace(args...), including its error reporting. Reports an
+    // error instead if the pool can grow beyond the 32-bit index range.
+    template <typename... Args>
+    static PoolIndexHandle emplace(Args&&... args)
+    {
+        if (Pool.max_capacity() > kMaxIndex)
+        {
+            Pool.report_error("ObjectPool capacity exceeds handle index range", 5);
+            return PoolIndexHandle{};
         }
-        catch (...) {
-#ifdef OxiMemPool_ThreadSafe
-            std::lock_guard<std::mutex> g(mutex_);
+        return PoolIndexHandle(Pool.emplace(std::forward<Args>(args)...));
+    }
+
+    // Same as Pool.try_emplace(args...): empty on exhaustion, never reported.
+    // An index range too small for the pool is still reported as in emplace().
+    template <typename... Args>
+    static PoolIndexHandle try_emplace(Args&&... args)
+    {
+        if (Pool.max_capacity() > kMaxIndex)
+        {
+            Pool.report_error("ObjectPool capacity exceeds handle index range", 5);
+            return PoolIndexHandle{};
+        }
+        return PoolIndexHandle(Pool.try_emplace(std::forward<Args>(args)...));
+    }
+
+    PoolIndexHandle(const PoolIndexHandle&) = delete;
+    PoolIndexHandle& operator=(const PoolIndexHandle&) = delete;
+
+    PoolIndexHandle(PoolIndexHandle&& other) noexcept
+        : index1_(other.index1_)
+    {
+        other.index1_ = 0;
+    }
+
+    PoolIndexHandle& operator=(PoolIndexHandle&& other) noexcept
+    {
+        if (this != &other)
+        {
+            destroy_handle();
+            index1_ = other.index1_;
+            other.index1_ = 0;
+        }
+        return *this;
+    }
+
+    ~PoolIndexHandle() noexcept
+    {
+        destroy_handle();
+    }
+
+    void reset() noexcept { destroy_handle(); }
+
+    // Slot index inside the pool; only meaningful for a non-empty handle.
+    std::uint32_t index() const noexcept { return index1_ - 1; }
+
+    value_type* get() const noexcept
+    {
+        return index1_ ? std::launder(reinterpret_cast<value_type*>(Pool.slot_address(index1_ - 1)))
+                       : nullptr;
+    }
+
+    value_type& operator*() const noexcept { return *get(); }
+    value_type* operator->() const noexcept { return get(); }
+    explicit operator bool() const noexcept { return index1_ != 0; }
+};
+
+#ifdef OxiMemPool_WeakRefs
+/**
+ * PoolWeakRef is a non-owning reference to a pooled object (slot index plus
+ * generation). try_get() is O(1): it returns the object while the referenced
+ * object is alive and nullptr once it has been destroyed, even if the slot has
+ * been reused by a newer object since.
+ *
+ * A weak reference never keeps the object alive. In multithreaded code the
+ * pointer returned by try_get() is only safe to use while the owner of the
+ * object is known not to destroy it concurrently.
+ * Generations are 32-bit; a reference can falsely revalidate only after the
+ * same slot has been reused 2^32 times.
+ */
+template <typename T, PoolThreading Threading>
+    requires std::destructible<T>
+class PoolWeakRef
+{
+private:
+    ObjectPool<T, Threading>* pool_ = nullptr; // referenced pool
+    std::uint32_t index_ = 0;       // slot index
+    std::uint32_t generation_ = 0;  // generation of the slot when referenced
+
+public:
+    PoolWeakRef() noexcept = default;
+
+    // References the object owned by `handle` (empty reference for an empty handle).
+    explicit PoolWeakRef(const PoolHandle<T, Threading>& handle) noexcept
+    {
+        if (!handle)
+            return;
+
+        pool_ = handle.pool_;
+        const size_t idx = pool_->slot_index(handle.object_);
+        assert(idx <= 0xFFFFFFFFull && "slot index does not fit PoolWeakRef");
+        index_ = static_cast<std::uint32_t>(idx);
+        generation_ = pool_->generation(idx).load(std::memory_order_acquire);
+    }
+
+    // The referenced object, or nullptr if it has been destroyed.
+    T* try_get() const noexcept
+    {
+        if (!pool_ || pool_->generation(index_).load(std::memory_order_acquire) != generation_)
+            return nullptr;
+
+        return std::launder(reinterpret_cast<T*>(pool_->slot_address(index_)));
+    }
+
+    bool expired() const noexcept { return try_get() == nullptr; }
+
+    void reset() noexcept { pool_ = nullptr; }
+
+    friend bool operator==(const PoolWeakRef&, const PoolWeakRef&) noexcept = default;
+};
 #endif
-            free_no_lock(slot);
-            throw;
+
+#ifdef OxiMemPool_SharedHandles
+/**
+ * PoolSharedHandle shares ownership of an object allocated from an ObjectPool
+ * (OxiMemPool_SharedHandles), like a std::shared_ptr from make_shared but
+ * without a control block: the reference count is the 32-bit entry of the
+ * object's slot in the pool's side array. The count is atomic in thread-safe
+ * pools and a plain counter in SingleThread pools. When the last handle goes
+ * away the object is destroyed and its slot returned as by PoolHandle.
+ *
+ * Created by ObjectPool::emplace_shared() or from a PoolHandle. A handle holds
+ * the pool, the object and its counter, so copies never look up the slot.
+ */
+template <typename T, PoolThreading Threading>
+    requires std::destructible<T>
+class PoolSharedHandle
+{
+private:
+    static constexpr bool kAtomicCount = Threading != PoolThreading::SingleThread;
+
+    ObjectPool<T, Threading>* pool_ = nullptr;    // owning pool
+    T* object_ = nullptr;                         // shared object
+    std::atomic<std::uint32_t>* count_ = nullptr; // reference count in the pool's side array
+
+    void retain() const noexcept
+    {
+        if (!count_)
+            return;
+        if constexpr (kAtomicCount)
+            count_->fetch_add(1, std::memory_order_relaxed);
+        else
+            count_->store(count_->load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    // Drops this handle's reference; the last one destroys the object.
+    void release() noexcept
+    {
+        if (!count_)
+            return;
+
+        bool last = false;
+        if constexpr (kAtomicCount)
+        {
+            // Release orders this owner's writes before the destruction;
+            // acquire makes the other owners' writes visible to the last one.
+            last = count_->fetch_sub(1, std::memory_order_acq_rel) == 1;
+        }
+        else
+        {
+            const std::uint32_t n = count_->load(std::memory_order_relaxed) - 1;
+            count_->store(n, std::memory_order_relaxed);
+            last = n == 0;
+        }
+
+        if (last)
+        {
+            pool_->trace_slot(PoolEvent::HandleDestroy, object_, [&] {
+                return "[PoolSharedHandle][DESTROY] object=" +
+                       std::to_string(reinterpret_cast<std::uintptr_t>(object_)) + "\n";
+            });
+            pool_->destroy_object(object_);
+        }
+        pool_ = nullptr;
+        object_ = nullptr;
+        count_ = nullptr;
+    }
+
+public:
+    PoolSharedHandle() noexcept = default;
+
+    // Takes over the object of `handle` with a count of one (empty for an empty handle).
+    explicit PoolSharedHandle(PoolHandle<T, Threading>&& handle) noexcept
+    {
+        if (!handle)
+            return;
+
+        pool_ = handle.pool_;
+        object_ = handle.object_;
+        count_ = &pool_->refcount(pool_->slot_index(object_));
+        count_->store(1, std::memory_order_relaxed);
+        handle.pool_ = nullptr;
+        handle.object_ = nullptr;
+    }
+
+    PoolSharedHandle(const PoolSharedHandle& other) noexcept
+        : pool_(other.pool_), object_(other.object_), count_(other.count_)
+    {
+        retain();
+    }
+
+    PoolSharedHandle(PoolSharedHandle&& other) noexcept
+        : pool_(other.pool_), object_(other.object_), count_(other.count_)
+    {
+        other.pool_ = nullptr;
+        other.object_ = nullptr;
+        other.count_ = nullptr;
+    }
+
+    PoolSharedHandle& operator=(const PoolSharedHandle& other) noexcept
+    {
+        if (count_ != other.count_)
+        {
+            other.retain();
+            release();
+            pool_ = other.pool_;
+            object_ = other.object_;
+            count_ = other.count_;
+        }
+        return *this;
+    }
+
+    PoolSharedHandle& operator=(PoolSharedHandle&& other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+            pool_ = other.pool_;
+            object_ = other.object_;
+            count_ = other.count_;
+            other.pool_ = nullptr;
+            other.object_ = nullptr;
+            other.count_ = nullptr;
         }
+        return *this;
+    }
 
-        used_count_.fetch_add(1, std::memory_order_acq_rel);
+    ~PoolSharedHandle() noexcept
+    {
+        release();
+    }
 
-        return PoolHandle<T>(*this, slot);
+    void reset() noexcept { release(); }
+
+    // Number of handles sharing the object (0 for an empty handle); only a
+    // snapshot while other threads copy or drop handles.
+    std::uint32_t use_count() const noexcept
+    {
+        return count_ ? count_->load(std::memory_order_relaxed) : 0;
     }
 
-    // Current number of live objects
-    size_t size() const noexcept { return used_count_.load(std::memory_order_acquire); }
+    T* get() const noexcept { return object_; }
+    T& operator*() const noexcept { return *object_; }
+    T* operator->() const noexcept { return object_; }
+    explicit operator bool() const noexcept { return object_ != nullptr; }
 
-    // Maximum pool capacity
-    size_t capacity() const noexcept { return capacity_; }
-};
\ No newline at end of file
+    friend bool operator==(const PoolSharedHandle& a, const PoolSharedHandle& b) noexcept
+    {
+        return a.object_ == b.object_;
+    }
+};
+#endif
@@ -0,0 +1,267 @@
+/**
+* @file polymorphic_pool.hpp
+* @brief ObjectPool for class hierarchies: emplace<Derived>() into slots of one block.
+*
+* PolymorphicPool sizes its slots for the largest type of a hierarchy, so every
+* concrete type shares one pool and one contiguous block:
+*
+*     #include "MemOx/polymorphic_pool.hpp"
+*
+*     PolymorphicPoolOf<Expr, Literal, Binary, Call> nodes(4096);
+*     PolymorphicHandle<Expr> lit = nodes.emplace<Literal>(42);
+*     PolymorphicHandle<Expr> add = nodes.emplace<Binary>('+', lhs, rhs);
+*
+* @author 0x1mer
+* @license MIT
+*/
+
+#pragma once
+
+#include "object_pool.hpp"
+
+#include <algorithm>  // std::max
+#include <concepts>   // std::derived_from
+#include <cstddef>    // std::max_align_t
+
+// Raw storage of one polymorphic slot; objects are constructed at its start.
+template <size_t Size, size_t Align>
+struct alignas(Align) PolymorphicSlot
+{
+    std::byte bytes[Size];
+};
+
+template <size_t Size, size_t Align>
+struct PoolSlotLayout<PolymorphicSlot<Size, Align>>
+{
+    static constexpr SlotLayout value = SlotLayout::Natural;
+};
+
+/**
+ * True if a D can live in a slot of SlotSize bytes aligned to SlotAlign and be
+ * handed out as a Base*. D must be Base or publicly derived from it, and Base
+ * must not be a virtual base of D, so that the pool can get the D back from the
+ * Base* with a static_cast.
+ */
+template <typename D, typename Base, size_t SlotSize, size_t SlotAlign>
+inline constexpr bool kFitsPolymorphicSlot =
+    std::derived_from<D, Base> && std::destructible<D> &&
+    sizeof(D) <= SlotSize && alignof(D) <= SlotAlign &&
+    requires(Base* base) { static_cast<D*>(base); };
+
+/**
+ * Slot size and alignment that hold Base and every type of Derived, for
+ * PolymorphicPoolOf / PolymorphicPoolWith or an explicit
+ * PolymorphicPool<Base, Size, Align, Threading>.
+ */
+template <typename Base, typename... Derived>
+struct PolymorphicSlotOf
+{
+    static constexpr size_t size = std::max({sizeof(Base), sizeof(Derived)...});
+    static constexpr size_t align = std::max({alignof(Base), alignof(Derived)...});
+};
+
+/**
+ * PolymorphicHandle owns an object of a type derived from Base allocated from
+ * a PolymorphicPool; it behaves like PoolHandle<Base>. The handle records the
+ * concrete type's destroy function at emplace(), so destroying it runs the
+ * destructor of the concrete type as a direct (non-virtual) call, and Base
+ * needs no virtual destructor. The handle type does not depend on the pool
+ * parameters: handles from differently sized pools of one hierarchy mix.
+ */
+template <typename Base>
+class PolymorphicHandle
+{
+    // Destroys the object and returns its slot to `pool`.
+    using DestroyFn = void (*)(void* pool, Base* object) noexcept;
+
+    void* pool_ = nullptr;        // owning PolymorphicPool
+    Base* object_ = nullptr;      // managed object
+    DestroyFn destroy_ = nullptr; // destroy function of the concrete type
+
+    template <typename, size_t, size_t, PoolThreading> friend class PolymorphicPool;
+
+    PolymorphicHandle(void* pool, Base* object, DestroyFn destroy) noexcept
+        : pool_(pool), object_(object), destroy_(destroy) {}
+
+    void destroy_handle() noexcept
+    {
+        if (!object_)
+            return;
+
+        destroy_(pool_, object_);
+        pool_ = nullptr;
+        object_ = nullptr;
+        destroy_ = nullptr;
+    }
+
+public:
+    PolymorphicHandle() noexcept = default;
+
+    PolymorphicHandle(const PolymorphicHandle&) = delete;
+    PolymorphicHandle& operator=(const PolymorphicHandle&) = delete;
+
+    PolymorphicHandle(PolymorphicHandle&& other) noexcept
+        : pool_(other.pool_), object_(other.object_), destroy_(other.destroy_)
+    {
+        other.pool_ = nullptr;
+        other.object_ = nullptr;
+        other.destroy_ = nullptr;
+    }
+
+    PolymorphicHandle& operator=(PolymorphicHandle&& other) noexcept
+    {
+        if (this != &other)
+        {
+            destroy_handle();
+            pool_ = other.pool_;
+            object_ = other.object_;
+            destroy_ = other.destroy_;
+            other.pool_ = nullptr;
+            other.object_ = nullptr;
+            other.destroy_ = nullptr;
+        }
+        return *this;
+    }
+
+    ~PolymorphicHandle() noexcept
+    {
+        destroy_handle();
+    }
+
+    void reset() noexcept { destroy_handle(); }
+
+    Base* get() const noexcept { return object_; }
+    Base& operator*() const noexcept { return *object_; }
+    Base* operator->() const noexcept { return object_; }
+    explicit operator bool() const noexcept { return object_ != nullptr; }
+};
+
+/**
+ * PolymorphicPool is an ObjectPool of SlotSize-byte slots aligned to SlotAlign
+ * for the objects of a class hierarchy rooted at Base. emplace<D>() constructs
+ * any D with kFitsPolymorphicSlot in a slot and returns a
+ * PolymorphicHandle<Base>; the fit is checked at compile time. All concrete
+ * types share one pool, so its capacity, growth and threading policy are those
+ * of a single ObjectPool.
+ *
+ * PolymorphicPoolOf<Base, A, B, C> computes the slot from a type list. Objects
+ * are constructed at the slot start, so handle.get() may differ from the slot
+ * address when Base is not the first base of D.
+ *
+ * Slots are taken and returned like the objects of ObjectPool::emplace() and
+ * destroy_object(), so OxiMemPool_Hardened, OxiMemPool_Occupancy and
+ * profiling cover polymorphic objects too. pool().release_all() only resets
+ * the slots: the destructors of the objects in them are not run.
+ *
+ * Errors (exhaustion, invalid sizes) are reported exactly as in
+ * ObjectPool::emplace().
+ */
+template <typename Base, size_t SlotSize, size_t SlotAlign = alignof(std::max_align_t),
+          PoolThreading Threading = kDefaultPoolThreading>
+class PolymorphicPool
+{
+    static_assert(std::is_class_v<Base>, "Base must be a class type");
+    static_assert(SlotSize >= sizeof(Base), "SlotSize must hold a Base");
+    static_assert((SlotAlign & (SlotAlign - 1)) == 0, "SlotAlign must be a power of two");
+    static_assert(SlotAlign >= alignof(Base), "SlotAlign must be at least alignof(Base)");
+
+public:
+    using storage_type = PolymorphicSlot<(SlotSize + SlotAlign - 1) / SlotAlign * SlotAlign, SlotAlign>;
+    using pool_type = ObjectPool<storage_type, Threading>;
+    using handle_type = PolymorphicHandle<Base>;
+
+    static constexpr size_t slot_size = SlotSize;
+    static constexpr size_t slot_align = SlotAlign;
+
+    template <typename D>
+    static constexpr bool fits = kFitsPolymorphicSlot<D, Base, SlotSize, SlotAlign>;
+
+private:
+    pool_type pool_;
+
+    // Destroy function recorded in the handles of objects of type D.
+    template <typename D>
+    static void destroy_as(void* pool, Base* object) noexcept
+    {
+        D* derived = static_cast<D*>(object);
+        if constexpr (!std::is_trivially_destructible_v<D>)
+            derived->D::~D(); // qualified: no virtual dispatch
+        // The slot type is trivial; this only returns the slot to the pool.
+        static_cast<PolymorphicPool*>(pool)->pool_.destroy_object(
+            reinterpret_cast<storage_type*>(derived));
+    }
+
+    // Constructs a D in `slot` (empty handle if the pool is exhausted).
+    template <typename D, typename... Args>
+    OxiMemPool_ProfileInline handle_type construct(PoolHandle<storage_type, Threading> slot, Args&&... args)
+    {
+        if (!slot)
+            return handle_type{};
+
+        // If the constructor throws, `slot` gives the slot back.
+        D* object = std::construct_at(reinterpret_cast<D*>(slot.get()->bytes),
+                                      std::forward<Args>(args)...);
+
+        slot.pool_ = nullptr;
+        slot.object_ = nullptr;
+        return handle_type(this, object, &destroy_as<D>);
+    }
+
+public:
+    explicit PolymorphicPool(size_t capacity,
+                             GrowthPolicy growth = GrowthPolicy{},
+                             LogFunction log = nullptr)
+        : pool_(capacity, growth, log) {}
+
+    PolymorphicPool(const PolymorphicPool&) = delete;
+    PolymorphicPool& operator=(const PolymorphicPool&) = delete;
+
+    /**
+     * Constructs a D in a free slot and returns the owning handle.
+     * Strong exception safety: if D's constructor throws, the slot is returned
+     * and the exception is propagated. Returns an empty handle if the pool is
+     * exhausted and an error callback is installed.
+     */
+    template <typename D, typename... Args>
+        requires fits<D>
+    OxiMemPool_ProfileInline handle_type emplace(Args&&... args)
+    {
+        return construct<D>(pool_.emplace(), std::forward<Args>(args)...);
+    }
+
+    // Like emplace(), but returns an empty handle on exhaustion without any
+    // error reporting (see ObjectPool::try_emplace()).
+    template <typename D, typename... Args>
+        requires fits<D>
+    OxiMemPool_ProfileInline handle_type try_emplace(Args&&... args)
+    {
+        return construct<D>(pool_.try_emplace(), std::forward<Args>(args)...);
+    }
+
+    // True if `object` was allocated from this pool.
+    bool owns(const Base* object) const noexcept { return pool_.owns(object); }
+
+    // Live objects of every type
+    size_t size() const noexcept { return pool_.size(); }
+
+    size_t capacity() const noexcept { return pool_.capacity(); }
+    size_t max_capacity() const noexcept { return pool_.max_capacity(); }
+
+    // Releases entirely free growth chunks; returns the slots released.
+    size_t shrink_to_fit() { return pool_.shrink_to_fit(); }
+
+    // The underlying pool of raw slots (error callback, event hook, stats, ...).
+    pool_type& pool() noexcept { return pool_; }
+    const pool_type& pool() const noexcept { return pool_; }
+};
+
+// PolymorphicPool with slots sized for Base and every type of Derived, using
+// the threading policy `Threading`.
+template <PoolThreading Threading, typename Base, typename... Derived>
+using PolymorphicPoolWith = PolymorphicPool<Base, PolymorphicSlotOf<Base, Derived...>::size,
+                                            PolymorphicSlotOf<Base, Derived...>::align, Threading>;
+
+// PolymorphicPoolWith the default threading policy. A defaulted parameter
+// cannot follow the type list, hence the two aliases.
+template <typename Base, typename... Derived>
+using PolymorphicPoolOf = PolymorphicPoolWith<kDefaultPoolThreading, Base, Derived...>;
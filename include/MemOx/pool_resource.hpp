@@ -0,0 +1,181 @@
+/**
+* @file pool_resource.hpp
+* @brief std::pmr::memory_resource and allocator adapters over ObjectPool.
+*
+* Node-based containers allocate one node at a time; these adapters serve
+* such single-node requests from an ObjectPool of raw slots and forward
+* everything else (bucket arrays, oversized or over-aligned requests, and
+* requests made while the pool is exhausted) to an upstream resource.
+*
+*     #include "MemOx/pool_resource.hpp"
+*
+*     PoolMemoryResource<32> nodes(4096);
+*     std::pmr::list<int> list(&nodes);
+*
+*     using Alloc = PoolAllocator<std::pair<const int, int>, PoolMemoryResource<64>>;
+*     PoolMemoryResource<64> map_nodes(4096);
+*     std::map<int, int, std::less<>, Alloc> map{Alloc(map_nodes)};
+*
+* @author 0x1mer
+* @license MIT
+*/
+
+#pragma once
+
+#include "object_pool.hpp"
+
+#include <cstddef>          // std::max_align_t
+#include <memory_resource>  // std::pmr::memory_resource
+
+// Raw storage of one resource slot.
+template <size_t Size, size_t Align>
+struct alignas(Align) PoolStorage
+{
+    std::byte bytes[Size];
+};
+
+template <size_t Size, size_t Align>
+struct PoolSlotLayout<PoolStorage<Size, Align>>
+{
+    static constexpr SlotLayout value = SlotLayout::Natural;
+};
+
+/**
+ * PoolMemoryResource owns an ObjectPool of `SlotSize`-byte slots aligned to
+ * `SlotAlign`. allocate(bytes, align) with bytes <= SlotSize and
+ * align <= SlotAlign takes a slot from the pool; other requests, and requests
+ * that find the pool exhausted, go to the upstream resource.
+ *
+ * The node fast path is also available without virtual dispatch through
+ * allocate_node() / deallocate_node(), which PoolAllocator uses.
+ * Thread safety follows `Threading`; the upstream resource must be at least
+ * as thread-safe.
+ */
+template <size_t SlotSize, size_t SlotAlign = alignof(std::max_align_t),
+          PoolThreading Threading = kDefaultPoolThreading>
+class PoolMemoryResource : public std::pmr::memory_resource
+{
+    static_assert(SlotSize > 0, "SlotSize must be positive");
+    static_assert((SlotAlign & (SlotAlign - 1)) == 0, "SlotAlign must be a power of two");
+
+public:
+    using storage_type = PoolStorage<(SlotSize + SlotAlign - 1) / SlotAlign * SlotAlign, SlotAlign>;
+    using pool_type = ObjectPool<storage_type, Threading>;
+
+    static constexpr size_t slot_size = SlotSize;
+    static constexpr size_t slot_align = SlotAlign;
+
+private:
+    pool_type pool_;
+    std::pmr::memory_resource* upstream_;
+
+    static constexpr bool fits(size_t bytes, size_t align) noexcept
+    {
+        return bytes <= SlotSize && align <= SlotAlign;
+    }
+
+public:
+    explicit PoolMemoryResource(size_t capacity,
+                                GrowthPolicy growth = GrowthPolicy{},
+                                std::pmr::memory_resource* upstream = std::pmr::get_default_resource(),
+                                LogFunction log = nullptr)
+        : pool_(capacity, growth, log), upstream_(upstream) {}
+
+    PoolMemoryResource(const PoolMemoryResource&) = delete;
+    PoolMemoryResource& operator=(const PoolMemoryResource&) = delete;
+
+    // Same as allocate(), without virtual dispatch.
+    void* allocate_node(size_t bytes, size_t align)
+    {
+        if (fits(bytes, align))
+        {
+            if (storage_type* slot = pool_.try_allocate_storage())
+                return slot;
+        }
+        return upstream_->allocate(bytes, align);
+    }
+
+    // Same as deallocate(), without virtual dispatch.
+    void deallocate_node(void* p, size_t bytes, size_t align) noexcept
+    {
+        if (fits(bytes, align) && pool_.owns(p))
+            pool_.deallocate_storage(static_cast<storage_type*>(p));
+        else
+            upstream_->deallocate(p, bytes, align);
+    }
+
+    pool_type& pool() noexcept { return pool_; }
+    const pool_type& pool() const noexcept { return pool_; }
+
+    std::pmr::memory_resource* upstream_resource() const noexcept { return upstream_; }
+
+protected:
+    void* do_allocate(size_t bytes, size_t align) override
+    {
+        return allocate_node(bytes, align);
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t align) override
+    {
+        deallocate_node(p, bytes, align);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+/**
+ * PoolAllocator is a stateful std::allocator-compatible adapter over a
+ * PoolMemoryResource for containers with non-pmr allocator parameters.
+ * allocate(n) takes a pool slot when n * sizeof(T) fits the resource's slots
+ * (single nodes); larger arrays go to the upstream resource. Allocators are
+ * equal when they share a resource, and propagate with the container on move
+ * and swap.
+ */
+template <typename T, typename Resource>
+class PoolAllocator
+{
+    template <typename U, typename R> friend class PoolAllocator;
+
+    Resource* resource_;
+
+public:
+    using value_type = T;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    template <typename U>
+    struct rebind
+    {
+        using other = PoolAllocator<U, Resource>;
+    };
+
+    explicit PoolAllocator(Resource& resource) noexcept
+        : resource_(&resource) {}
+
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U, Resource>& other) noexcept
+        : resource_(other.resource_) {}
+
+    T* allocate(size_t n)
+    {
+        if (n > std::numeric_limits<size_t>::max() / sizeof(T))
+            throw std::bad_array_new_length();
+        return static_cast<T*>(resource_->allocate_node(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* p, size_t n) noexcept
+    {
+        resource_->deallocate_node(p, n * sizeof(T), alignof(T));
+    }
+
+    Resource& resource() const noexcept { return *resource_; }
+
+    template <typename U>
+    bool operator==(const PoolAllocator<U, Resource>& other) const noexcept
+    {
+        return resource_ == other.resource_;
+    }
+};
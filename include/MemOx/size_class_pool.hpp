@@ -0,0 +1,456 @@
+/**
+* @file size_class_pool.hpp
+* @brief Size-class slab allocator for small objects of different types.
+*
+* SizeClassPool rounds sizeof(T) up to one of a fixed set of size classes and
+* serves every class from its own ObjectPool of raw slots, so different types
+* of similar size share memory and keep the O(1) free-list behaviour:
+*
+*     #include "MemOx/size_class_pool.hpp"
+*
+*     SizeClassPool<> messages(256, GrowthPolicy::geometric(1 << 16));
+*     auto ping = messages.emplace<Ping>(seq);      // 16-byte class
+*     auto ack  = messages.emplace<Ack>(seq, 200);  // shares the class if it fits
+*
+* @author 0x1mer
+* @license MIT
+*/
+
+#pragma once
+
+#include "object_pool.hpp"
+
+#include <array>      // std::array
+#include <atomic>     // std::atomic
+#include <mutex>      // std::mutex, std::lock_guard
+#include <tuple>      // std::tuple
+#include <utility>    // std::index_sequence
+
+// Slot sizes of SizeClassPool: steps of 16 bytes up to 128, then four classes
+// per power of two.
+inline constexpr std::array<size_t, 16> kSlabSizeClasses = {
+    16, 32, 48, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 384, 448, 512,
+};
+
+// Alignment of every slab slot (enough for max_align_t on common ABIs).
+inline constexpr size_t kSlabAlign = 16;
+
+// Index of the smallest size class holding `bytes`, kSlabSizeClasses.size() if none.
+constexpr size_t slab_class_index(size_t bytes) noexcept
+{
+    size_t i = 0;
+    while (i < kSlabSizeClasses.size() && kSlabSizeClasses[i] < bytes)
+        ++i;
+    return i;
+}
+
+// True if objects of type T can be allocated from a SizeClassPool.
+template <typename T>
+inline constexpr bool kFitsSlab = std::is_object_v<T> && std::destructible<T> &&
+                                  sizeof(T) <= kSlabSizeClasses.back() && alignof(T) <= kSlabAlign;
+
+// Raw storage of one slab slot; objects are constructed inside `bytes`.
+template <size_t Size>
+struct alignas(kSlabAlign) SlabSlot
+{
+    std::byte bytes[Size];
+};
+
+// Slab slots are already multiples of kSlabAlign; keep them unpadded whatever
+// the default slot layout is.
+template <size_t Size>
+struct PoolSlotLayout<SlabSlot<Size>>
+{
+    static constexpr SlotLayout value = SlotLayout::Natural;
+};
+
+/**
+ * One size class: the pool of its slots and the bytes requested by the
+ * objects currently living in them (for the fragmentation statistics).
+ */
+template <size_t Size, PoolThreading Threading>
+struct SlabClass
+{
+    using slot_type = SlabSlot<Size>;
+
+    ObjectPool<slot_type, Threading> pool;
+    std::conditional_t<Threading == PoolThreading::SingleThread, size_t, std::atomic<size_t>>
+        requested_bytes{0};
+
+    SlabClass(size_t capacity, GrowthPolicy growth, LogFunction log)
+        : pool(capacity, growth, log) {}
+
+    void add_requested(size_t bytes) noexcept
+    {
+        if constexpr (Threading == PoolThreading::SingleThread)
+            requested_bytes += bytes;
+        else
+            requested_bytes.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    void sub_requested(size_t bytes) noexcept
+    {
+        if constexpr (Threading == PoolThreading::SingleThread)
+            requested_bytes -= bytes;
+        else
+            requested_bytes.fetch_sub(bytes, std::memory_order_relaxed);
+    }
+};
+
+/**
+ * Per-class snapshot returned by SizeClassPool::stats(). In thread-safe modes
+ * the fields are read one after another and may be slightly inconsistent
+ * while other threads allocate.
+ */
+struct SizeClassStats
+{
+    size_t slot_size = 0;                // bytes per slot of this class
+    size_t live = 0;                     // objects currently allocated
+    size_t capacity = 0;                 // committed slots
+    size_t requested_bytes = 0;          // sum of sizeof(T) over live objects
+    size_t used_bytes = 0;               // live * slot_size
+    size_t reserved_bytes = 0;           // capacity * slot_size
+    double internal_fragmentation = 0.0; // 1 - requested / used: rounding waste of live slots
+    double utilization = 0.0;            // live / capacity
+};
+
+/**
+ * SlabHandle owns an object of type T allocated from a SizeClassPool; it
+ * behaves like PoolHandle<T>. Destroying the handle destroys the object and
+ * returns its slot to the size class it came from.
+ */
+template <typename T, PoolThreading Threading>
+class SlabHandle
+{
+    static_assert(kFitsSlab<T>, "T does not fit the largest slab size class");
+
+public:
+    using class_type = SlabClass<kSlabSizeClasses[slab_class_index(sizeof(T))], Threading>;
+
+private:
+    class_type* class_ = nullptr; // owning size class
+    T* object_ = nullptr;         // managed object
+
+    template <PoolThreading> friend class SizeClassPool;
+
+    SlabHandle(class_type& cls, T* object) noexcept
+        : class_(&cls), object_(object) {}
+
+    void destroy_handle() noexcept
+    {
+        if (!class_ || !object_)
+            return;
+
+        std::destroy_at(object_);
+        class_->sub_requested(sizeof(T));
+        // The slot type is trivial; this only returns the slot to the pool.
+        class_->pool.destroy_object(reinterpret_cast<typename class_type::slot_type*>(object_));
+        class_ = nullptr;
+        object_ = nullptr;
+    }
+
+public:
+    SlabHandle() noexcept = default;
+
+    SlabHandle(const SlabHandle&) = delete;
+    SlabHandle& operator=(const SlabHandle&) = delete;
+
+    SlabHandle(SlabHandle&& other) noexcept
+        : class_(other.class_), object_(other.object_)
+    {
+        other.class_ = nullptr;
+        other.object_ = nullptr;
+    }
+
+    SlabHandle& operator=(SlabHandle&& other) noexcept
+    {
+        if (this != &other)
+        {
+            destroy_handle();
+            class_ = other.class_;
+            object_ = other.object_;
+            other.class_ = nullptr;
+            other.object_ = nullptr;
+        }
+        return *this;
+    }
+
+    ~SlabHandle() noexcept
+    {
+        destroy_handle();
+    }
+
+    void reset() noexcept { destroy_handle(); }
+
+    T* get() const noexcept { return object_; }
+    T& operator*() const noexcept { return *object_; }
+    T* operator->() const noexcept { return object_; }
+    explicit operator bool() const noexcept { return object_ != nullptr; }
+};
+
+/**
+ * SizeClassPool serves objects of any type T with sizeof(T) <= 512 and
+ * alignof(T) <= 16 from a fixed set of size classes (kSlabSizeClasses).
+ * The class of T is chosen at compile time, so emplace<T>() is a single
+ * ObjectPool allocation. A class is created on the first allocation of a
+ * type that maps to it, with `slots_per_class` slots (or its entry of the
+ * per-class capacities), and grows according to `growth` (whose
+ * max_capacity applies per class); classes that are never used reserve no
+ * slot memory.
+ *
+ * Errors (exhaustion, invalid sizes) are reported by the class pools exactly
+ * as in ObjectPool::emplace(); invalid sizes surface when the class is
+ * created.
+ */
+template <PoolThreading Threading = kDefaultPoolThreading>
+class SizeClassPool
+{
+public:
+    static constexpr size_t class_count = kSlabSizeClasses.size();
+
+    template <typename T>
+    using handle_type = SlabHandle<T, Threading>;
+
+private:
+    static constexpr bool kSingleThread = Threading == PoolThreading::SingleThread;
+
+    // Lock type for class creation: a no-op for SingleThread pools.
+    struct NullMutex
+    {
+        void lock() noexcept {}
+        void unlock() noexcept {}
+    };
+
+    using CreateMutex = std::conditional_t<kSingleThread, NullMutex, std::mutex>;
+
+    // Owning pointer to a class created on first use. In thread-safe modes it
+    // is published with release / acquire so allocation never locks once the
+    // class exists.
+    template <typename Class>
+    struct LazyClass
+    {
+        std::conditional_t<kSingleThread, Class*, std::atomic<Class*>> ptr{nullptr};
+
+        LazyClass() noexcept = default;
+        LazyClass(const LazyClass&) = delete;
+        LazyClass& operator=(const LazyClass&) = delete;
+        ~LazyClass() { delete get(); }
+
+        Class* get() const noexcept
+        {
+            if constexpr (kSingleThread)
+                return ptr;
+            else
+                return ptr.load(std::memory_order_acquire);
+        }
+    };
+
+    template <typename Seq>
+    struct ClassTable;
+
+    template <size_t... I>
+    struct ClassTable<std::index_sequence<I...>>
+    {
+        using type = std::tuple<LazyClass<SlabClass<kSlabSizeClasses[I], Threading>>...>;
+    };
+
+    std::array<size_t, class_count> slots_; // initial slots of each class
+    GrowthPolicy growth_;
+    LogFunction log_;
+    CreateMutex create_mutex_;              // serializes class creation
+    typename ClassTable<std::make_index_sequence<class_count>>::type classes_;
+
+    // Class I, nullptr if it has not been used yet.
+    template <size_t I>
+    auto* find_class() noexcept { return std::get<I>(classes_).get(); }
+
+    template <size_t I>
+    const auto* find_class() const noexcept { return std::get<I>(classes_).get(); }
+
+    // Class I, created on first use.
+    template <size_t I>
+    auto& class_at()
+    {
+        if (auto* cls = find_class<I>())
+            return *cls;
+        return create_class<I>();
+    }
+
+    template <size_t I>
+    auto& create_class()
+    {
+        using Class = SlabClass<kSlabSizeClasses[I], Threading>;
+        auto& entry = std::get<I>(classes_);
+
+        std::lock_guard<CreateMutex> g(create_mutex_);
+        if constexpr (kSingleThread)
+        {
+            entry.ptr = new Class(slots_[I], growth_, log_);
+            return *entry.ptr;
+        }
+        else
+        {
+            Class* cls = entry.ptr.load(std::memory_order_relaxed);
+            if (!cls)
+            {
+                cls = new Class(slots_[I], growth_, log_);
+                entry.ptr.store(cls, std::memory_order_release);
+            }
+            return *cls;
+        }
+    }
+
+    template <size_t I>
+    SizeClassStats class_stats() const noexcept
+    {
+        SizeClassStats st;
+        st.slot_size = kSlabSizeClasses[I];
+        const auto* cls = find_class<I>();
+        if (!cls)
+            return st;
+
+        st.live = cls->pool.size();
+        st.capacity = cls->pool.capacity();
+        st.requested_bytes = cls->requested_bytes;
+        st.used_bytes = st.live * st.slot_size;
+        st.reserved_bytes = st.capacity * st.slot_size;
+        if (st.used_bytes != 0)
+            st.internal_fragmentation = 1.0 - static_cast<double>(st.requested_bytes) /
+                                              static_cast<double>(st.used_bytes);
+        if (st.capacity != 0)
+            st.utilization = static_cast<double>(st.live) / static_cast<double>(st.capacity);
+        return st;
+    }
+
+    // Constructs a T in `slot` (empty if its class is exhausted).
+    template <typename T, typename Class, typename Slot, typename... Args>
+    static SlabHandle<T, Threading> construct(Class& cls, Slot slot, Args&&... args)
+    {
+        if (!slot)
+            return SlabHandle<T, Threading>{};
+
+        // If the constructor throws, `slot` gives the slot back.
+        T* object = std::construct_at(reinterpret_cast<T*>(slot.get()->bytes),
+                                      std::forward<Args>(args)...);
+        cls.add_requested(sizeof(T));
+
+        slot.pool_ = nullptr;
+        slot.object_ = nullptr;
+        return SlabHandle<T, Threading>(cls, object);
+    }
+
+    // Calls fn on every class created so far.
+    template <typename Fn, size_t... I>
+    void for_each_class(Fn&& fn, std::index_sequence<I...>)
+    {
+        ([&] {
+            if (auto* cls = find_class<I>())
+                fn(*cls);
+        }(), ...);
+    }
+
+    template <typename Fn, size_t... I>
+    void for_each_class(Fn&& fn, std::index_sequence<I...>) const
+    {
+        ([&] {
+            if (auto* cls = find_class<I>())
+                fn(*cls);
+        }(), ...);
+    }
+
+public:
+    explicit SizeClassPool(size_t slots_per_class,
+                           GrowthPolicy growth = GrowthPolicy{},
+                           LogFunction log = nullptr)
+        : growth_(growth), log_(log)
+    {
+        slots_.fill(slots_per_class);
+    }
+
+    // Same as above with the initial slots of each class, indexed like
+    // kSlabSizeClasses.
+    explicit SizeClassPool(const std::array<size_t, class_count>& slots_per_class,
+                           GrowthPolicy growth = GrowthPolicy{},
+                           LogFunction log = nullptr)
+        : slots_(slots_per_class), growth_(growth), log_(log)
+    {
+    }
+
+    SizeClassPool(const SizeClassPool&) = delete;
+    SizeClassPool& operator=(const SizeClassPool&) = delete;
+
+    // Slot size used for objects of `bytes` bytes (0 if too large).
+    static constexpr size_t slot_size(size_t bytes) noexcept
+    {
+        const size_t i = slab_class_index(bytes);
+        return i < class_count ? kSlabSizeClasses[i] : 0;
+    }
+
+    /**
+     * Constructs a T in a slot of its size class and returns the owning
+     * handle. Strong exception safety: if T's constructor throws, the slot is
+     * returned to its class and the exception is propagated. Returns an empty
+     * handle if the class is exhausted and an error callback is installed.
+     */
+    template <typename T, typename... Args>
+        requires kFitsSlab<T>
+    OxiMemPool_ProfileInline SlabHandle<T, Threading> emplace(Args&&... args)
+    {
+        auto& cls = class_at<slab_class_index(sizeof(T))>();
+        return construct<T>(cls, cls.pool.emplace(), std::forward<Args>(args)...);
+    }
+
+    // Like emplace(), but returns an empty handle on exhaustion without any
+    // error reporting (see ObjectPool::try_emplace()).
+    template <typename T, typename... Args>
+        requires kFitsSlab<T>
+    OxiMemPool_ProfileInline SlabHandle<T, Threading> try_emplace(Args&&... args)
+    {
+        auto& cls = class_at<slab_class_index(sizeof(T))>();
+        return construct<T>(cls, cls.pool.try_emplace(), std::forward<Args>(args)...);
+    }
+
+    // The ObjectPool serving the size class of T (created if not used yet).
+    template <typename T>
+        requires kFitsSlab<T>
+    auto& pool_for()
+    {
+        return class_at<slab_class_index(sizeof(T))>().pool;
+    }
+
+    // Live objects over all classes
+    size_t size() const noexcept
+    {
+        size_t total = 0;
+        for_each_class([&](const auto& cls) { total += cls.pool.size(); },
+                       std::make_index_sequence<class_count>{});
+        return total;
+    }
+
+    // Bytes of committed slot memory over all classes in use
+    size_t reserved_bytes() const noexcept
+    {
+        size_t total = 0;
+        for_each_class([&](const auto& cls) {
+            total += cls.pool.capacity() * sizeof(typename std::remove_cvref_t<decltype(cls)>::slot_type);
+        }, std::make_index_sequence<class_count>{});
+        return total;
+    }
+
+    // Per-class utilization and fragmentation, indexed like kSlabSizeClasses.
+    std::array<SizeClassStats, class_count> stats() const noexcept
+    {
+        return [&]<size_t... I>(std::index_sequence<I...>) {
+            return std::array<SizeClassStats, class_count>{class_stats<I>()...};
+        }(std::make_index_sequence<class_count>{});
+    }
+
+    // Releases entirely free growth chunks of every class; returns the slots released.
+    size_t shrink_to_fit()
+    {
+        size_t released = 0;
+        for_each_class([&](auto& cls) { released += cls.pool.shrink_to_fit(); },
+                       std::make_index_sequence<class_count>{});
+        return released;
+    }
+};
@@ -0,0 +1,71 @@
+/**
+* @file static_object_pool.hpp
+* @brief ObjectPool whose N slots are embedded in the pool object itself.
+*
+*     StaticObjectPool<Message, 256> g_messages; // slots live in .bss
+*     auto h = g_messages.try_emplace(1);        // empty handle when exhausted
+*
+* @author 0x1mer
+* @license MIT
+*/
+
+#pragma once
+
+#include "object_pool.hpp"
+
+#include <cstddef>    // std::byte
+#include <span>       // std::span
+
+/**
+ * Holds the slot array of a StaticObjectPool. It is a separate base so that
+ * the array exists before the ObjectPool base is constructed over it. The
+ * array is default-initialized: a pool with static storage duration keeps it
+ * in zero-initialized memory (.bss) instead of the binary image.
+ */
+template <typename T, size_t N, PoolThreading Threading>
+class StaticPoolStorage
+{
+protected:
+    using pool_type = ObjectPool<T, Threading>;
+
+    alignas(pool_type::slot_align) std::byte static_slots_[N * pool_type::slot_size];
+};
+
+/**
+ * StaticObjectPool is an ObjectPool of exactly N slots stored inside the
+ * object, for targets without a heap or code that must not touch it after
+ * startup. It is never allocated from the heap for its slots, does not grow
+ * and is used like any other pool: emplace() / try_emplace() return regular
+ * PoolHandles, and a global StaticObjectPool works with CompactPoolHandle and
+ * PoolIndexHandle.
+ *
+ * Construction runs during dynamic initialization and, in the default
+ * configuration, performs no allocation. Options that keep per-slot side
+ * arrays (OxiMemPool_WeakRefs, OxiMemPool_Occupancy, OxiMemPool_SharedHandles,
+ * OxiMemPool_Profile, ReusePolicy::LowestAddress) or thread caches still allocate them at
+ * construction, and release_all() and compact() use temporary buffers.
+ * Exhaustion through emplace() throws when no error callback is set;
+ * use try_emplace() to handle it without allocating.
+ *
+ * ObjectPool(std::span<std::byte>) provides the same for a buffer supplied by
+ * the caller.
+ */
+template <typename T, size_t N, PoolThreading Threading = kDefaultPoolThreading>
+    requires std::destructible<T>
+class StaticObjectPool : private StaticPoolStorage<T, N, Threading>, public ObjectPool<T, Threading>
+{
+    static_assert(N > 0, "StaticObjectPool needs at least one slot");
+
+    using storage_type = StaticPoolStorage<T, N, Threading>;
+
+public:
+    static constexpr size_t static_capacity = N;
+
+    explicit StaticObjectPool(LogFunction log = nullptr)
+        : ObjectPool<T, Threading>(std::span<std::byte>(storage_type::static_slots_), log)
+    {
+    }
+
+    StaticObjectPool(const StaticObjectPool&) = delete;
+    StaticObjectPool& operator=(const StaticObjectPool&) = delete;
+};
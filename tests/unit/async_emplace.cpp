@@ -0,0 +1,361 @@
+#define OxiMemPool_AsyncEmplace
+#define OxiMemPool_Stats
+#include "MemOx/object_pool.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <coroutine>
+#include <exception>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+struct Job
+{
+    static inline std::atomic<int> live{0};
+
+    int id;
+    explicit Job(int i) : id(i)
+    {
+        if (i < 0)
+            throw std::runtime_error("bad job");
+        ++live;
+    }
+    ~Job() { --live; }
+};
+
+// Fire-and-forget coroutine; the frame destroys itself on completion.
+struct Task
+{
+    struct promise_type
+    {
+        Task get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+};
+
+using namespace std::chrono_literals;
+
+constexpr PoolThreading kST = PoolThreading::SingleThread;
+using STPool = ObjectPool<Job, kST>;
+using STHandle = PoolHandle<Job, kST>;
+
+static Task use_and_drop(STPool& pool, std::vector<int>& order, int id)
+{
+    auto h = co_await pool.async_emplace(id);
+    order.push_back(h->id);
+    // Dropping h here hands the slot to the next waiter.
+}
+
+static Task use_and_keep(STPool& pool, std::vector<STHandle>& kept, int id)
+{
+    kept.push_back(co_await pool.async_emplace(id));
+}
+
+void test_free_slot_does_not_suspend()
+{
+    STPool pool(2);
+    std::vector<STHandle> kept;
+    use_and_keep(pool, kept, 1);
+    use_and_keep(pool, kept, 2);
+    assert(kept.size() == 2 && pool.size() == 2);
+}
+
+void test_waiters_are_served_in_fifo_order()
+{
+    STPool pool(1);
+    auto blocker = pool.emplace(0);
+
+    std::vector<int> order;
+    for (int id = 1; id <= 4; ++id)
+        use_and_drop(pool, order, id);
+    assert(order.empty() && pool.size() == 1);
+
+    // Each resumed coroutine frees its slot on completion, resuming the next.
+    blocker.reset();
+    assert((order == std::vector<int>{1, 2, 3, 4}));
+    assert(pool.size() == 0 && Job::live == 0);
+}
+
+void test_new_callers_queue_behind_waiters()
+{
+    STPool pool(1);
+    std::vector<STHandle> kept;
+    auto blocker = pool.emplace(0);
+    use_and_keep(pool, kept, 1);
+    blocker.reset();
+    assert(kept.size() == 1 && kept[0]->id == 1);
+
+    // The slot went to the waiter, not to the free list.
+    assert(!pool.try_emplace(2));
+}
+
+static Task expect_throw(STPool& pool, bool& thrown)
+{
+    try {
+        auto h = co_await pool.async_emplace(-1);
+    }
+    catch (const std::runtime_error&) {
+        thrown = true;
+    }
+}
+
+void test_constructor_exception_passes_the_slot_on()
+{
+    STPool pool(1);
+    std::vector<STHandle> kept;
+    auto blocker = pool.emplace(0);
+
+    bool thrown = false;
+    expect_throw(pool, thrown);
+    use_and_keep(pool, kept, 7);
+    blocker.reset();
+    assert(thrown);
+    assert(kept.size() == 1 && kept[0]->id == 7);
+    assert(pool.size() == 1);
+}
+
+// Runs `hook` in its constructor and then fails, if a hook is given.
+struct Stage
+{
+    explicit Stage(void (*hook)())
+    {
+        if (hook)
+        {
+            hook();
+            throw std::runtime_error("stage failed");
+        }
+    }
+};
+
+using StagePool = ObjectPool<Stage, kST>;
+static StagePool* g_stage_pool = nullptr;
+static bool g_stage_served = false;
+
+static Task wait_for_stage(StagePool& pool)
+{
+    auto h = co_await pool.async_emplace(nullptr);
+    g_stage_served = static_cast<bool>(h);
+}
+
+void test_failed_bulk_serves_waiters()
+{
+    StagePool pool(2);
+    g_stage_pool = &pool;
+
+    // The first constructor queues a waiter while emplace_n() holds every
+    // slot, then throws; the returned slots must reach the waiter.
+    std::vector<PoolHandle<Stage, kST>> handles;
+    bool thrown = false;
+    try {
+        pool.emplace_n(2, std::back_inserter(handles), +[] {
+            wait_for_stage(*g_stage_pool);
+            assert(!g_stage_served);
+        });
+    }
+    catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown && handles.empty());
+    assert(g_stage_served && pool.size() == 0);
+}
+
+void test_bulk_release_and_reset_serve_waiters()
+{
+    STPool pool(3);
+    std::vector<STHandle> handles;
+    for (int i = 0; i < 3; ++i)
+        handles.push_back(pool.emplace(i));
+
+    std::vector<STHandle> kept;
+    use_and_keep(pool, kept, 10);
+    use_and_keep(pool, kept, 11);
+    pool.release_bulk(handles.begin(), handles.begin() + 2);
+    assert(kept.size() == 2 && kept[0]->id == 10 && kept[1]->id == 11);
+
+    std::vector<Job*> unowned;
+    handles.clear();
+    kept.clear();
+    for (int i = 0; i < 3; ++i)
+        unowned.push_back(pool.emplace_unowned(i));
+    use_and_keep(pool, kept, 12);
+    assert(kept.empty());
+    assert(pool.release_all() == 3);
+    assert(kept.size() == 1 && kept[0]->id == 12);
+}
+
+template <PoolThreading Threading>
+void test_coroutine_resumes_on_the_freeing_thread()
+{
+    using Pool = ObjectPool<Job, Threading>;
+    Pool pool(1);
+    auto blocker = pool.emplace(0);
+
+    std::atomic<bool> resumed{false};
+    std::thread::id resumed_on;
+    auto waiter = [](Pool& p, std::atomic<bool>& done, std::thread::id& on) -> Task {
+        auto h = co_await p.async_emplace(1);
+        on = std::this_thread::get_id();
+        done = true;
+    };
+    waiter(pool, resumed, resumed_on);
+    assert(!resumed);
+
+    std::thread::id freer;
+    std::thread([&] {
+        freer = std::this_thread::get_id();
+        blocker.reset();
+    }).join();
+    assert(resumed && resumed_on == freer);
+    assert(pool.size() == 0);
+}
+
+template <PoolThreading Threading>
+void test_emplace_wait_times_out()
+{
+    ObjectPool<Job, Threading> pool(1);
+    auto blocker = pool.emplace(0);
+
+    const auto start = std::chrono::steady_clock::now();
+    auto none = pool.emplace_wait(20ms, 1);
+    assert(!none);
+    assert(std::chrono::steady_clock::now() - start >= 20ms);
+    assert(pool.stats().exhausted == 1);
+
+    // A slot freed while waiting is handed over.
+    std::thread freer([&] {
+        std::this_thread::sleep_for(20ms);
+        blocker.reset();
+    });
+    auto h = pool.emplace_wait(10s, 2);
+    freer.join();
+    assert(h && h->id == 2);
+}
+
+template <PoolThreading Threading>
+void test_bounded_concurrency()
+{
+    constexpr int kSlots = 4;
+    ObjectPool<Job, Threading> pool(kSlots);
+    std::atomic<int> inside{0};
+    std::atomic<int> peak{0};
+    std::atomic<int> done{0};
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t)
+    {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < 2000; ++i)
+            {
+                auto h = pool.emplace_wait(10s, t);
+                assert(h);
+                const int now = ++inside;
+                int seen = peak.load();
+                while (now > seen && !peak.compare_exchange_weak(seen, now))
+                {
+                }
+                --inside;
+                ++done;
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+
+    assert(done == 8 * 2000);
+    assert(peak <= kSlots);
+    assert(pool.size() == 0 && Job::live == 0);
+}
+
+#ifdef OxiMemPool_ThreadCache
+// Fills the magazine of a new thread with every slot of `pool`, then runs
+// `then` on that thread; the shared free list stays empty meanwhile.
+template <typename Pool, typename Fn>
+std::thread park_slots_in_cache(Pool& pool, std::atomic<bool>& parked, Fn then)
+{
+    return std::thread([&pool, &parked, then] {
+        {
+            auto a = pool.emplace(0);
+            auto b = pool.emplace(1);
+        }
+        parked = true;
+        then();
+    });
+}
+
+template <PoolThreading Threading>
+void test_cache_drain_serves_waiters()
+{
+    using Pool = ObjectPool<Job, Threading>;
+    Pool pool(2);
+    std::atomic<bool> parked{false};
+    std::atomic<bool> go{false};
+
+    auto worker = park_slots_in_cache(pool, parked, [&] {
+        while (!go) std::this_thread::yield();
+        pool.drain_thread_cache();
+    });
+    while (!parked) std::this_thread::yield();
+
+    std::atomic<bool> served{false};
+    auto waiter = [](Pool& p, std::atomic<bool>& done) -> Task {
+        auto h = co_await p.async_emplace(2);
+        done = true;
+    };
+    waiter(pool, served);
+    assert(!served);
+
+    go = true;
+    worker.join();
+    assert(served && pool.size() == 0);
+}
+
+template <PoolThreading Threading>
+void test_cache_thread_exit_serves_waiters()
+{
+    ObjectPool<Job, Threading> pool(2);
+    std::atomic<bool> parked{false};
+
+    auto worker = park_slots_in_cache(pool, parked, [] {
+        std::this_thread::sleep_for(20ms);
+    });
+    while (!parked) std::this_thread::yield();
+
+    // Woken by the flush of the exiting thread, long before the timeout.
+    const auto start = std::chrono::steady_clock::now();
+    auto h = pool.emplace_wait(10s, 2);
+    assert(h && h->id == 2);
+    assert(std::chrono::steady_clock::now() - start < 5s);
+    worker.join();
+}
+#endif
+
+int main()
+{
+    test_free_slot_does_not_suspend();
+    test_waiters_are_served_in_fifo_order();
+    test_new_callers_queue_behind_waiters();
+    test_constructor_exception_passes_the_slot_on();
+    test_bulk_release_and_reset_serve_waiters();
+    test_failed_bulk_serves_waiters();
+    test_coroutine_resumes_on_the_freeing_thread<PoolThreading::Mutex>();
+    test_coroutine_resumes_on_the_freeing_thread<PoolThreading::LockFree>();
+    test_emplace_wait_times_out<PoolThreading::Mutex>();
+    test_emplace_wait_times_out<PoolThreading::LockFree>();
+    test_bounded_concurrency<PoolThreading::Mutex>();
+    test_bounded_concurrency<PoolThreading::LockFree>();
+#ifdef OxiMemPool_ThreadCache
+    test_cache_drain_serves_waiters<PoolThreading::Mutex>();
+    test_cache_drain_serves_waiters<PoolThreading::LockFree>();
+    test_cache_thread_exit_serves_waiters<PoolThreading::Mutex>();
+    test_cache_thread_exit_serves_waiters<PoolThreading::LockFree>();
+#endif
+
+    std::cout << "[OK] async_emplace tests passed\n";
+    return 0;
+}
@@ -0,0 +1,115 @@
+#define OxiMemPool_BackingMemory
+#include "MemOx/numa_pool.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+struct Record
+{
+    std::uint64_t data[8];
+    explicit Record(std::uint64_t v) : data{v} {}
+};
+
+struct alignas(8192) HugeAligned
+{
+    int value;
+    explicit HugeAligned(int v) : value(v) {}
+};
+
+using Huge = BackingPolicy::HugePages;
+
+static void fill_and_check(ObjectPool<Record>& pool, size_t count)
+{
+    std::vector<PoolHandle<Record>> handles;
+    for (size_t i = 0; i < count; ++i)
+        handles.push_back(pool.emplace(i));
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        assert(handles[i]->data[0] == i);
+        assert(reinterpret_cast<std::uintptr_t>(handles[i].get()) % alignof(Record) == 0);
+    }
+}
+
+void test_os_pages()
+{
+    ObjectPool<Record> pool(1000, BackingPolicy::pages());
+    fill_and_check(pool, 1000);
+    assert(pool.size() == 0);
+}
+
+void test_huge_page_policies_fall_back()
+{
+    // Explicit huge pages are usually not reserved on test machines; the
+    // mapping must then fall back to regular pages transparently.
+    ObjectPool<Record> transparent(4096, BackingPolicy::pages(Huge::Transparent));
+    ObjectPool<Record> explicit_pages(4096, BackingPolicy::pages(Huge::Explicit));
+    fill_and_check(transparent, 4096);
+    fill_and_check(explicit_pages, 4096);
+}
+
+void test_populate_and_numa_binding()
+{
+    ObjectPool<Record> populated(512, BackingPolicy::pages(Huge::None, -1, true));
+    ObjectPool<Record> bound(512, BackingPolicy::pages(Huge::None, 0, true));
+    fill_and_check(populated, 512);
+    fill_and_check(bound, 512);
+}
+
+void test_growth_and_shrink_with_os_pages()
+{
+    ObjectPool<Record> pool(4, GrowthPolicy::geometric(64), BackingPolicy::pages(Huge::Transparent));
+
+    {
+        std::vector<PoolHandle<Record>> handles;
+        for (int i = 0; i < 64; ++i)
+            handles.push_back(pool.emplace(i));
+        assert(pool.capacity() == 64);
+    }
+
+    assert(pool.shrink_to_fit() == 60);
+    fill_and_check(pool, 64); // re-maps released chunks
+}
+
+void test_over_aligned_type_uses_heap()
+{
+    ObjectPool<HugeAligned> pool(3, BackingPolicy::pages());
+    auto a = pool.emplace(1);
+    auto b = pool.emplace(2);
+    assert(reinterpret_cast<std::uintptr_t>(a.get()) % 8192 == 0);
+    assert(reinterpret_cast<std::uintptr_t>(b.get()) % 8192 == 0);
+}
+
+void test_numa_front_end()
+{
+    NumaObjectPool<Record> pool(128);
+    assert(pool.node_count() >= 1);
+    assert(BackingMemory::current_node() < pool.node_count());
+    assert(pool.capacity() == 128 * pool.node_count());
+
+    std::vector<NumaObjectPool<Record>::handle_type> handles;
+    for (int i = 0; i < 16; ++i)
+        handles.push_back(pool.emplace(i));
+    handles.push_back(pool.emplace_on(pool.node_count() - 1, 99));
+    assert(pool.size() == 17);
+
+    // Objects may be released from any thread.
+    std::thread([&] { handles.clear(); }).join();
+    assert(pool.size() == 0);
+}
+
+int main()
+{
+    test_os_pages();
+    test_huge_page_policies_fall_back();
+    test_populate_and_numa_binding();
+    test_growth_and_shrink_with_os_pages();
+    test_over_aligned_type_uses_heap();
+    test_numa_front_end();
+
+    std::cout << "[OK] backing_memory tests passed\n";
+    return 0;
+}
@@ -0,0 +1,306 @@
+#define OxiMemPool_Stats
+#define OxiMemPool_EventHook
+#include "MemOx/object_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+#if defined(OxiMemPool_ThreadSafe) || defined(OxiMemPool_LockFree)
+#include <thread>
+#endif
+
+struct alignas(16) Packet
+{
+    // Constructors run outside the pool lock in emplace_n(), so the parallel
+    // churn test updates these from several threads.
+    static inline std::atomic<int> live{0};
+    static inline std::atomic<int> throw_on{-1};
+    static inline std::atomic<int> constructed{0};
+
+    int id;
+    int tag;
+
+    Packet(int i, int t) : id(i), tag(t)
+    {
+        if (constructed++ == throw_on)
+            throw std::runtime_error("packet ctor failed");
+        ++live;
+    }
+
+    ~Packet() { --live; }
+
+    static void reset(int fail_at = -1)
+    {
+        throw_on = fail_at;
+        constructed = 0;
+    }
+};
+
+static_assert(sizeof(Packet) == 16);
+
+void test_emplace_n_is_contiguous()
+{
+    Packet::reset();
+    ObjectPool<Packet> pool(64);
+
+    std::vector<PoolHandle<Packet>> batch;
+    pool.emplace_n(32, std::back_inserter(batch), 7, 3);
+
+    assert(batch.size() == 32);
+    assert(pool.size() == 32);
+
+    for (size_t i = 0; i < batch.size(); ++i)
+    {
+        assert(batch[i]->id == 7);
+        assert(batch[i]->tag == 3);
+        if (i)
+        {
+            auto* prev = reinterpret_cast<std::byte*>(batch[i - 1].get());
+            auto* cur = reinterpret_cast<std::byte*>(batch[i].get());
+            assert(cur - prev == static_cast<std::ptrdiff_t>(sizeof(Packet)));
+        }
+    }
+}
+
+void test_emplace_n_falls_back_to_free_list()
+{
+    Packet::reset();
+    ObjectPool<Packet> pool(8);
+
+    std::vector<PoolHandle<Packet>> first;
+    pool.emplace_n(6, std::back_inserter(first), 1, 1);
+
+    // free three scattered slots; only two untouched slots remain
+    first[0].reset();
+    first[2].reset();
+    first[4].reset();
+
+    std::vector<PoolHandle<Packet>> second;
+    pool.emplace_n(5, std::back_inserter(second), 2, 2);
+
+    assert(second.size() == 5);
+    assert(pool.size() == 8);
+
+    std::vector<Packet*> addrs;
+    for (auto& h : first)
+        if (h) addrs.push_back(h.get());
+    for (auto& h : second)
+        addrs.push_back(h.get());
+
+    std::sort(addrs.begin(), addrs.end());
+    assert(std::adjacent_find(addrs.begin(), addrs.end()) == addrs.end());
+}
+
+void test_emplace_n_all_or_nothing()
+{
+    Packet::reset();
+    ObjectPool<Packet> pool(4);
+
+    auto keep = pool.emplace(0, 0);
+
+    std::vector<PoolHandle<Packet>> batch;
+    bool thrown = false;
+    try {
+        pool.emplace_n(4, std::back_inserter(batch), 1, 1);
+    }
+    catch (const std::runtime_error&) {
+        thrown = true;
+    }
+
+    assert(thrown);
+    assert(batch.empty());
+    assert(pool.size() == 1);
+
+    pool.emplace_n(3, std::back_inserter(batch), 1, 1);
+    assert(batch.size() == 3);
+    assert(pool.size() == 4);
+}
+
+void test_emplace_n_constructor_throws()
+{
+    Packet::reset(2);
+    ObjectPool<Packet> pool(4);
+
+    std::vector<PoolHandle<Packet>> batch;
+    bool thrown = false;
+    try {
+        pool.emplace_n(4, std::back_inserter(batch), 5, 5);
+    }
+    catch (const std::runtime_error&) {
+        thrown = true;
+    }
+
+    assert(thrown);
+    assert(batch.size() == 2);       // handles written before the throw stay valid
+    assert(pool.size() == 2);
+    assert(Packet::live == 2);
+
+    // the unused slots are back in the pool
+    Packet::reset();
+    pool.emplace_n(2, std::back_inserter(batch), 6, 6);
+    assert(pool.size() == 4);
+}
+
+void test_release_bulk()
+{
+    Packet::reset();
+    ObjectPool<Packet> pool(16);
+
+    std::vector<PoolHandle<Packet>> batch;
+    pool.emplace_n(16, std::back_inserter(batch), 1, 2);
+
+    std::vector<Packet*> addrs;
+    for (auto& h : batch)
+        addrs.push_back(h.get());
+
+    batch[3].reset(); // empty handles are skipped
+    pool.release_bulk(batch.begin(), batch.end());
+
+    assert(pool.size() == 0);
+    assert(Packet::live == 0);
+    for (auto& h : batch)
+        assert(!h);
+
+    // every released slot is reusable
+    std::vector<PoolHandle<Packet>> again;
+    pool.emplace_n(16, std::back_inserter(again), 3, 4);
+
+    std::vector<Packet*> reused;
+    for (auto& h : again)
+        reused.push_back(h.get());
+
+    std::sort(addrs.begin(), addrs.end());
+    std::sort(reused.begin(), reused.end());
+    assert(addrs == reused);
+}
+
+void test_emplace_n_grows()
+{
+    Packet::reset();
+    ObjectPool<Packet> pool(4, GrowthPolicy::fixed_step(8, 20));
+
+    std::vector<PoolHandle<Packet>> batch;
+    pool.emplace_n(10, std::back_inserter(batch), 1, 1);
+
+    assert(batch.size() == 10);
+    assert(pool.size() == 10);
+    assert(pool.capacity() == 12);
+
+    pool.release_bulk(batch.begin(), batch.end());
+    assert(pool.size() == 0);
+}
+
+// Fresh slots reported to the event hook, as one bulk event or single ones.
+static size_t g_bulk_events = 0;
+static size_t g_fresh_slots = 0;
+
+static void count_fresh(PoolEvent event, const void*, size_t index)
+{
+    if (event == PoolEvent::AllocBulk)
+    {
+        ++g_bulk_events;
+        g_fresh_slots += index;
+    }
+    else if (event == PoolEvent::AllocNew)
+    {
+        ++g_fresh_slots;
+    }
+}
+
+void test_emplace_n_across_chunk_boundary()
+{
+    Packet::reset();
+    ObjectPool<Packet> pool(4, GrowthPolicy::fixed_step(8, 20));
+
+    // Commit the first chunk, then start over at slot 0 with it kept.
+    for (int i = 0; i < 5; ++i)
+        pool.emplace_unowned(i, 0);
+    pool.release_all();
+    assert(pool.capacity() == 12);
+    pool.emplace_unowned(0, 0);
+    pool.emplace_unowned(1, 0);
+
+    // Slots 2..5 straddle the end of the initial block.
+    const PoolStats before = pool.stats();
+    g_bulk_events = g_fresh_slots = 0;
+    pool.set_event_hook(count_fresh);
+
+    std::vector<PoolHandle<Packet>> batch;
+    pool.emplace_n(4, std::back_inserter(batch), 2, 2);
+    pool.set_event_hook(nullptr);
+    assert(batch.size() == 4 && pool.capacity() == 12);
+
+    const PoolStats after = pool.stats();
+    assert(after.fresh_allocs - before.fresh_allocs == 4);
+    assert(after.reused_allocs == before.reused_allocs);
+    assert(g_fresh_slots == 4);
+#ifdef OxiMemPool_LockFree
+    assert(g_bulk_events == 1); // the slots are taken in one CAS
+#endif
+
+    batch.clear();
+    pool.release_all();
+}
+
+#if defined(OxiMemPool_ThreadSafe) || defined(OxiMemPool_LockFree)
+void test_parallel_bulk_churn()
+{
+    Packet::reset();
+
+    constexpr int kThreads = 4;
+    constexpr int kRounds = 2'000;
+
+    ObjectPool<Packet> pool(kThreads * 64);
+
+    std::atomic<bool> start{false};
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < kThreads; ++t)
+    {
+        threads.emplace_back([&, t] {
+            while (!start.load(std::memory_order_acquire)) {}
+
+            std::vector<PoolHandle<Packet>> batch;
+            for (int i = 0; i < kRounds; ++i)
+            {
+                pool.emplace_n(1 + (i % 64), std::back_inserter(batch), t, i);
+                for (auto& h : batch)
+                    assert(h->id == t && h->tag == i);
+                pool.release_bulk(batch.begin(), batch.end());
+                batch.clear();
+            }
+        });
+    }
+
+    start.store(true, std::memory_order_release);
+    for (auto& th : threads)
+        th.join();
+
+    assert(pool.size() == 0);
+}
+#endif
+
+int main()
+{
+    test_emplace_n_is_contiguous();
+    test_emplace_n_falls_back_to_free_list();
+    test_emplace_n_all_or_nothing();
+    test_emplace_n_constructor_throws();
+    test_release_bulk();
+    test_emplace_n_grows();
+    test_emplace_n_across_chunk_boundary();
+#if defined(OxiMemPool_ThreadSafe) || defined(OxiMemPool_LockFree)
+    test_parallel_bulk_churn();
+#endif
+
+    assert(Packet::live == 0);
+
+    std::cout << "[OK] bulk tests passed\n";
+    return 0;
+}
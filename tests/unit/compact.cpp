@@ -0,0 +1,182 @@
+#include "MemOx/object_pool.hpp"
+
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+struct Body
+{
+    static int live;
+
+    std::string name;
+    std::unique_ptr<int> mass;
+
+    Body(std::string n, int m) : name(std::move(n)), mass(std::make_unique<int>(m)) { ++live; }
+    Body(Body&& other) noexcept : name(std::move(other.name)), mass(std::move(other.mass)) { ++live; }
+    ~Body() { --live; }
+};
+
+int Body::live = 0;
+
+// Slot order checks below assume bump order, which thread caches change.
+constexpr PoolThreading kST = PoolThreading::SingleThread;
+using Pool = ObjectPool<Body, kST>;
+
+template <PoolThreading Threading>
+void test_compact_moves_handles_to_the_front()
+{
+    ObjectPool<Body, Threading> pool(64);
+
+    std::vector<PoolHandle<Body, Threading>> handles;
+    for (int i = 0; i < 40; ++i)
+        handles.push_back(pool.emplace(std::to_string(i), i));
+
+    // Keep every fourth object.
+    std::vector<PoolHandle<Body, Threading>> kept;
+    for (int i = 0; i < 40; ++i)
+        if (i % 4 == 3)
+            kept.push_back(std::move(handles[i]));
+    handles.clear();
+    assert(pool.size() == 10 && Body::live == 10);
+
+    const Body* base = kept.front().get() - 3;
+    // Slots 3 and 7 are already inside the compacted range [0, 10).
+    assert(pool.compact(kept.begin(), kept.end()) == 8);
+
+    for (size_t i = 0; i < kept.size(); ++i)
+    {
+        assert(kept[i].get() >= base && kept[i].get() < base + 10);
+        assert(*kept[i]->mass % 4 == 3);
+        assert(kept[i]->name == std::to_string(*kept[i]->mass));
+    }
+    assert(pool.size() == 10 && Body::live == 10);
+
+    // New objects follow the compacted ones in address order.
+    auto next = pool.emplace("next", 0);
+    assert(next.get() == base + 10);
+
+    kept.clear();
+    next.reset();
+    assert(pool.size() == 0 && Body::live == 0);
+}
+
+void test_compact_pins_unreferenced_objects()
+{
+    Pool pool(16);
+    std::vector<PoolHandle<Body, kST>> handles;
+    for (int i = 0; i < 8; ++i)
+        handles.push_back(pool.emplace("b", i));
+
+    Body* pinned = handles[5].get();
+    PoolHandle<Body, kST> pinned_handle = std::move(handles[5]);
+    for (int i : {0, 1, 2, 3, 4})
+        handles[i].reset();
+
+    // handles[6], handles[7] are compacted; slot 5 stays where it is.
+    std::vector<PoolHandle<Body, kST>> movable;
+    movable.push_back(std::move(handles[6]));
+    movable.push_back(std::move(handles[7]));
+    assert(pool.compact(movable.begin(), movable.end()) == 2);
+    assert(pinned_handle.get() == pinned);
+    assert(*movable[0]->mass == 6 && *movable[1]->mass == 7);
+    assert(movable[0].get() < pinned && movable[1].get() < pinned);
+
+    // The remaining holes below the pinned object are reused first.
+    auto a = pool.emplace("a", 0);
+    assert(a.get() < pinned);
+    auto b = pool.emplace("b", 0);
+    assert(b.get() < pinned);
+    auto c = pool.emplace("c", 0);
+    assert(c.get() < pinned);
+    auto d = pool.emplace("d", 0);
+    assert(d.get() == pinned + 1);
+}
+
+void test_compact_unowned_pointers()
+{
+    Pool pool(32);
+    std::vector<Body*> objects;
+    for (int i = 0; i < 20; ++i)
+        objects.push_back(pool.emplace_unowned("u", i));
+    for (int i = 0; i < 15; ++i)
+    {
+        pool.destroy_unowned(objects.front());
+        objects.erase(objects.begin());
+    }
+
+    Body* front = objects.front() - 15;
+    assert(pool.compact(objects.begin(), objects.end()) == 5);
+    for (int i = 0; i < 5; ++i)
+    {
+        assert(objects[i] == front + (4 - i)); // highest slot first into the lowest hole
+        assert(*objects[i]->mass == 15 + i);
+    }
+
+    assert(pool.release_all() == 5);
+    assert(Body::live == 0);
+}
+
+void test_compact_releases_growth_chunks()
+{
+    Pool pool(8, GrowthPolicy::fixed_step(8, 64));
+    std::vector<PoolHandle<Body, kST>> handles;
+    for (int i = 0; i < 64; ++i)
+        handles.push_back(pool.emplace("g", i));
+    assert(pool.capacity() == 64);
+
+    std::vector<PoolHandle<Body, kST>> kept;
+    for (int i = 0; i < 64; i += 10)
+        kept.push_back(std::move(handles[i]));
+    handles.clear();
+
+    // Seven objects spread over the chunks end up in the initial block; the
+    // chunk [32, 40) holds none and is released first, leaving a hole.
+    assert(pool.shrink_to_fit() == 8);
+    assert(pool.compact(kept.begin(), kept.end()) == 6);
+    assert(pool.capacity() == 8);
+    for (size_t i = 0; i < kept.size(); ++i)
+        assert(*kept[i]->mass == static_cast<int>(i) * 10);
+
+    // Growth resumes from the compacted end.
+    for (int i = 0; i < 20; ++i)
+        handles.push_back(pool.emplace("h", i));
+    assert(pool.size() == 27);
+}
+
+void test_compact_large_tail_is_reusable()
+{
+    // Tail pages are discarded; reusing them must read back fresh objects.
+    Pool pool(4096);
+    std::vector<PoolHandle<Body, kST>> handles;
+    for (int i = 0; i < 4096; ++i)
+        handles.push_back(pool.emplace("t", i));
+    std::vector<PoolHandle<Body, kST>> kept;
+    kept.push_back(std::move(handles.back()));
+    handles.clear();
+
+    assert(pool.compact(kept.begin(), kept.end()) == 1);
+    assert(*kept[0]->mass == 4095);
+    for (int i = 0; i < 4095; ++i)
+        handles.push_back(pool.emplace("again", i));
+    for (int i = 0; i < 4095; ++i)
+        assert(*handles[i]->mass == i && handles[i]->name == "again");
+}
+
+int main()
+{
+    test_compact_moves_handles_to_the_front<PoolThreading::SingleThread>();
+#ifndef OxiMemPool_ThreadCache
+    // Magazines hand slots out in LIFO order; the layout checks assume bump order.
+    test_compact_moves_handles_to_the_front<PoolThreading::Mutex>();
+    test_compact_moves_handles_to_the_front<PoolThreading::LockFree>();
+#endif
+    test_compact_pins_unreferenced_objects();
+    test_compact_unowned_pointers();
+    test_compact_releases_growth_chunks();
+    test_compact_large_tail_is_reusable();
+
+    std::cout << "[OK] compact tests passed\n";
+    return 0;
+}
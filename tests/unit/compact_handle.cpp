@@ -0,0 +1,147 @@
+#include "MemOx/object_pool.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+struct Component
+{
+    static inline int live = 0;
+
+    int value;
+    explicit Component(int v) : value(v) { ++live; }
+    ~Component() { --live; }
+};
+
+ObjectPool<Component> g_components(4);
+ObjectPool<Component> g_growable(2, GrowthPolicy::fixed_step(2, 8));
+
+using Compact = CompactPoolHandle<g_components>;
+using Index = PoolIndexHandle<g_components>;
+using GrowIndex = PoolIndexHandle<g_growable>;
+
+static_assert(sizeof(Compact) == sizeof(void*));
+static_assert(sizeof(Index) == sizeof(std::uint32_t));
+
+void test_compact_raii()
+{
+    {
+        auto h = Compact::emplace(7);
+        assert(h);
+        assert(h->value == 7);
+        assert(g_components.size() == 1);
+    }
+
+    assert(g_components.size() == 0);
+    assert(Component::live == 0);
+}
+
+void test_compact_move_and_reset()
+{
+    auto h1 = Compact::emplace(1);
+    auto* addr = h1.get();
+
+    Compact h2(std::move(h1));
+    assert(!h1);
+    assert(h2.get() == addr);
+
+    auto h3 = Compact::emplace(3);
+    h3 = std::move(h2);
+    assert(h3.get() == addr);
+    assert(g_components.size() == 1);
+
+    h3.reset();
+    assert(!h3);
+    assert(g_components.size() == 0);
+}
+
+void test_compact_from_pool_handle()
+{
+    auto handle = g_components.emplace(5);
+    auto* addr = handle.get();
+
+    Compact compact(std::move(handle));
+    assert(!handle);
+    assert(compact.get() == addr);
+    assert(g_components.size() == 1);
+
+    compact.reset();
+    assert(g_components.size() == 0);
+}
+
+void test_index_handle_in_vector()
+{
+    std::vector<Index> table;
+    for (int i = 0; i < 4; ++i)
+        table.push_back(Index::emplace(i * 10));
+
+    assert(g_components.size() == 4);
+    for (int i = 0; i < 4; ++i)
+    {
+        assert(table[i]->value == i * 10);
+        assert((*table[i]).value == i * 10);
+    }
+
+    // a freed index is reused through the pool's free list
+    const auto idx = table[2].index();
+    table[2].reset();
+    assert(!table[2]);
+
+    table[2] = Index::emplace(99);
+    assert(table[2].index() == idx);
+    assert(table[2]->value == 99);
+
+    table.clear();
+    assert(g_components.size() == 0);
+    assert(Component::live == 0);
+}
+
+void test_index_handle_exhaustion_throws()
+{
+    std::vector<Index> table;
+    for (int i = 0; i < 4; ++i)
+        table.push_back(Index::emplace(i));
+
+    bool thrown = false;
+    try {
+        auto h = Index::emplace(4);
+    }
+    catch (const std::runtime_error&) {
+        thrown = true;
+    }
+
+    assert(thrown);
+    assert(g_components.size() == 4);
+}
+
+void test_index_handle_on_grown_pool()
+{
+    std::vector<GrowIndex> table;
+    for (int i = 0; i < 8; ++i)
+        table.push_back(GrowIndex::emplace(i));
+
+    assert(g_growable.capacity() == 8);
+    for (int i = 0; i < 8; ++i)
+    {
+        assert(table[i].index() == static_cast<std::uint32_t>(i));
+        assert(table[i]->value == i);
+    }
+
+    table.clear();
+    assert(g_growable.size() == 0);
+}
+
+int main()
+{
+    test_compact_raii();
+    test_compact_move_and_reset();
+    test_compact_from_pool_handle();
+    test_index_handle_in_vector();
+    test_index_handle_exhaustion_throws();
+    test_index_handle_on_grown_pool();
+
+    std::cout << "[OK] compact_handle tests passed\n";
+    return 0;
+}
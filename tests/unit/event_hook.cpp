@@ -0,0 +1,134 @@
+#define OxiMemPool_EventHook
+#define OxiMemPool_NoLogging
+#include "MemOx/object_pool.hpp"
+
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+struct Recorded
+{
+    PoolEvent event;
+    const void* slot;
+    size_t index;
+};
+
+// Fixed storage: the hook itself must not allocate.
+static Recorded g_events[64];
+static size_t g_event_count = 0;
+static bool g_log_called = false;
+
+static void record(PoolEvent event, const void* slot, size_t index)
+{
+    if (g_event_count < 64)
+        g_events[g_event_count++] = Recorded{event, slot, index};
+}
+
+static void log_fn(const std::string&)
+{
+    g_log_called = true;
+}
+
+static void reset_events()
+{
+    g_event_count = 0;
+}
+
+void test_alloc_and_free_events()
+{
+    ObjectPool<int> pool(2);
+    pool.set_event_hook(&record);
+    reset_events();
+
+    auto h = pool.emplace(1);
+    assert(g_event_count == 1);
+    assert(g_events[0].event == PoolEvent::AllocNew);
+    assert(g_events[0].slot == h.get());
+    assert(g_events[0].index == 0);
+
+    const void* addr = h.get();
+    h.reset();
+    assert(g_event_count == 4);
+    assert(g_events[1].event == PoolEvent::HandleDestroy);
+    assert(g_events[2].event == PoolEvent::ObjectDestroy);
+    assert(g_events[3].event == PoolEvent::Free);
+    assert(g_events[3].slot == addr);
+    assert(g_events[3].index == 0);
+
+    auto h2 = pool.emplace(2);
+    assert(g_event_count == 5);
+    assert(g_events[4].event == PoolEvent::AllocReuse);
+    assert(g_events[4].index == 0);
+}
+
+void test_grow_and_shrink_events()
+{
+    ObjectPool<int> pool(1, GrowthPolicy::fixed_step(3, 4));
+    pool.set_event_hook(&record);
+
+    auto a = pool.emplace(1);
+    reset_events();
+
+    auto b = pool.emplace(2);
+    assert(g_event_count == 2);
+    assert(g_events[0].event == PoolEvent::Grow);
+    assert(g_events[0].index == 3);
+    assert(g_events[1].event == PoolEvent::AllocNew);
+    assert(g_events[1].index == 1);
+
+    b.reset();
+    reset_events();
+    assert(pool.shrink_to_fit() == 3);
+    assert(g_event_count == 1);
+    assert(g_events[0].event == PoolEvent::Shrink);
+    assert(g_events[0].index == 3);
+}
+
+void test_batch_events()
+{
+    ObjectPool<int> pool(8);
+    pool.set_event_hook(&record);
+    reset_events();
+
+    std::vector<PoolHandle<int>> handles;
+    pool.emplace_n(5, std::back_inserter(handles), 0);
+    assert(g_events[0].event == PoolEvent::AllocBulk);
+    assert(g_events[0].index == 5);
+
+    reset_events();
+    pool.release_bulk(handles.begin(), handles.end());
+    assert(g_events[g_event_count - 1].event == PoolEvent::FreeBatch);
+    assert(g_events[g_event_count - 1].index == 5);
+}
+
+void test_hook_can_be_disabled()
+{
+    ObjectPool<int> pool(1);
+    pool.set_event_hook(&record);
+    pool.set_event_hook(nullptr);
+    reset_events();
+
+    auto h = pool.emplace(1);
+    h.reset();
+    assert(g_event_count == 0);
+}
+
+void test_log_function_is_compiled_out()
+{
+    ObjectPool<int> pool(1, &log_fn);
+    auto h = pool.emplace(1);
+    h.reset();
+    assert(!g_log_called);
+}
+
+int main()
+{
+    test_alloc_and_free_events();
+    test_grow_and_shrink_events();
+    test_batch_events();
+    test_hook_can_be_disabled();
+    test_log_function_is_compiled_out();
+
+    std::cout << "[OK] event_hook tests passed\n";
+    return 0;
+}
@@ -0,0 +1,189 @@
+#include "MemOx/object_pool.hpp"
+
+#include <cassert>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+struct GrowItem
+{
+    static inline int live = 0;
+
+    int value;
+    explicit GrowItem(int v) : value(v) { ++live; }
+    ~GrowItem() { --live; }
+};
+
+void test_fixed_step_growth_keeps_addresses()
+{
+    ObjectPool<GrowItem> pool(2, GrowthPolicy::fixed_step(2, 6));
+
+    assert(pool.capacity() == 2);
+    assert(pool.max_capacity() == 6);
+
+    std::vector<PoolHandle<GrowItem>> handles;
+    std::vector<GrowItem*> addrs;
+    for (int i = 0; i < 6; ++i)
+    {
+        handles.push_back(pool.emplace(i));
+        addrs.push_back(handles.back().get());
+    }
+
+    assert(pool.capacity() == 6);
+    assert(pool.size() == 6);
+
+    // growing never moves existing objects
+    for (int i = 0; i < 6; ++i)
+    {
+        assert(handles[i].get() == addrs[i]);
+        assert(handles[i]->value == i);
+    }
+
+    bool thrown = false;
+    try {
+        auto h = pool.emplace(99);
+    }
+    catch (const std::runtime_error&) {
+        thrown = true;
+    }
+
+    assert(thrown);
+    assert(pool.capacity() == 6);
+}
+
+void test_geometric_growth_sizes()
+{
+    ObjectPool<GrowItem> pool(1, GrowthPolicy::geometric(10));
+
+    std::vector<PoolHandle<GrowItem>> handles;
+
+    handles.push_back(pool.emplace(0));
+    assert(pool.capacity() == 1);
+
+    handles.push_back(pool.emplace(1));
+    assert(pool.capacity() == 3);   // 1 + 2
+
+    handles.push_back(pool.emplace(2));
+    handles.push_back(pool.emplace(3));
+    assert(pool.capacity() == 7);   // 1 + 2 + 4
+
+    for (int i = 4; i < 10; ++i)
+        handles.push_back(pool.emplace(i));
+    assert(pool.capacity() == 10);  // last chunk clamped to max_capacity
+
+    for (int i = 0; i < 10; ++i)
+        assert(handles[i]->value == i);
+}
+
+void test_reuse_before_growth()
+{
+    ObjectPool<GrowItem> pool(2, GrowthPolicy::fixed_step(2, 8));
+
+    auto h1 = pool.emplace(1);
+    auto h2 = pool.emplace(2);
+    auto* addr1 = h1.get();
+
+    h1.reset();
+
+    auto h3 = pool.emplace(3);
+    assert(h3.get() == addr1);
+    assert(pool.capacity() == 2);
+}
+
+void test_shrink_releases_only_free_chunks()
+{
+    ObjectPool<GrowItem> pool(2, GrowthPolicy::fixed_step(2, 8));
+
+    std::vector<PoolHandle<GrowItem>> handles;
+    for (int i = 0; i < 8; ++i)
+        handles.push_back(pool.emplace(i));
+    assert(pool.capacity() == 8);
+
+    // nothing is free yet
+    assert(pool.shrink_to_fit() == 0);
+
+    // empty the second chunk (slots 2,3) and half of the last one (slot 6)
+    handles[2].reset();
+    handles[3].reset();
+    handles[6].reset();
+
+    assert(pool.shrink_to_fit() == 2);
+    assert(pool.capacity() == 6);
+
+    // the remaining objects are untouched
+    for (int i : {0, 1, 4, 5, 7})
+        assert(handles[i]->value == i);
+
+    // empty the last chunk: it is released from the end of the index space
+    handles[7].reset();
+    assert(pool.shrink_to_fit() == 2);
+    assert(pool.capacity() == 4);
+
+    // objects in the initial block are never released
+    handles[0].reset();
+    handles[1].reset();
+    assert(pool.shrink_to_fit() == 0);
+    assert(pool.capacity() == 4);
+
+    // the pool can grow again up to its cap
+    std::vector<PoolHandle<GrowItem>> more;
+    while (pool.size() < pool.max_capacity())
+        more.push_back(pool.emplace(100));
+
+    assert(pool.capacity() == 8);
+    assert(handles[4]->value == 4);
+    assert(handles[5]->value == 5);
+}
+
+void test_shrink_untouched_tail_chunk()
+{
+    ObjectPool<GrowItem> pool(1, GrowthPolicy::fixed_step(4, 5));
+
+    auto a = pool.emplace(1);
+    auto b = pool.emplace(2); // grows, touches one slot of the new chunk
+    assert(pool.capacity() == 5);
+
+    b.reset();
+    assert(pool.shrink_to_fit() == 4);
+    assert(pool.capacity() == 1);
+
+    auto c = pool.emplace(3);
+    assert(c);
+    assert(pool.capacity() == 5);
+}
+
+void test_invalid_policy_throws()
+{
+    bool thrown = false;
+    try {
+        ObjectPool<GrowItem> pool(4, GrowthPolicy::fixed_step(0, 8));
+    }
+    catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    thrown = false;
+    try {
+        ObjectPool<GrowItem> pool(4, GrowthPolicy::geometric(2));
+    }
+    catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+}
+
+int main()
+{
+    test_fixed_step_growth_keeps_addresses();
+    test_geometric_growth_sizes();
+    test_reuse_before_growth();
+    test_shrink_releases_only_free_chunks();
+    test_shrink_untouched_tail_chunk();
+    test_invalid_policy_throws();
+
+    assert(GrowItem::live == 0);
+
+    std::cout << "[OK] growth tests passed\n";
+    return 0;
+}
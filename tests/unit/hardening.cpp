@@ -0,0 +1,244 @@
+#define OxiMemPool_Hardened
+#define OxiMemPool_ErrCallback
+#include "MemOx/polymorphic_pool.hpp"
+
+#include <cassert>
+#include <csignal>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+struct Record
+{
+    long fields[4];
+    explicit Record(long v) : fields{v, v, v, v} {}
+};
+
+template <>
+struct PoolSlotLayout<std::uint32_t>
+{
+    static constexpr SlotLayout value = SlotLayout::Dense;
+};
+
+constexpr PoolThreading kST = PoolThreading::SingleThread;
+using Pool = ObjectPool<Record, kST>;
+
+// The error callback runs before the pool aborts; it reports the code as the
+// exit status of the child process.
+static void exit_with_code(const char*, size_t code) { _exit(100 + static_cast<int>(code)); }
+
+template <typename Fn>
+static int child_status(Fn fn, bool with_callback = true)
+{
+    std::cout.flush();
+    const pid_t pid = fork();
+    assert(pid >= 0);
+    if (pid == 0)
+    {
+        fn(with_callback ? exit_with_code : nullptr);
+        _exit(0); // not detected
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return status;
+}
+
+template <typename Fn>
+static void expect_failure(size_t code, Fn fn)
+{
+    const int status = child_status(fn);
+    assert(WIFEXITED(status) && WEXITSTATUS(status) == 100 + static_cast<int>(code));
+}
+
+void test_slots_carry_a_guard_word()
+{
+    static_assert(Pool::slot_size == sizeof(Record) + sizeof(std::uint64_t));
+    static_assert(ObjectPool<std::uint32_t, kST>::slot_size == 16); // 4-byte link, guard aligned to 8
+}
+
+void test_normal_use_passes()
+{
+    ObjectPool<Record, PoolThreading::Mutex> pool(64, GrowthPolicy::fixed_step(64, 256));
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&pool] {
+            std::vector<PoolHandle<Record, PoolThreading::Mutex>> local;
+            for (int i = 0; i < 5000; ++i)
+            {
+                local.push_back(pool.emplace(i));
+                if (local.size() > 40)
+                    local.erase(local.begin(), local.begin() + 20);
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+
+    std::vector<PoolHandle<Record, PoolThreading::Mutex>> batch;
+    pool.emplace_n(32, std::back_inserter(batch), 7L);
+    pool.release_bulk(batch.begin(), batch.end());
+
+    Record* raw = pool.try_allocate_storage();
+    assert(raw);
+    pool.deallocate_storage(raw);
+
+    std::vector<PoolHandle<Record, PoolThreading::Mutex>> kept;
+    for (int i = 0; i < 16; ++i)
+        kept.push_back(pool.emplace(i));
+    kept.erase(kept.begin(), kept.begin() + 8);
+    pool.compact(kept.begin(), kept.end());
+    for (size_t i = 0; i < kept.size(); ++i)
+        assert(kept[i]->fields[3] == static_cast<long>(i) + 8);
+}
+
+void test_double_free_is_detected()
+{
+    expect_failure(7, [](ErrorCallback cb) {
+        Pool pool(4);
+        pool.set_error_callback(cb);
+        Record* r = pool.emplace_unowned(1);
+        pool.destroy_unowned(r);
+        pool.destroy_unowned(r);
+    });
+
+    expect_failure(7, [](ErrorCallback cb) {
+        Pool pool(4);
+        pool.set_error_callback(cb);
+        Record outside(1);
+        pool.destroy_unowned(&outside);
+    });
+}
+
+void test_failure_aborts_after_the_callback()
+{
+    const int status = child_status([](ErrorCallback) {
+        Pool pool(4);
+        Record* r = pool.emplace_unowned(1);
+        pool.destroy_unowned(r);
+        pool.destroy_unowned(r);
+    }, false);
+    assert(WIFSIGNALED(status) && WTERMSIG(status) == SIGABRT);
+}
+
+#ifndef OxiMemPool_AsanPoisoning
+// Sanitizer builds report these accesses themselves.
+
+void test_freed_slots_are_poisoned()
+{
+    Pool pool(4);
+    Record* r = pool.emplace_unowned(0x1111);
+    pool.destroy_unowned(r);
+
+    unsigned char bytes[sizeof(Record)];
+    std::memcpy(bytes, r, sizeof(Record)); // stale read, for the test only
+    for (size_t i = sizeof(void*); i < sizeof(Record); ++i)
+        assert(bytes[i] == 0xDD);
+}
+
+void test_overflow_is_detected()
+{
+    expect_failure(8, [](ErrorCallback cb) {
+        Pool pool(4);
+        pool.set_error_callback(cb);
+        auto a = pool.emplace(1);
+        auto b = pool.emplace(2);
+        auto* bytes = reinterpret_cast<unsigned char*>(a.get());
+        bytes[sizeof(Record)] ^= 0xFF; // one byte past the object
+        a.reset();
+    });
+}
+
+struct Shape
+{
+    long id;
+    explicit Shape(long i) : id(i) {}
+};
+
+struct Circle : Shape
+{
+    double radius;
+    explicit Circle(long i) : Shape(i), radius(1.0) {}
+};
+
+using ShapePool = PolymorphicPoolWith<kST, Shape, Circle>;
+
+void test_polymorphic_objects_are_checked()
+{
+    ShapePool pool(4);
+    auto a = pool.emplace<Circle>(1);
+    auto b = pool.emplace<Shape>(2);
+    size_t occupied = 0;
+    pool.pool().for_each([&](ShapePool::storage_type&) { ++occupied; });
+    assert(occupied == 2);
+
+    expect_failure(8, [](ErrorCallback cb) {
+        ShapePool p(4);
+        p.pool().set_error_callback(cb);
+        auto c = p.emplace<Circle>(3);
+        auto* bytes = reinterpret_cast<unsigned char*>(c.get());
+        bytes[sizeof(ShapePool::storage_type)] ^= 0xFF; // one byte past the slot
+        c.reset();
+    });
+}
+
+void test_corrupted_link_is_detected()
+{
+    // A write through a dangling pointer clobbers the free-list link.
+    expect_failure(6, [](ErrorCallback cb) {
+        Pool pool(4);
+        pool.set_error_callback(cb);
+        Record* r = pool.emplace_unowned(1);
+        pool.destroy_unowned(r);
+        r->fields[0] = 0x4242;
+        (void)pool.emplace(2);
+    });
+
+    // Same for index links (dense and lock-free pools).
+    expect_failure(6, [](ErrorCallback cb) {
+        ObjectPool<std::uint32_t, PoolThreading::LockFree> pool(4);
+        pool.set_error_callback(cb);
+        std::uint32_t* v = pool.emplace_unowned(1u);
+        pool.destroy_unowned(v);
+        *v = 0xFFFF;
+        (void)pool.emplace(2u);
+    });
+}
+
+void test_link_to_a_live_slot_is_detected()
+{
+    expect_failure(6, [](ErrorCallback cb) {
+        Pool pool(4);
+        pool.set_error_callback(cb);
+        Record* a = pool.emplace_unowned(1);
+        Record* b = pool.emplace_unowned(2);
+        pool.destroy_unowned(a);
+        std::memcpy(static_cast<void*>(a), &b, sizeof(b)); // link now points at the live object
+        Record* first = pool.emplace_unowned(3);
+        assert(first == a);
+        (void)pool.emplace_unowned(4);
+    });
+}
+#endif
+
+int main()
+{
+    test_slots_carry_a_guard_word();
+    test_normal_use_passes();
+    test_double_free_is_detected();
+    test_failure_aborts_after_the_callback();
+#ifndef OxiMemPool_AsanPoisoning
+    test_freed_slots_are_poisoned();
+    test_overflow_is_detected();
+    test_corrupted_link_is_detected();
+    test_link_to_a_live_slot_is_detected();
+    test_polymorphic_objects_are_checked();
+#endif
+
+    std::cout << "[OK] hardening tests passed\n";
+    return 0;
+}
@@ -0,0 +1,211 @@
+#define OxiMemPool_LockFree
+#include "MemOx/object_pool.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+struct LockFreeObject
+{
+    static inline std::atomic<int> live{0};
+
+    int value;
+    explicit LockFreeObject(int v) : value(v) { live.fetch_add(1, std::memory_order_relaxed); }
+    ~LockFreeObject() { live.fetch_sub(1, std::memory_order_relaxed); }
+};
+
+void test_single_thread_lifo_reuse()
+{
+    ObjectPool<LockFreeObject> pool(3);
+
+    auto h1 = pool.emplace(1);
+    auto h2 = pool.emplace(2);
+    auto h3 = pool.emplace(3);
+
+    auto* addr1 = h1.get();
+    auto* addr2 = h2.get();
+    auto* addr3 = h3.get();
+
+    h1.reset();
+    h2.reset();
+    h3.reset();
+
+    auto a = pool.emplace(10);
+    auto b = pool.emplace(20);
+    auto c = pool.emplace(30);
+
+    // free list stays LIFO in lock-free mode
+    assert(a.get() == addr3);
+    assert(b.get() == addr2);
+    assert(c.get() == addr1);
+    assert(pool.size() == 3);
+}
+
+void test_exhaustion_throws()
+{
+    ObjectPool<LockFreeObject> pool(1);
+
+    auto h1 = pool.emplace(1);
+
+    bool thrown = false;
+    try {
+        auto h2 = pool.emplace(2);
+    }
+    catch (const std::runtime_error&) {
+        thrown = true;
+    }
+
+    assert(thrown);
+    assert(pool.size() == 1);
+
+    h1.reset();
+
+    // the slot is still reachable after a failed bump
+    auto h3 = pool.emplace(3);
+    assert(h3);
+}
+
+void test_parallel_churn()
+{
+    constexpr int kThreads = 8;
+    constexpr int kIterations = 20'000;
+    constexpr int kCapacity = 16;
+
+    ObjectPool<LockFreeObject> pool(kCapacity);
+
+    std::atomic<bool> start{false};
+    std::atomic<int> failures{0};
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < kThreads; ++t)
+    {
+        threads.emplace_back([&, t] {
+            while (!start.load(std::memory_order_acquire)) {}
+
+            std::vector<PoolHandle<LockFreeObject>> held;
+            for (int i = 0; i < kIterations; ++i)
+            {
+                try
+                {
+                    auto h = pool.emplace(t * 100000 + i);
+                    assert(h->value == t * 100000 + i);
+
+                    if (i % 3 == 0)
+                        held.push_back(std::move(h));
+                    if (held.size() > 2)
+                        held.erase(held.begin());
+                }
+                catch (const std::runtime_error&)
+                {
+                    failures.fetch_add(1, std::memory_order_relaxed);
+                }
+
+                assert(pool.size() <= kCapacity);
+            }
+        });
+    }
+
+    start.store(true, std::memory_order_release);
+
+    for (auto& th : threads)
+        th.join();
+
+    assert(pool.size() == 0);
+    assert(LockFreeObject::live.load() == 0);
+}
+
+void test_distinct_slots_under_contention()
+{
+    constexpr int kThreads = 4;
+    constexpr int kCapacity = 64;
+
+    ObjectPool<LockFreeObject> pool(kCapacity);
+
+    std::atomic<bool> start{false};
+    std::vector<std::vector<PoolHandle<LockFreeObject>>> per_thread(kThreads);
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < kThreads; ++t)
+    {
+        threads.emplace_back([&, t] {
+            while (!start.load(std::memory_order_acquire)) {}
+
+            for (int i = 0; i < kCapacity / kThreads; ++i)
+                per_thread[t].push_back(pool.emplace(i));
+        });
+    }
+
+    start.store(true, std::memory_order_release);
+
+    for (auto& th : threads)
+        th.join();
+
+    std::vector<LockFreeObject*> addrs;
+    for (auto& v : per_thread)
+        for (auto& h : v)
+            addrs.push_back(h.get());
+
+    for (size_t i = 0; i < addrs.size(); ++i)
+        for (size_t j = i + 1; j < addrs.size(); ++j)
+            assert(addrs[i] != addrs[j]);
+
+    assert(pool.size() == kCapacity);
+}
+
+void test_parallel_growth()
+{
+    constexpr int kThreads = 6;
+    constexpr int kPerThread = 200;
+    constexpr size_t kMax = kThreads * kPerThread;
+
+    ObjectPool<LockFreeObject> pool(4, GrowthPolicy::fixed_step(16, kMax));
+
+    std::atomic<bool> start{false};
+    std::vector<std::vector<PoolHandle<LockFreeObject>>> per_thread(kThreads);
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < kThreads; ++t)
+    {
+        threads.emplace_back([&, t] {
+            while (!start.load(std::memory_order_acquire)) {}
+
+            for (int i = 0; i < kPerThread; ++i)
+            {
+                per_thread[t].push_back(pool.emplace(t * 1000 + i));
+                if (i % 5 == 0)
+                    per_thread[t].pop_back();
+            }
+        });
+    }
+
+    start.store(true, std::memory_order_release);
+
+    for (auto& th : threads)
+        th.join();
+
+    for (int t = 0; t < kThreads; ++t)
+        for (auto& h : per_thread[t])
+            assert(h->value / 1000 == t);
+
+    assert(pool.capacity() <= kMax);
+
+    per_thread.clear();
+    assert(pool.size() == 0);
+
+    pool.shrink_to_fit();
+    assert(pool.capacity() == 4);
+}
+
+int main()
+{
+    test_single_thread_lifo_reuse();
+    test_exhaustion_throws();
+    test_parallel_churn();
+    test_distinct_slots_under_contention();
+    test_parallel_growth();
+
+    std::cout << "[OK] lock_free tests passed\n";
+    return 0;
+}
@@ -0,0 +1,276 @@
+#define OxiMemPool_ErrCallback
+#define OxiMemPool_Occupancy
+#include "MemOx/mapped_pool.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+struct Record
+{
+    std::uint64_t key;
+    std::uint32_t hits;
+    char name[20];
+};
+
+// Record with index links without LockFree.
+struct DenseRecord
+{
+    std::uint64_t key;
+    std::uint32_t hits;
+    char name[20];
+};
+
+template <>
+struct PoolSlotLayout<DenseRecord>
+{
+    static constexpr SlotLayout value = SlotLayout::Dense;
+};
+
+struct Counter
+{
+    std::uint32_t value;
+};
+
+template <>
+struct PoolSlotLayout<Counter>
+{
+    static constexpr SlotLayout value = SlotLayout::Dense;
+};
+
+constexpr PoolThreading kLF = PoolThreading::LockFree;
+
+static_assert(ObjectPool<Record, kLF>::supports_image);
+static_assert(ObjectPool<Counter, PoolThreading::SingleThread>::supports_image);
+static_assert(!ObjectPool<Record, PoolThreading::SingleThread>::supports_image); // pointer links
+static_assert(!ObjectPool<std::string, kLF>::supports_image);
+
+static std::string image_path(const char* name)
+{
+    return "/tmp/oxi_mapped_pool_" + std::to_string(::getpid()) + "_" + name;
+}
+
+template <typename R = Record>
+static R make_record(std::uint64_t key)
+{
+    R r{key, static_cast<std::uint32_t>(key * 3), {}};
+    std::snprintf(r.name, sizeof(r.name), "rec-%llu", static_cast<unsigned long long>(key));
+    return r;
+}
+
+void test_buffer_image_is_position_independent()
+{
+    using Pool = ObjectPool<Counter, PoolThreading::SingleThread>;
+    alignas(Pool::slot_align) std::byte a[64 * Pool::slot_size];
+    alignas(Pool::slot_align) std::byte b[64 * Pool::slot_size];
+
+    PoolImageState state;
+    std::vector<size_t> live;
+    size_t next_free = 0;
+    {
+        Pool pool{std::span<std::byte>(a)};
+        std::vector<Counter*> objects;
+        for (std::uint32_t i = 0; i < 40; ++i)
+            objects.push_back(pool.emplace_unowned(Counter{i}));
+        for (size_t i : {3u, 17u, 9u, 30u})
+            pool.destroy_unowned(objects[i]);
+        next_free = static_cast<size_t>(reinterpret_cast<const std::byte*>(pool.peek_next_slot()) - a) /
+                    Pool::slot_size;
+        state = pool.detach_image();
+    }
+    assert(state.live == 36 && state.bump == 40 && state.free_head == next_free + 1);
+
+    // The same bytes at another address.
+    std::memcpy(b, a, sizeof(a));
+    Pool pool(std::span<std::byte>(b), state);
+    assert(pool.size() == 36);
+
+    std::set<std::uint32_t> values;
+    pool.for_each([&](Counter& c) { values.insert(c.value); });
+    assert(values.size() == 36 && !values.count(3) && !values.count(30));
+
+    // Freed slots come back first, in the original LIFO order.
+    for (size_t expected : {30u, 9u, 17u, 3u})
+    {
+        Counter* c = pool.emplace_unowned(Counter{100});
+        assert(reinterpret_cast<std::byte*>(c) == b + expected * Pool::slot_size);
+    }
+    assert(reinterpret_cast<std::byte*>(pool.emplace_unowned(Counter{101})) == b + 40 * Pool::slot_size);
+    pool.release_all();
+}
+
+void test_inconsistent_state_is_rejected()
+{
+    using Pool = ObjectPool<Record, kLF>;
+    alignas(Pool::slot_align) std::byte buffer[16 * Pool::slot_size];
+    PoolImageState state;
+    {
+        Pool pool{std::span<std::byte>(buffer)};
+        Record* a = pool.emplace_unowned(make_record(1));
+        (void)pool.emplace_unowned(make_record(2));
+        pool.destroy_unowned(a);
+        state = pool.detach_image();
+    }
+
+    PoolImageState wrong = state;
+    wrong.live = 2; // the free list holds one slot more than that allows
+    bool thrown = false;
+    try {
+        Pool pool(std::span<std::byte>(buffer), wrong);
+    }
+    catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    wrong = state;
+    wrong.bump = 17;
+    thrown = false;
+    try {
+        Pool pool(std::span<std::byte>(buffer), wrong);
+    }
+    catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    Pool pool(std::span<std::byte>(buffer), state);
+    assert(pool.size() == 1);
+    pool.release_all();
+}
+
+template <typename R, PoolThreading Threading>
+void test_restart_keeps_objects_and_free_list()
+{
+    const std::string path = image_path("restart");
+    ::unlink(path.c_str());
+
+    std::vector<size_t> kept;
+    size_t next_free = 0;
+    {
+        MappedObjectPool<R, Threading> pool(path, 1000, 42);
+        assert(pool.created());
+        std::vector<R*> records;
+        for (std::uint64_t key = 0; key < 600; ++key)
+            records.push_back(pool.emplace_unowned(make_record<R>(key)));
+        for (std::uint64_t key = 0; key < 600; key += 3)
+            pool.destroy_unowned(records[key]);
+        for (std::uint64_t key = 1; key < 600; key += 3)
+            kept.push_back(pool.index_of(records[key]));
+        next_free = pool.index_of(static_cast<const R*>(pool.peek_next_slot()));
+        (void)next_free;
+    }
+
+    // A new process attaches to the image.
+    const pid_t pid = ::fork();
+    assert(pid >= 0);
+    if (pid == 0)
+    {
+        bool ok = false;
+        {
+            MappedObjectPool<R, Threading> pool(path, 1000, 42);
+            ok = !pool.created() && pool.size() == 400;
+            for (size_t i = 0; i < kept.size(); ++i)
+            {
+                const R* r = pool.at(kept[i]);
+                const std::uint64_t key = 1 + 3 * i;
+                ok = ok && r->key == key && r->hits == key * 3 && std::string(r->name) == make_record<R>(key).name;
+            }
+            R* reused = pool.emplace_unowned(make_record<R>(9999));
+#ifndef OxiMemPool_ThreadCache
+            ok = ok && pool.index_of(reused) == next_free; // freed slots first
+#endif
+            (void)reused;
+        }
+        ::_exit(ok ? 0 : 1);
+    }
+    int status = 0;
+    ::waitpid(pid, &status, 0);
+    assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+    // The child's changes are in the image as well.
+    {
+        MappedObjectPool<R, Threading> pool(path, 1000, 42);
+        assert(pool.size() == 401);
+        size_t visited = 0, reused = 0;
+        pool.for_each([&](R& r) { ++visited; reused += r.key == 9999; });
+        assert(visited == 401 && reused == 1);
+        pool.release_all();
+    }
+    ::unlink(path.c_str());
+}
+
+template <typename Fn>
+static bool throws_runtime_error(Fn fn)
+{
+    try {
+        fn();
+    }
+    catch (const std::system_error&) {
+        return false;
+    }
+    catch (const std::runtime_error&) {
+        return true;
+    }
+    return false;
+}
+
+void test_incompatible_images_are_rejected()
+{
+    using Pool = MappedObjectPool<Record, kLF>;
+    const std::string path = image_path("incompatible");
+    ::unlink(path.c_str());
+    {
+        Pool pool(path, 100, 1);
+        (void)pool.emplace_unowned(make_record(1));
+
+        // Attached already (flock is per open file, so this holds in-process too).
+        bool locked = false;
+        try {
+            Pool other(path, 100, 1);
+        }
+        catch (const std::system_error&) {
+            locked = true;
+        }
+        assert(locked);
+    }
+
+    assert(throws_runtime_error([&] { Pool pool(path, 200, 1); }));  // other capacity
+    assert(throws_runtime_error([&] { Pool pool(path, 100, 2); }));  // other tag
+    assert(throws_runtime_error([&] { MappedObjectPool<Counter, kLF> pool(path, 100, 1); }));
+
+    // A process that dies while attached leaves the image unclean.
+    const pid_t pid = ::fork();
+    if (pid == 0)
+    {
+        Pool pool(path, 100, 1);
+        (void)pool.emplace_unowned(make_record(2));
+        ::_exit(0); // no destructor
+    }
+    int status = 0;
+    ::waitpid(pid, &status, 0);
+    assert(throws_runtime_error([&] { Pool pool(path, 100, 1); }));
+    ::unlink(path.c_str());
+}
+
+int main()
+{
+    test_buffer_image_is_position_independent();
+    test_inconsistent_state_is_rejected();
+    test_restart_keeps_objects_and_free_list<Record, PoolThreading::LockFree>();
+    test_restart_keeps_objects_and_free_list<DenseRecord, PoolThreading::OwnerThread>();
+    test_incompatible_images_are_rejected();
+
+    std::cout << "[OK] mapped_pool tests passed\n";
+    return 0;
+}
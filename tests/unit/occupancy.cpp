@@ -0,0 +1,195 @@
+#define OxiMemPool_Occupancy
+#include "MemOx/object_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+struct Position
+{
+    int x;
+    int y;
+    Position(int px, int py) : x(px), y(py) {}
+};
+
+template <typename Pool>
+static std::vector<int> visited_x(const Pool& pool)
+{
+    std::vector<int> xs;
+    pool.for_each([&](const Position& p) { xs.push_back(p.x); });
+    return xs;
+}
+
+template <PoolThreading Threading>
+void test_for_each_skips_free_slots()
+{
+    ObjectPool<Position, Threading> pool(200);
+    std::vector<typename ObjectPool<Position, Threading>::handle_type> handles;
+    for (int i = 0; i < 150; ++i)
+        handles.push_back(pool.emplace(i, -i));
+
+    // Free every third object, including whole runs across word boundaries.
+    for (int i = 0; i < 150; ++i)
+        if (i % 3 == 0 || (i >= 60 && i < 130))
+            handles[i].reset();
+
+    std::vector<int> expected;
+    for (int i = 0; i < 150; ++i)
+        if (handles[i])
+            expected.push_back(i);
+
+    // Address order equals allocation order for a fresh pool.
+    std::vector<const Position*> addresses;
+    pool.for_each([&](const Position& p) { addresses.push_back(&p); });
+    assert(std::is_sorted(addresses.begin(), addresses.end()));
+
+    std::vector<int> xs = visited_x(pool);
+    std::sort(xs.begin(), xs.end());
+    assert(xs == expected);
+    assert(xs.size() == pool.size());
+
+    // fn may modify the objects.
+    pool.for_each([](Position& p) { p.y = p.x * 2; });
+    for (const auto& h : handles)
+        if (h)
+            assert(h->y == h->x * 2);
+}
+
+void test_for_each_bulk_unowned_and_release_all()
+{
+    ObjectPool<Position> pool(64);
+    std::vector<PoolHandle<Position>> handles;
+    pool.emplace_n(10, std::back_inserter(handles), 1, 0);
+    Position* loose = pool.emplace_unowned(2, 0);
+    Position* raw = pool.try_allocate_storage(); // raw storage is never visited
+    assert(raw != nullptr);
+
+    int ones = 0;
+    int twos = 0;
+    pool.for_each([&](const Position& p) { (p.x == 1 ? ones : twos) += 1; });
+    assert(ones == 10 && twos == 1);
+
+    pool.release_bulk(handles.begin(), handles.begin() + 4);
+    pool.destroy_unowned(loose);
+    ones = 0;
+    pool.for_each([&](const Position&) { ++ones; });
+    assert(ones == 6);
+
+    handles.clear();
+    assert(visited_x(pool).empty());
+    pool.deallocate_storage(raw); // release_all() rejects outstanding raw storage
+
+    for (int i = 0; i < 5; ++i)
+        pool.emplace_unowned(i, i);
+    pool.release_all();
+    assert(pool.size() == 0);
+    assert(visited_x(pool).empty());
+
+    pool.emplace_unowned(7, 7);
+    assert(visited_x(pool) == std::vector<int>{7});
+    pool.release_all();
+}
+
+void test_for_each_growth_and_shrink()
+{
+    ObjectPool<Position> pool(4, GrowthPolicy::fixed_step(4, 32));
+    std::vector<PoolHandle<Position>> handles;
+    for (int i = 0; i < 20; ++i)
+        handles.push_back(pool.emplace(i, 0));
+
+    // Empty the second chunk (indices 8..11) and release it.
+    for (int i = 8; i < 12; ++i)
+        handles[i].reset();
+    assert(pool.shrink_to_fit() == 4);
+
+    std::vector<int> expected;
+    for (int i = 0; i < 20; ++i)
+        if (handles[i])
+            expected.push_back(i);
+    assert(visited_x(pool) == expected);
+}
+
+template <PoolThreading Threading>
+void test_parallel_for_each()
+{
+    ObjectPool<Position, Threading> pool(50000);
+    std::vector<typename ObjectPool<Position, Threading>::handle_type> handles;
+    for (int i = 0; i < 50000; ++i)
+        handles.push_back(pool.emplace(i, 0));
+    for (int i = 0; i < 50000; i += 7)
+        handles[i].reset();
+
+    std::vector<std::thread> workers;
+    auto spawn = [&](auto task) { workers.emplace_back(std::move(task)); };
+
+    pool.parallel_for_each([](Position& p) { p.y += 1; }, spawn, 8);
+    for (auto& t : workers) t.join();
+    workers.clear();
+
+    std::atomic<long long> sum{0};
+    pool.parallel_for_each([&](const Position& p) { sum += p.x; }, spawn);
+    for (auto& t : workers) t.join();
+    workers.clear();
+
+    long long expected = 0;
+    for (const auto& h : handles)
+        if (h)
+        {
+            assert(h->y == 1); // visited exactly once
+            expected += h->x;
+        }
+    assert(sum == expected);
+
+    // An inline executor works as well; exceptions reach the caller.
+    bool thrown = false;
+    try {
+        pool.parallel_for_each([](Position& p) {
+            if (p.x == 40000)
+                throw std::runtime_error("stop");
+        }, [](auto task) { task(); }, 4);
+    }
+    catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+}
+
+void test_concurrent_churn_keeps_bitmap_consistent()
+{
+    ObjectPool<Position, PoolThreading::Mutex> pool(4096);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&pool, t] {
+            std::vector<PoolHandle<Position, PoolThreading::Mutex>> local;
+            for (int round = 0; round < 2000; ++round)
+            {
+                local.push_back(pool.emplace(t, round));
+                if (round % 3 != 0)
+                    local.erase(local.begin());
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+    assert(visited_x(pool).empty());
+    assert(pool.size() == 0);
+}
+
+int main()
+{
+    test_for_each_skips_free_slots<PoolThreading::SingleThread>();
+    test_for_each_skips_free_slots<PoolThreading::Mutex>();
+    test_for_each_skips_free_slots<PoolThreading::LockFree>();
+    test_for_each_bulk_unowned_and_release_all();
+    test_for_each_growth_and_shrink();
+    test_parallel_for_each<PoolThreading::Mutex>();
+    test_parallel_for_each<PoolThreading::LockFree>();
+    test_concurrent_churn_keeps_bitmap_consistent();
+
+    std::cout << "[OK] occupancy tests passed\n";
+    return 0;
+}
@@ -0,0 +1,262 @@
+#define OxiMemPool_EventHook
+#include "MemOx/object_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct Packet
+{
+    static inline std::atomic<int> live{0};
+
+    int id;
+    explicit Packet(int i) : id(i) { ++live; }
+    ~Packet() { --live; }
+};
+
+// Pointer-sized, so that slot i is at base + i.
+struct LowPacket
+{
+    long id;
+    explicit LowPacket(long i) : id(i) {}
+};
+
+template <>
+struct PoolReusePolicy<LowPacket>
+{
+    static constexpr ReusePolicy value = ReusePolicy::LowestAddress;
+};
+
+constexpr PoolThreading kOwner = PoolThreading::OwnerThread;
+using Pool = ObjectPool<Packet, kOwner>;
+using Handle = PoolHandle<Packet, kOwner>;
+
+static std::atomic<size_t> g_reclaimed{0};
+static std::atomic<size_t> g_reclaims{0};
+static void count_reclaims(PoolEvent event, const void*, size_t index)
+{
+    if (event == PoolEvent::RemoteReclaim)
+    {
+        g_reclaims += 1;
+        g_reclaimed += index;
+    }
+}
+
+// Destroys `handles` on another thread.
+template <typename H>
+static void destroy_remotely(std::vector<H>& handles)
+{
+    std::thread([&handles] { handles.clear(); }).join();
+}
+
+void test_owner_frees_stay_local()
+{
+    Pool pool(4);
+    auto a = pool.emplace(1);
+    Packet* addr = a.get();
+    a.reset();
+    auto b = pool.emplace(2);
+    assert(b.get() == addr);
+    assert(pool.size() == 1);
+}
+
+void test_remote_frees_are_reclaimed_when_the_free_list_runs_dry()
+{
+    Pool pool(8);
+    pool.set_event_hook(count_reclaims);
+    g_reclaims = 0;
+    g_reclaimed = 0;
+
+    std::vector<Handle> handles;
+    for (int i = 0; i < 8; ++i)
+        handles.push_back(pool.emplace(i));
+    Packet* local = handles[0].get();
+
+    // Six objects die on another thread, one on the owner.
+    std::vector<Handle> remote(std::make_move_iterator(handles.begin() + 2), std::make_move_iterator(handles.end()));
+    handles.erase(handles.begin() + 2, handles.end());
+    destroy_remotely(remote);
+    assert(pool.size() == 2 && Packet::live == 2);
+    handles[0].reset();
+    assert(g_reclaims == 0);
+
+    // The owner's own free list is used first, then the remote list is taken at once.
+    auto first = pool.emplace(10);
+    assert(first.get() == local);
+    assert(g_reclaims == 0);
+
+    std::vector<Handle> again;
+    for (int i = 0; i < 6; ++i)
+        again.push_back(pool.emplace(20 + i));
+    assert(g_reclaims == 1 && g_reclaimed == 6);
+    assert(pool.size() == 8);
+    assert(!pool.try_emplace(0)); // no growth, nothing lost
+
+    pool.set_event_hook(nullptr);
+}
+
+void test_remote_release_bulk()
+{
+    Pool pool(64);
+    std::vector<Handle> handles;
+    pool.emplace_n(64, std::back_inserter(handles), 7);
+
+    std::thread([&] { pool.release_bulk(handles.begin(), handles.end()); }).join();
+    assert(pool.size() == 0 && Packet::live == 0);
+
+    std::vector<Handle> again;
+    for (int i = 0; i < 64; ++i)
+        again.push_back(pool.emplace(i));
+    assert(!pool.try_emplace(0));
+}
+
+void test_set_owner_thread()
+{
+    Pool pool(16);
+    std::vector<Handle> made;
+    std::thread([&] {
+        pool.set_owner_thread();
+        for (int i = 0; i < 16; ++i)
+            made.push_back(pool.emplace(i));
+    }).join();
+
+    // The constructing thread is now a remote thread.
+    made.clear();
+    assert(pool.size() == 0);
+    std::thread([&] {
+        pool.set_owner_thread();
+        std::vector<Handle> again;
+        for (int i = 0; i < 16; ++i)
+            again.push_back(pool.emplace(i));
+    }).join();
+    pool.set_owner_thread();
+}
+
+void test_producer_consumer()
+{
+    constexpr int kConsumers = 3;
+    constexpr int kObjects = 60000;
+
+    Pool pool(256);
+    std::mutex queue_mutex;
+    std::vector<Handle> queue;
+    bool done = false;
+    std::atomic<int> consumed{0};
+
+    std::vector<std::thread> consumers;
+    for (int t = 0; t < kConsumers; ++t)
+    {
+        consumers.emplace_back([&] {
+            std::vector<Handle> taken;
+            for (;;)
+            {
+                {
+                    std::lock_guard<std::mutex> g(queue_mutex);
+                    if (queue.empty() && done)
+                        return;
+                    taken.swap(queue);
+                }
+                if (taken.empty())
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+                for (const Handle& h : taken)
+                    assert(h->id >= 0);
+                consumed += static_cast<int>(taken.size());
+                taken.clear();
+            }
+        });
+    }
+
+    // The owner only ever allocates; every free is remote.
+    for (int i = 0; i < kObjects;)
+    {
+        Handle h = pool.try_emplace(i);
+        if (!h)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        std::lock_guard<std::mutex> g(queue_mutex);
+        queue.push_back(std::move(h));
+        ++i;
+    }
+    {
+        std::lock_guard<std::mutex> g(queue_mutex);
+        done = true;
+    }
+    for (auto& th : consumers)
+        th.join();
+
+    assert(consumed == kObjects);
+    assert(pool.size() == 0 && Packet::live == 0);
+    assert(pool.capacity() == 256);
+}
+
+void test_release_all_and_shrink_see_remote_frees()
+{
+    Pool pool(8, GrowthPolicy::fixed_step(8, 32));
+    std::vector<Packet*> objects;
+    for (int i = 0; i < 24; ++i)
+        objects.push_back(pool.emplace_unowned(i));
+
+    // Every object of the last chunk and a few others die remotely.
+    std::thread([&] {
+        for (int i = 16; i < 24; ++i)
+            pool.destroy_unowned(objects[i]);
+        pool.destroy_unowned(objects[3]);
+    }).join();
+    assert(Packet::live == 15);
+
+    assert(pool.shrink_to_fit() == 8);
+    assert(pool.capacity() == 16);
+
+    // Remotely destroyed objects must not be destroyed a second time.
+    std::thread([&] { pool.destroy_unowned(objects[5]); }).join();
+    assert(pool.release_all() == 14);
+    assert(Packet::live == 0 && pool.size() == 0);
+
+    auto h = pool.emplace(0);
+    assert(h.get() == objects[0]);
+}
+
+void test_lowest_address_owner_pool()
+{
+    using LowPool = ObjectPool<LowPacket, kOwner>;
+    LowPool pool(128);
+    std::vector<LowPool::handle_type> handles;
+    for (int i = 0; i < 128; ++i)
+        handles.push_back(pool.emplace(i));
+    const LowPacket* base = handles[0].get();
+
+    std::vector<LowPool::handle_type> remote;
+    for (int i : {90, 7, 64, 33})
+        remote.push_back(std::move(handles[i]));
+    destroy_remotely(remote);
+
+    // Reclaimed slots join the bitmap and come back lowest first.
+    for (int expected : {7, 33, 64, 90})
+    {
+        handles.push_back(pool.emplace(0));
+        assert(handles.back().get() == base + expected);
+    }
+}
+
+int main()
+{
+    test_owner_frees_stay_local();
+    test_remote_frees_are_reclaimed_when_the_free_list_runs_dry();
+    test_remote_release_bulk();
+    test_set_owner_thread();
+    test_producer_consumer();
+    test_release_all_and_shrink_see_remote_frees();
+    test_lowest_address_owner_pool();
+
+    std::cout << "[OK] owner_thread tests passed\n";
+    return 0;
+}
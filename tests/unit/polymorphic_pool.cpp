@@ -0,0 +1,215 @@
+#define OxiMemPool_ErrCallback
+#include "MemOx/polymorphic_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+static std::atomic<int> g_live{0}; // changed by several threads in test_growth_and_threads()
+
+struct Expr
+{
+    Expr() { ++g_live; }
+    virtual ~Expr() { --g_live; }
+    virtual long eval() const = 0;
+};
+
+struct Literal final : Expr
+{
+    long value;
+    explicit Literal(long v) : value(v) {}
+    long eval() const override { return value; }
+};
+
+struct Binary final : Expr
+{
+    char op;
+    PolymorphicHandle<Expr> lhs, rhs;
+    Binary(char o, PolymorphicHandle<Expr> l, PolymorphicHandle<Expr> r)
+        : op(o), lhs(std::move(l)), rhs(std::move(r)) {}
+    long eval() const override { return op == '+' ? lhs->eval() + rhs->eval() : lhs->eval() * rhs->eval(); }
+};
+
+struct Call final : Expr
+{
+    std::string name;
+    long args[6] = {};
+    explicit Call(std::string n) : name(std::move(n))
+    {
+        if (name.empty())
+            throw std::invalid_argument("empty name");
+    }
+    long eval() const override { return static_cast<long>(name.size()); }
+};
+
+using ExprPool = PolymorphicPoolOf<Expr, Literal, Binary, Call>;
+
+// A hierarchy without virtual functions.
+static int g_events = 0;
+
+struct Event
+{
+    int kind;
+};
+
+struct KeyEvent : Event
+{
+    std::string key;
+    explicit KeyEvent(std::string k) : Event{1}, key(std::move(k)) { ++g_events; }
+    ~KeyEvent() { --g_events; }
+};
+
+struct Tagged
+{
+    std::uint64_t tag = 7;
+};
+
+// Event is not the first base, so the Event* is offset into the slot.
+struct MouseEvent : Tagged, Event
+{
+    int x, y;
+    MouseEvent(int px, int py) : Event{2}, x(px), y(py) { ++g_events; }
+    ~MouseEvent() { --g_events; }
+};
+
+struct VirtualKey : virtual Event {};
+struct Huge : Event { char bytes[256]; };
+struct alignas(64) Aligned : Event {};
+struct Unrelated { int x; };
+
+using EventPool = PolymorphicPool<Event, 64, 16>;
+
+static_assert(EventPool::fits<Event> && EventPool::fits<KeyEvent> && EventPool::fits<MouseEvent>);
+static_assert(!EventPool::fits<VirtualKey>); // no static_cast from a virtual base
+static_assert(!EventPool::fits<Huge>);
+static_assert(!EventPool::fits<Aligned>);
+static_assert(!EventPool::fits<Unrelated>);
+static_assert(ExprPool::slot_size == std::max({sizeof(Literal), sizeof(Binary), sizeof(Call)}));
+
+void test_hierarchy_in_one_pool()
+{
+    {
+        ExprPool pool(8);
+        auto l = pool.emplace<Literal>(3);
+        auto r = pool.emplace<Literal>(4);
+        // Consecutive slots of one block.
+        assert(reinterpret_cast<const std::byte*>(r.get()) - reinterpret_cast<const std::byte*>(l.get()) ==
+               static_cast<std::ptrdiff_t>(ExprPool::pool_type::slot_size));
+
+        auto sum = pool.emplace<Binary>('+', std::move(l), std::move(r));
+        auto product = pool.emplace<Binary>('*', std::move(sum), pool.emplace<Literal>(5));
+        auto call = pool.emplace<Call>("print");
+        assert(product->eval() == 35 && call->eval() == 5);
+        assert(pool.size() == 6 && g_live == 6);
+        assert(pool.owns(product.get()) && pool.owns(call.get()));
+
+        // Destroying the root destroys the subtree through the member handles.
+        product.reset();
+        assert(pool.size() == 1 && g_live == 1);
+
+        PolymorphicHandle<Expr> moved = std::move(call);
+        assert(!call && moved);
+    }
+    assert(g_live == 0);
+}
+
+void test_non_virtual_base()
+{
+    EventPool pool(4);
+    auto key = pool.emplace<KeyEvent>("enter");
+    auto mouse = pool.emplace<MouseEvent>(10, 20);
+    auto plain = pool.emplace<Event>(Event{3});
+    assert(key->kind == 1 && mouse->kind == 2 && plain->kind == 3);
+    assert(static_cast<MouseEvent*>(mouse.get())->tag == 7);
+    assert(pool.owns(mouse.get()));
+    assert(g_events == 2);
+
+    // The concrete destructor runs although ~Event is not virtual.
+    mouse.reset();
+    key.reset();
+    assert(g_events == 0 && pool.size() == 1);
+
+    // Slots are reused for any type.
+    auto again = pool.emplace<MouseEvent>(1, 2);
+    assert(pool.size() == 2 && pool.owns(again.get()));
+}
+
+static int g_errors = 0;
+static void count_error(const char*, size_t code) { g_errors += code == 1; }
+
+void test_exhaustion_and_exceptions()
+{
+    ExprPool pool(2);
+
+    bool thrown = false;
+    try {
+        (void)pool.emplace<Call>("");
+    }
+    catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown && pool.size() == 0 && g_live == 0);
+
+    auto a = pool.emplace<Literal>(1);
+    auto b = pool.try_emplace<Call>("f");
+    assert(a && b);
+    assert(!pool.try_emplace<Literal>(2));
+
+    thrown = false;
+    try {
+        (void)pool.emplace<Literal>(3);
+    }
+    catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    pool.pool().set_error_callback(count_error);
+    assert(!pool.emplace<Literal>(4));
+    assert(g_errors == 1);
+}
+
+void test_growth_and_threads()
+{
+    using Pool = PolymorphicPoolWith<PoolThreading::Mutex, Expr, Literal, Call>;
+    static_assert(std::is_same_v<Pool, PolymorphicPool<Expr, PolymorphicSlotOf<Expr, Literal, Call>::size,
+                                                       PolymorphicSlotOf<Expr, Literal, Call>::align,
+                                                       PoolThreading::Mutex>>);
+    Pool pool(16, GrowthPolicy::fixed_step(16, 256));
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&pool, t] {
+            std::vector<PolymorphicHandle<Expr>> local;
+            for (int i = 0; i < 2000; ++i)
+            {
+                if ((i + t) % 3 == 0)
+                    local.push_back(pool.emplace<Call>("call"));
+                else
+                    local.push_back(pool.emplace<Literal>(i));
+                if (local.size() > 32)
+                    local.erase(local.begin(), local.begin() + 16);
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+    assert(pool.size() == 0 && g_live == 0);
+}
+
+int main()
+{
+    test_hierarchy_in_one_pool();
+    test_non_virtual_base();
+    test_exhaustion_and_exceptions();
+    test_growth_and_threads();
+
+    std::cout << "[OK] polymorphic_pool tests passed\n";
+    return 0;
+}
@@ -0,0 +1,164 @@
+#include "MemOx/pool_resource.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <list>
+#include <map>
+#include <memory_resource>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Upstream that counts what reaches it.
+struct CountingResource : std::pmr::memory_resource
+{
+    size_t allocations = 0;
+    size_t deallocations = 0;
+
+    void* do_allocate(size_t bytes, size_t align) override
+    {
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, align);
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t align) override
+    {
+        ++deallocations;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+void test_resource_routing()
+{
+    CountingResource upstream;
+    PoolMemoryResource<32, 16, PoolThreading::SingleThread> res(2, GrowthPolicy{}, &upstream);
+
+    void* a = res.allocate(24, 8);
+    void* b = res.allocate(32, 16);
+    assert(res.pool().owns(a) && res.pool().owns(b));
+    assert(res.pool().size() == 2);
+    assert(upstream.allocations == 0);
+
+    void* big = res.allocate(33, 8);          // too large
+    void* aligned = res.allocate(16, 64);     // over-aligned
+    void* spill = res.allocate(8, 8);         // pool exhausted
+    assert(upstream.allocations == 3);
+    assert(!res.pool().owns(spill));
+
+    res.deallocate(spill, 8, 8);
+    res.deallocate(aligned, 16, 64);
+    res.deallocate(big, 33, 8);
+    assert(upstream.deallocations == 3);
+
+    res.deallocate(a, 24, 8);
+    assert(res.allocate(8, 8) == a);          // LIFO reuse of the slot
+    res.deallocate(a, 8, 8);
+    res.deallocate(b, 32, 16);
+    assert(res.pool().size() == 0);
+    assert(res.is_equal(res) && !res.is_equal(upstream));
+}
+
+void test_pmr_containers()
+{
+    CountingResource upstream;
+    PoolMemoryResource<64, alignof(std::max_align_t), PoolThreading::SingleThread> res(
+        256, GrowthPolicy::geometric(4096), &upstream);
+
+    {
+        std::pmr::list<int> list(&res);
+        for (int i = 0; i < 1000; ++i)
+            list.push_back(i);
+        assert(res.pool().size() == 1000);
+        assert(res.pool().capacity() >= 1000);
+
+        std::pmr::map<int, int> map(&res);
+        for (int i = 0; i < 100; ++i)
+            map[i] = i * i;
+        assert(map[7] == 49);
+        assert(res.pool().size() == 1100);
+    }
+    assert(res.pool().size() == 0);
+    assert(upstream.allocations == 0);
+
+    // Bucket arrays go upstream, nodes to the pool.
+    std::pmr::unordered_map<int, int> hash(&res);
+    for (int i = 0; i < 100; ++i)
+        hash.emplace(i, i);
+    assert(res.pool().size() == 100);
+    assert(upstream.allocations > 0);
+}
+
+void test_allocator_adapter()
+{
+    using Resource = PoolMemoryResource<64, alignof(std::max_align_t), PoolThreading::SingleThread>;
+    CountingResource upstream;
+    Resource res(512, GrowthPolicy{}, &upstream);
+
+    using ListAlloc = PoolAllocator<int, Resource>;
+    using MapAlloc = PoolAllocator<std::pair<const int, int>, Resource>;
+    using HashAlloc = PoolAllocator<std::pair<const int, int>, Resource>;
+
+    {
+        std::list<int, ListAlloc> list{ListAlloc(res)};
+        std::map<int, int, std::less<int>, MapAlloc> map{MapAlloc(res)};
+        std::unordered_map<int, int, std::hash<int>, std::equal_to<int>, HashAlloc> hash{
+            16, std::hash<int>{}, std::equal_to<int>{}, HashAlloc(res)};
+
+        for (int i = 0; i < 100; ++i)
+        {
+            list.push_back(i);
+            map.emplace(i, -i);
+            hash.emplace(i, i);
+        }
+        assert(res.pool().size() == 300);
+        assert(map.at(5) == -5 && hash.at(5) == 5);
+
+        std::list<int, ListAlloc> moved = std::move(list);
+        assert(moved.size() == 100 && moved.get_allocator() == ListAlloc(res));
+    }
+    assert(res.pool().size() == 0);
+    assert(upstream.allocations == upstream.deallocations);
+
+    Resource other(1);
+    assert(ListAlloc(res) == MapAlloc(res));
+    assert(!(ListAlloc(res) == ListAlloc(other)));
+}
+
+void test_shared_resource_across_threads()
+{
+    PoolMemoryResource<32, 16, PoolThreading::Mutex> res(64, GrowthPolicy::geometric(1 << 16));
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&] {
+            for (int round = 0; round < 50; ++round)
+            {
+                std::pmr::list<int> list(&res);
+                for (int i = 0; i < 100; ++i)
+                    list.push_back(i);
+            }
+        });
+    }
+    for (auto& th : threads)
+        th.join();
+    assert(res.pool().size() == 0);
+}
+
+int main()
+{
+    test_resource_routing();
+    test_pmr_containers();
+    test_allocator_adapter();
+    test_shared_resource_across_threads();
+
+    std::cout << "[OK] pool_resource tests passed\n";
+    return 0;
+}
@@ -0,0 +1,103 @@
+#include "MemOx/object_pool.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+template <ReusePolicy Policy>
+struct Job
+{
+    long id;
+    explicit Job(long i) : id(i) {}
+};
+
+template <ReusePolicy Policy>
+struct PoolReusePolicy<Job<Policy>>
+{
+    static constexpr ReusePolicy value = Policy;
+};
+
+// Every emplace() returns the slot peek_next_slot() named just before it,
+// on a fragmented free list and then in the untouched region.
+template <typename U, PoolThreading Threading>
+void test_peek_predicts_emplace()
+{
+    ObjectPool<U, Threading> pool(64);
+    std::vector<U*> objects;
+    for (int i = 0; i < 48; ++i)
+        objects.push_back(pool.emplace_unowned(i));
+    std::shuffle(objects.begin(), objects.end(), std::mt19937(7));
+    for (size_t i = 0; i < 32; ++i)
+        pool.destroy_unowned(objects[i]);
+
+    std::vector<typename ObjectPool<U, Threading>::handle_type> handles;
+    for (int i = 0; i < 48; ++i)
+    {
+        const void* next = pool.peek_next_slot();
+        pool.prefetch_next_slot();
+        handles.push_back(pool.emplace(i));
+#ifndef OxiMemPool_ThreadCache
+        assert(next == handles.back().get());
+#endif
+        (void)next;
+    }
+
+    // Exhausted: nothing to predict.
+    assert(pool.peek_next_slot() == nullptr);
+    handles.pop_back();
+    assert(pool.peek_next_slot() != nullptr);
+
+    for (size_t i = 32; i < objects.size(); ++i)
+        pool.destroy_unowned(objects[i]);
+}
+
+void test_growable_pool_at_its_end()
+{
+    using Pool = ObjectPool<long, PoolThreading::SingleThread>;
+    Pool pool(2, GrowthPolicy::fixed_step(2, 8));
+    auto a = pool.emplace(1);
+    auto b = pool.emplace(2);
+    // The next emplace() grows first, so the slot is not known yet.
+    assert(pool.peek_next_slot() == nullptr);
+    pool.prefetch_next_slot();
+    auto c = pool.emplace(3);
+    assert(c && pool.capacity() == 4);
+    const auto* after_c = reinterpret_cast<const std::byte*>(c.get()) + Pool::slot_size;
+    assert(pool.peek_next_slot() == after_c);
+}
+
+void test_owner_thread_sees_remote_frees()
+{
+    using Pool = ObjectPool<long, PoolThreading::OwnerThread>;
+    Pool pool(4);
+    std::vector<Pool::handle_type> handles;
+    for (int i = 0; i < 4; ++i)
+        handles.push_back(pool.emplace(i));
+    assert(pool.peek_next_slot() == nullptr);
+
+    const long* remote = handles[2].get();
+    std::thread([&] { handles[2].reset(); }).join();
+    assert(pool.peek_next_slot() == remote);
+    auto again = pool.emplace(5);
+    assert(again.get() == remote);
+}
+
+int main()
+{
+    using Lifo = Job<ReusePolicy::Lifo>;
+    test_peek_predicts_emplace<Lifo, PoolThreading::SingleThread>();
+    test_peek_predicts_emplace<Lifo, PoolThreading::Mutex>();
+    test_peek_predicts_emplace<Lifo, PoolThreading::LockFree>();
+    test_peek_predicts_emplace<Lifo, PoolThreading::OwnerThread>();
+    test_peek_predicts_emplace<Job<ReusePolicy::Fifo>, PoolThreading::SingleThread>();
+    test_peek_predicts_emplace<Job<ReusePolicy::LowestAddress>, PoolThreading::Mutex>();
+    test_growable_pool_at_its_end();
+    test_owner_thread_sees_remote_frees();
+
+    std::cout << "[OK] prefetch tests passed\n";
+    return 0;
+}
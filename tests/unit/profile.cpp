@@ -0,0 +1,228 @@
+#define OxiMemPool_Profile
+#include "MemOx/object_pool.hpp"
+#include "MemOx/size_class_pool.hpp"
+
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct Order
+{
+    int id;
+    explicit Order(int i) : id(i) {}
+};
+
+using Pool = ObjectPool<Order>;
+
+// Two distinct call sites of the application.
+[[gnu::noinline]] static Order* make_order(Pool& pool, int id)
+{
+    return pool.emplace_unowned(id);
+}
+
+[[gnu::noinline]] static PoolHandle<Order> make_handle(Pool& pool, int id)
+{
+    return pool.emplace(id);
+}
+
+static const PoolAllocationSite* find_site(const std::vector<PoolAllocationSite>& sites, size_t sampled)
+{
+    for (const PoolAllocationSite& site : sites)
+        if (site.sampled == sampled)
+            return &site;
+    return nullptr;
+}
+
+void test_every_object_sampled_by_call_site()
+{
+    Pool pool(64);
+    pool.set_profile_interval(1);
+    assert(pool.profile_interval() == 1);
+
+    std::vector<Order*> orders;
+    for (int i = 0; i < 10; ++i)
+        orders.push_back(make_order(pool, i));
+    std::vector<PoolHandle<Order>> handles;
+    for (int i = 0; i < 4; ++i)
+        handles.push_back(make_handle(pool, i));
+
+    auto sites = pool.live_allocation_sites();
+    assert(sites.size() == 2);
+    assert(sites[0].sampled == 10 && sites[0].estimated_live == 10);
+    assert(sites[1].sampled == 4);
+    assert(sites[0].site != sites[1].site);
+    for (const PoolAllocationSite& site : sites)
+        assert(site.age_histogram[0] + site.age_histogram[1] + site.age_histogram[2] +
+               site.age_histogram[3] + site.age_histogram[4] + site.age_histogram[5] +
+               site.age_histogram[6] == site.sampled);
+    const void* order_site = sites[0].site;
+
+    // Destroyed objects leave the profile.
+    for (int i = 0; i < 7; ++i)
+        pool.destroy_unowned(orders[static_cast<size_t>(i)]);
+    handles.pop_back();
+    sites = pool.live_allocation_sites();
+    assert(sites.size() == 2 && sites[0].sampled == 3 && sites[1].sampled == 3);
+    assert(find_site(sites, 3) != nullptr);
+
+    // A reused slot carries the sample of its new object.
+    Order* again = make_order(pool, 100);
+    sites = pool.live_allocation_sites();
+    assert(sites[0].site == order_site && sites[0].sampled == 4);
+    pool.destroy_unowned(again);
+
+    const std::string report = pool.dump_live_allocations();
+    assert(report.find("[Pool][PROFILE] live=6 sampled=6 interval=1 sites=2") == 0);
+    std::cout << report;
+
+    handles.clear();
+    pool.release_all();
+    assert(pool.live_allocation_sites().empty());
+}
+
+void test_ages()
+{
+    Pool pool(8);
+    pool.set_profile_interval(1);
+    Order* old = make_order(pool, 1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(15));
+    Order* young = pool.emplace_unowned(2);
+
+    const auto sites = pool.live_allocation_sites();
+    assert(sites.size() == 2);
+    for (const PoolAllocationSite& site : sites)
+    {
+        if (site.site == sites[0].site && site.oldest_ns >= 15'000'000)
+            assert(site.age_histogram[0] == 0 && site.age_histogram[1] == 0); // >= 10 ms
+    }
+    assert(sites[0].oldest_ns >= 15'000'000 || sites[1].oldest_ns >= 15'000'000);
+    pool.destroy_unowned(old);
+    pool.destroy_unowned(young);
+}
+
+void test_sampling_rate()
+{
+    Pool pool(1 << 16);
+    pool.set_profile_interval(64);
+    std::vector<Order*> orders;
+    for (int i = 0; i < (1 << 16); ++i)
+        orders.push_back(make_order(pool, i));
+
+    const auto sites = pool.live_allocation_sites();
+    assert(sites.size() == 1);
+    // 1024 expected; the gap is uniform in [1, 127].
+    assert(sites[0].sampled > 900 && sites[0].sampled < 1150);
+    assert(sites[0].estimated_live == sites[0].sampled * 64);
+
+    pool.set_profile_interval(0);
+    for (Order* o : orders)
+        pool.destroy_unowned(o);
+    orders.clear();
+    for (int i = 0; i < 1000; ++i)
+        orders.push_back(make_order(pool, i));
+    assert(pool.live_allocation_sites().empty());
+    pool.release_all();
+}
+
+void test_growth_bulk_and_compact()
+{
+    {
+        Pool pool(4, GrowthPolicy::fixed_step(4, 64));
+        pool.set_profile_interval(1);
+
+        std::vector<PoolHandle<Order>> batch;
+        pool.emplace_n(20, std::back_inserter(batch), 7); // spans growth chunks
+        auto sites = pool.live_allocation_sites();
+        assert(sites.size() == 1 && sites[0].sampled == 20);
+
+        pool.release_bulk(batch.begin(), batch.begin() + 12);
+        assert(pool.live_allocation_sites()[0].sampled == 8);
+        pool.release_bulk(batch.begin(), batch.end());
+        assert(pool.live_allocation_sites().empty());
+    }
+
+    // The samples move with the objects into the freed low slots.
+    Pool pool(32);
+    pool.set_profile_interval(1);
+    std::vector<Order*> orders;
+    for (int i = 0; i < 20; ++i)
+        orders.push_back(make_order(pool, i)); // bump order: ascending slots
+    for (size_t i = 0; i < 12; ++i)
+        pool.destroy_unowned(orders[i]);
+    orders.erase(orders.begin(), orders.begin() + 12);
+
+    const size_t moved = pool.compact(orders.begin(), orders.end());
+    assert(moved == 8);
+    const auto sites = pool.live_allocation_sites();
+    assert(sites.size() == 1 && sites[0].sampled == 8);
+    for (Order* o : orders)
+        pool.destroy_unowned(o);
+    assert(pool.live_allocation_sites().empty());
+}
+
+void test_threads()
+{
+    ObjectPool<Order, PoolThreading::LockFree> pool(4096);
+    pool.set_profile_interval(4);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&pool] {
+            std::vector<PoolHandle<Order, PoolThreading::LockFree>> keep;
+            for (int i = 0; i < 20000; ++i)
+            {
+                auto h = pool.emplace(i);
+                if (i % 100 == 0)
+                    keep.push_back(std::move(h));
+            }
+            keep.clear();
+        });
+    }
+    for (auto& th : threads) th.join();
+    assert(pool.size() == 0 && pool.live_allocation_sites().empty());
+}
+
+using Slabs = SizeClassPool<PoolThreading::SingleThread>;
+
+[[gnu::noinline]] static SlabHandle<Order, PoolThreading::SingleThread> make_slab(Slabs& slabs, int id)
+{
+    return slabs.emplace<Order>(id);
+}
+
+// Differs from make_slab() so that the two are not folded into one function.
+[[gnu::noinline]] static SlabHandle<Order, PoolThreading::SingleThread> make_other_slab(Slabs& slabs, int id)
+{
+    return slabs.emplace<Order>(-id);
+}
+
+void test_size_class_sites_are_the_callers()
+{
+    Slabs slabs(16);
+    slabs.pool_for<Order>().set_profile_interval(1);
+
+    std::vector<SlabHandle<Order, PoolThreading::SingleThread>> handles;
+    for (int i = 0; i < 3; ++i)
+        handles.push_back(make_slab(slabs, i));
+    handles.push_back(make_other_slab(slabs, 3));
+
+    // Not one site inside SizeClassPool::emplace(), but one per caller.
+    const auto sites = slabs.pool_for<Order>().live_allocation_sites();
+    assert(sites.size() == 2);
+    assert(find_site(sites, 3) && find_site(sites, 1));
+}
+
+int main()
+{
+    test_every_object_sampled_by_call_site();
+    test_ages();
+    test_sampling_rate();
+    test_growth_bulk_and_compact();
+    test_threads();
+    test_size_class_sites_are_the_callers();
+
+    std::cout << "[OK] profile tests passed\n";
+    return 0;
+}
@@ -0,0 +1,165 @@
+#include "MemOx/object_pool.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+struct Tracked
+{
+    static inline int live = 0;
+    std::int64_t value; // slot-sized, so consecutive slots are adjacent objects
+    explicit Tracked(std::int64_t v) : value(v) { ++live; }
+    ~Tracked() { --live; }
+};
+
+struct Plain
+{
+    std::uint64_t a, b;
+};
+
+template <typename T, PoolThreading Threading>
+static void churn_and_check_sequential(ObjectPool<T, Threading>& pool, size_t count)
+{
+    std::vector<T*> objects;
+    for (size_t i = 0; i < count; ++i)
+        objects.push_back(pool.emplace_unowned(static_cast<int>(i)));
+#ifndef OxiMemPool_ThreadCache // magazines hand out each refill in LIFO order
+    for (size_t i = 1; i < objects.size(); ++i)
+        assert(objects[i] == objects[i - 1] + 1);
+#endif
+    pool.release_all();
+}
+
+template <PoolThreading Threading>
+void test_release_all_destroys_live_objects()
+{
+    ObjectPool<Tracked, Threading> pool(64);
+
+    std::vector<Tracked*> objects;
+    for (int i = 0; i < 48; ++i)
+        objects.push_back(pool.emplace_unowned(i));
+
+    // Scatter the free list.
+    for (int i = 0; i < 48; i += 3)
+        pool.destroy_unowned(objects[i]);
+    assert(Tracked::live == 32);
+    assert(pool.size() == 32);
+
+    assert(pool.release_all() == 32);
+    assert(Tracked::live == 0);
+    assert(pool.size() == 0);
+
+    // Allocation order is sequential again from slot 0.
+    Tracked* first = pool.emplace_unowned(100);
+    assert(first == objects[0]);
+    assert(pool.release_all() == 1);
+    churn_and_check_sequential(pool, 64);
+    assert(Tracked::live == 0);
+}
+
+void test_trivially_destructible_skips_walk()
+{
+    ObjectPool<Plain, PoolThreading::SingleThread> pool(16);
+    Plain* a = pool.emplace_unowned(Plain{1, 2});
+    for (int i = 0; i < 10; ++i)
+        pool.emplace_unowned(Plain{3, 4});
+
+    assert(pool.release_all() == 11);
+    assert(pool.emplace_unowned(Plain{5, 6}) == a);
+    assert(pool.release_all() == 1);
+    assert(pool.release_all() == 0);
+}
+
+void test_reset_with_growth_and_holes()
+{
+    ObjectPool<Tracked, PoolThreading::SingleThread> pool(4, GrowthPolicy::fixed_step(4, 16));
+
+    // Keep chunk 3 alive so that chunks 1 and 2 become a hole in the middle.
+    std::vector<Tracked*> objects;
+    for (int i = 0; i < 16; ++i)
+        objects.push_back(pool.emplace_unowned(i));
+    for (int i = 0; i < 12; ++i)
+        pool.destroy_unowned(objects[i]);
+    assert(pool.size() == 4);
+    assert(pool.shrink_to_fit() == 8);
+    assert(pool.capacity() == 8);
+
+    assert(pool.release_all() == 4);
+    assert(Tracked::live == 0);
+
+    // Every committed slot is available again, lowest index first.
+    objects.clear();
+    for (int i = 0; i < 8; ++i)
+        objects.push_back(pool.emplace_unowned(i));
+    assert(pool.capacity() == 8);
+    for (int i = 1; i < 4; ++i)
+        assert(objects[i] == objects[i - 1] + 1);
+
+    pool.emplace_unowned(8); // re-commits the hole
+    assert(pool.capacity() == 12);
+    assert(pool.release_all() == 9);
+}
+
+void test_reset_reclaims_thread_caches()
+{
+    ObjectPool<Tracked, PoolThreading::Mutex> pool(64);
+
+    // A worker thread leaves slots in its cache (only with OxiMemPool_ThreadCache)
+    // and objects alive; both are reclaimed.
+    std::thread([&] {
+        for (int i = 0; i < 20; ++i)
+            pool.destroy_unowned(pool.emplace_unowned(i));
+        for (int i = 0; i < 10; ++i)
+            pool.emplace_unowned(i);
+    }).join();
+
+    assert(pool.release_all() == 10);
+    assert(Tracked::live == 0);
+    churn_and_check_sequential(pool, 64);
+}
+
+template <PoolThreading Threading>
+void test_raw_storage_blocks_reset()
+{
+    ObjectPool<Tracked, Threading> pool(8);
+
+    auto* a = pool.emplace_unowned(1);
+    Tracked* raw = pool.try_allocate_storage(); // never holds a Tracked
+    auto* b = pool.emplace_unowned(2);
+    assert(a && raw && b);
+    assert(Tracked::live == 2 && pool.size() == 3);
+
+    // Nothing is destroyed or reset while raw storage is out.
+    bool threw = false;
+    try {
+        pool.release_all();
+    }
+    catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    assert(Tracked::live == 2 && pool.size() == 3);
+    assert(a->value == 1 && b->value == 2);
+
+    pool.deallocate_storage(raw);
+    assert(pool.release_all() == 2);
+    assert(Tracked::live == 0 && pool.size() == 0);
+}
+
+int main()
+{
+    test_release_all_destroys_live_objects<PoolThreading::SingleThread>();
+    test_release_all_destroys_live_objects<PoolThreading::Mutex>();
+    test_release_all_destroys_live_objects<PoolThreading::LockFree>();
+    test_trivially_destructible_skips_walk();
+    test_reset_with_growth_and_holes();
+    test_reset_reclaims_thread_caches();
+    test_raw_storage_blocks_reset<PoolThreading::SingleThread>();
+    test_raw_storage_blocks_reset<PoolThreading::LockFree>();
+
+    std::cout << "[OK] release_all tests passed\n";
+    return 0;
+}
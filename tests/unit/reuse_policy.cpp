@@ -0,0 +1,252 @@
+#include "MemOx/object_pool.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+template <ReusePolicy Policy>
+struct Item
+{
+    long value;
+    explicit Item(long v) : value(v) {}
+};
+
+template <ReusePolicy Policy>
+struct PoolReusePolicy<Item<Policy>>
+{
+    static constexpr ReusePolicy value = Policy;
+};
+
+using LifoItem = Item<ReusePolicy::Lifo>;
+using LowItem = Item<ReusePolicy::LowestAddress>;
+using FifoItem = Item<ReusePolicy::Fifo>;
+
+// Frees `count` of `handles` in a shuffled order and returns the freed
+// addresses in the order they were freed.
+template <typename Handle>
+static std::vector<const void*> free_shuffled(std::vector<Handle>& handles, size_t count, unsigned seed)
+{
+    std::vector<size_t> order(handles.size());
+    for (size_t i = 0; i < order.size(); ++i)
+        order[i] = i;
+    std::shuffle(order.begin(), order.end(), std::mt19937(seed));
+
+    std::vector<const void*> freed;
+    for (size_t i = 0; i < count; ++i)
+    {
+        freed.push_back(handles[order[i]].get());
+        handles[order[i]].reset();
+    }
+    return freed;
+}
+
+template <typename U, PoolThreading Threading>
+static std::vector<const void*> reuse_order(ObjectPool<U, Threading>& pool, size_t count,
+                                            std::vector<PoolHandle<U, Threading>>& out)
+{
+    std::vector<const void*> order;
+    for (size_t i = 0; i < count; ++i)
+    {
+        out.push_back(pool.emplace(static_cast<long>(i)));
+        order.push_back(out.back().get());
+    }
+    return order;
+}
+
+template <PoolThreading Threading>
+void test_policies_order_reuse()
+{
+    {
+        ObjectPool<LifoItem, Threading> pool(128);
+        std::vector<PoolHandle<LifoItem, Threading>> handles;
+        reuse_order(pool, 100, handles);
+        auto freed = free_shuffled(handles, 60, 1);
+        std::vector<PoolHandle<LifoItem, Threading>> again;
+        auto order = reuse_order(pool, 60, again);
+        std::reverse(freed.begin(), freed.end());
+#ifndef OxiMemPool_ThreadCache
+        assert(order == freed);
+#endif
+    }
+    {
+        ObjectPool<LowItem, Threading> pool(128);
+        std::vector<PoolHandle<LowItem, Threading>> handles;
+        reuse_order(pool, 100, handles);
+        const LowItem* base = handles.front().get();
+        auto freed = free_shuffled(handles, 60, 2);
+        std::vector<PoolHandle<LowItem, Threading>> again;
+        auto order = reuse_order(pool, 60, again);
+        std::sort(freed.begin(), freed.end());
+        assert(order == freed);
+
+        // Untouched slots follow once the free slots are used up.
+        auto next = pool.emplace(0);
+        assert(next.get() == base + 100);
+    }
+    {
+        ObjectPool<FifoItem, Threading> pool(128);
+        std::vector<PoolHandle<FifoItem, Threading>> handles;
+        reuse_order(pool, 100, handles);
+        auto freed = free_shuffled(handles, 60, 3);
+        std::vector<PoolHandle<FifoItem, Threading>> again;
+        auto order = reuse_order(pool, 60, again);
+        assert(order == freed);
+    }
+}
+
+void test_lowest_address_interleaved()
+{
+    ObjectPool<LowItem, PoolThreading::SingleThread> pool(1000);
+    std::vector<PoolHandle<LowItem, PoolThreading::SingleThread>> handles;
+    for (int i = 0; i < 1000; ++i)
+        handles.push_back(pool.emplace(i));
+    const LowItem* base = handles[0].get();
+
+    // Free slot 900, then 5: the lower one must come back first.
+    handles[900].reset();
+    handles[5].reset();
+    auto a = pool.emplace(1);
+    assert(a.get() == base + 5);
+    handles[3].reset();
+    auto b = pool.emplace(2);
+    assert(b.get() == base + 3);
+    auto c = pool.emplace(3);
+    assert(c.get() == base + 900);
+}
+
+void test_lowest_address_with_growth_and_batches()
+{
+    using Pool = ObjectPool<LowItem, PoolThreading::SingleThread>;
+    Pool pool(8, GrowthPolicy::fixed_step(8, 64));
+    std::vector<Pool::handle_type> handles;
+    std::vector<const LowItem*> addr;
+    for (int i = 0; i < 40; ++i)
+    {
+        handles.push_back(pool.emplace(i));
+        addr.push_back(handles.back().get());
+    }
+    assert(pool.capacity() == 40);
+
+    // Frees spread over several chunks, single and bulk.
+    for (size_t i : {33u, 2u, 17u, 9u, 25u})
+        handles[i].reset();
+    pool.release_bulk(handles.begin() + 10, handles.begin() + 16);
+
+    // Empty the last chunk and release it; its slots leave the free set.
+    for (size_t i = 32; i < 40; ++i)
+        handles[i].reset();
+    assert(pool.shrink_to_fit() == 8);
+    assert(pool.capacity() == 32);
+    assert(pool.size() == 22);
+
+    std::vector<Pool::handle_type> again;
+    for (size_t expected : {2u, 9u, 10u, 11u, 12u, 13u, 14u, 15u, 17u, 25u})
+    {
+        again.push_back(pool.emplace(0));
+        assert(again.back().get() == addr[expected]);
+    }
+
+    // The free set is empty: the pool grows again and bulk runs are contiguous.
+    pool.emplace_n(8, std::back_inserter(again), 1L);
+    assert(pool.capacity() == 40);
+    assert(pool.size() == 40);
+}
+
+void test_lowest_address_release_all_and_compact()
+{
+    using Pool = ObjectPool<LowItem, PoolThreading::SingleThread>;
+    Pool pool(64);
+    std::vector<LowItem*> objects;
+    for (int i = 0; i < 64; ++i)
+        objects.push_back(pool.emplace_unowned(i));
+    for (int i = 0; i < 64; i += 2)
+        pool.destroy_unowned(objects[i]);
+
+    std::vector<LowItem*> odd;
+    for (int i = 1; i < 64; i += 2)
+        odd.push_back(objects[i]);
+    assert(pool.compact(odd.begin(), odd.end()) == 16);
+    for (LowItem* p : odd)
+        assert(p < objects[0] + 32);
+
+    auto h = pool.emplace(0);
+    assert(h.get() == objects[0] + 32);
+    h.reset();
+
+    assert(pool.release_all() == 32);
+    auto first = pool.emplace(0);
+    assert(first.get() == objects[0]);
+}
+
+template <typename U>
+void test_policy_under_contention()
+{
+    ObjectPool<U, PoolThreading::Mutex> pool(256);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&pool, t] {
+            std::mt19937 rng(static_cast<unsigned>(t));
+            std::vector<PoolHandle<U, PoolThreading::Mutex>> local;
+            for (int i = 0; i < 20000; ++i)
+            {
+                if (local.size() < 60 && (rng() & 1))
+                    local.push_back(pool.emplace(i));
+                else if (!local.empty())
+                {
+                    const size_t idx = rng() % local.size();
+                    local[idx] = std::move(local.back());
+                    local.pop_back();
+                }
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+    assert(pool.size() == 0);
+
+    // Every slot is still reachable exactly once.
+    std::vector<PoolHandle<U, PoolThreading::Mutex>> all;
+    for (int i = 0; i < 256; ++i)
+        all.push_back(pool.emplace(i));
+    std::vector<const U*> addresses;
+    for (auto& h : all)
+        addresses.push_back(h.get());
+    std::sort(addresses.begin(), addresses.end());
+    assert(std::adjacent_find(addresses.begin(), addresses.end()) == addresses.end());
+}
+
+void test_lock_free_pools_stay_lifo()
+{
+    ObjectPool<LowItem, PoolThreading::LockFree> pool(4);
+    auto a = pool.emplace(1);
+    auto b = pool.emplace(2);
+    const LowItem* pa = a.get();
+    const LowItem* pb = b.get();
+    b.reset();
+    a.reset();
+    auto c = pool.emplace(3);
+#ifndef OxiMemPool_ThreadCache
+    assert(c.get() == pa);
+#endif
+    (void)pa;
+    (void)pb;
+}
+
+int main()
+{
+    test_policies_order_reuse<PoolThreading::SingleThread>();
+    test_policies_order_reuse<PoolThreading::Mutex>();
+    test_lowest_address_interleaved();
+    test_lowest_address_with_growth_and_batches();
+    test_lowest_address_release_all_and_compact();
+    test_policy_under_contention<LifoItem>();
+    test_policy_under_contention<LowItem>();
+    test_policy_under_contention<FifoItem>();
+    test_lock_free_pools_stay_lifo();
+
+    std::cout << "[OK] reuse_policy tests passed\n";
+    return 0;
+}
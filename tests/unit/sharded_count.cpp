@@ -0,0 +1,136 @@
+#define OxiMemPool_ShardedCount
+#define OxiMemPool_Stats
+#include "MemOx/object_pool.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct Sample
+{
+    long value;
+    explicit Sample(long v) : value(v) {}
+};
+
+template <PoolThreading Threading>
+void test_exact_when_quiescent()
+{
+    ObjectPool<Sample, Threading> pool(256);
+    std::vector<PoolHandle<Sample, Threading>> handles;
+    for (long i = 0; i < 100; ++i)
+        handles.push_back(pool.emplace(i));
+    assert(pool.size() == 100);
+    handles.erase(handles.begin() + 40, handles.end());
+    assert(pool.size() == 40);
+    assert(pool.stats().live == 40);
+    assert(pool.stats().peak_live == 100); // one thread: one shard, exact
+    handles.clear();
+    assert(pool.size() == 0);
+}
+
+template <PoolThreading Threading>
+void test_objects_freed_on_other_threads()
+{
+    // Every object is created on one thread and destroyed on another, so the
+    // shards of the consumers only ever go down.
+    using Pool = ObjectPool<Sample, Threading>;
+    Pool pool(1024);
+
+    std::vector<std::vector<typename Pool::handle_type>> batches(4);
+    for (auto& batch : batches)
+        for (long i = 0; i < 200; ++i)
+            batch.push_back(pool.emplace(i));
+    assert(pool.size() == 800);
+
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < 2; ++t)
+        threads.emplace_back([&, t] { batches[t].clear(); });
+    for (auto& th : threads) th.join();
+    assert(pool.size() == 400);
+
+    std::thread([&] {
+        for (long i = 0; i < 50; ++i)
+            batches[0].push_back(pool.emplace(i));
+    }).join();
+    assert(pool.size() == 450);
+    assert(pool.stats().peak_live >= 800); // an upper bound across shards
+
+    batches.clear();
+    assert(pool.size() == 0);
+}
+
+template <PoolThreading Threading>
+void test_concurrent_churn()
+{
+    constexpr size_t kCapacity = 512;
+    ObjectPool<Sample, Threading> pool(kCapacity);
+    std::atomic<bool> stop{false};
+
+    // size() stays within bounds while it races with allocations and frees.
+    std::thread observer([&] {
+        while (!stop.load(std::memory_order_relaxed))
+            assert(pool.size() <= kCapacity);
+    });
+
+    std::mutex exchange_mutex;
+    std::vector<PoolHandle<Sample, Threading>> exchange;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&, t] {
+            std::vector<PoolHandle<Sample, Threading>> local;
+            for (int i = 0; i < 20000; ++i)
+            {
+                if (local.size() < 64)
+                {
+                    if (auto h = pool.try_emplace(i))
+                        local.push_back(std::move(h));
+                }
+                if ((i + t) % 3 == 0 && !local.empty())
+                {
+                    // Hand an object to whichever thread picks it up next.
+                    std::lock_guard<std::mutex> g(exchange_mutex);
+                    exchange.push_back(std::move(local.back()));
+                    local.pop_back();
+                    if (exchange.size() > 32)
+                        exchange.erase(exchange.begin(), exchange.begin() + 16);
+                }
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+    stop = true;
+    observer.join();
+
+    assert(pool.size() == exchange.size());
+    exchange.clear();
+    assert(pool.size() == 0);
+}
+
+void test_single_thread_pool_is_unchanged()
+{
+    ObjectPool<Sample, PoolThreading::SingleThread> pool(4);
+    auto a = pool.emplace(1);
+    auto b = pool.emplace(2);
+    assert(pool.size() == 2);
+    a.reset();
+    assert(pool.size() == 1);
+}
+
+int main()
+{
+    test_exact_when_quiescent<PoolThreading::Mutex>();
+    test_exact_when_quiescent<PoolThreading::LockFree>();
+    test_exact_when_quiescent<PoolThreading::OwnerThread>();
+    test_objects_freed_on_other_threads<PoolThreading::Mutex>();
+    test_objects_freed_on_other_threads<PoolThreading::LockFree>();
+    test_concurrent_churn<PoolThreading::Mutex>();
+    test_concurrent_churn<PoolThreading::LockFree>();
+    test_single_thread_pool_is_unchanged();
+
+    std::cout << "[OK] sharded_count tests passed\n";
+    return 0;
+}
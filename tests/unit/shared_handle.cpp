@@ -0,0 +1,154 @@
+#define OxiMemPool_SharedHandles
+#define OxiMemPool_ErrCallback
+#include "MemOx/object_pool.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <thread>
+#include <vector>
+
+static std::atomic<size_t> g_heap_allocs{0};
+
+void* operator new(size_t size)
+{
+    ++g_heap_allocs;
+    if (void* p = std::malloc(size))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+struct Texture
+{
+    static inline std::atomic<int> live{0};
+
+    int id;
+    explicit Texture(int i) : id(i) { ++live; }
+    ~Texture() { --live; }
+};
+
+template <PoolThreading Threading>
+void test_last_handle_destroys_the_object()
+{
+    ObjectPool<Texture, Threading> pool(4);
+    {
+        auto warm = pool.emplace(0); // thread caches allocate their magazine once
+    }
+
+    const size_t allocs = g_heap_allocs;
+    auto a = pool.emplace_shared(1);
+    assert(g_heap_allocs == allocs); // no control block
+    assert(a && a->id == 1 && a.use_count() == 1);
+
+    {
+        auto b = a;
+        PoolSharedHandle<Texture, Threading> c;
+        c = b;
+        assert(a.use_count() == 3 && c == a);
+        assert(pool.size() == 1);
+    }
+    assert(a.use_count() == 1 && Texture::live == 1);
+
+    auto moved = std::move(a);
+    assert(!a && a.use_count() == 0 && moved.use_count() == 1);
+
+    Texture* slot = moved.get();
+    auto& alias = moved;
+    moved = alias; // self-assignment keeps the object
+    assert(moved.use_count() == 1);
+    moved.reset();
+    assert(pool.size() == 0 && Texture::live == 0);
+
+    // The slot goes back through the normal free path.
+    auto again = pool.emplace(2);
+    assert(again.get() == slot);
+}
+
+void test_converted_from_unique_handle()
+{
+    ObjectPool<Texture> pool(2, GrowthPolicy::fixed_step(2, 8));
+    std::vector<PoolSharedHandle<Texture>> shared;
+    for (int i = 0; i < 6; ++i)
+    {
+        auto unique = pool.emplace(i);
+        shared.emplace_back(std::move(unique));
+        assert(!unique);
+    }
+    assert(pool.capacity() == 6);
+
+    // Counts of objects in growth chunks live in the chunks' side arrays.
+    std::vector<PoolSharedHandle<Texture>> copies = shared;
+    for (size_t i = 0; i < shared.size(); ++i)
+        assert(shared[i].use_count() == 2 && copies[i]->id == static_cast<int>(i));
+    shared.clear();
+    assert(Texture::live == 6);
+    copies.clear();
+    assert(Texture::live == 0 && pool.size() == 0);
+
+    PoolSharedHandle<Texture> empty(pool.try_emplace(0));
+    assert(empty && empty.use_count() == 1);
+}
+
+static int g_exhausted = 0;
+static void on_error(const char*, size_t code) { g_exhausted += code == 1; }
+
+void test_exhaustion_with_callback()
+{
+    ObjectPool<Texture> pool(1);
+    pool.set_error_callback(on_error);
+    auto a = pool.emplace_shared(1);
+    auto b = pool.emplace_shared(2);
+    assert(a && !b && b.use_count() == 0);
+    assert(g_exhausted == 1);
+}
+
+template <PoolThreading Threading>
+void test_shared_across_threads()
+{
+    ObjectPool<Texture, Threading> pool(64);
+    std::vector<PoolSharedHandle<Texture, Threading>> roots;
+    for (int i = 0; i < 64; ++i)
+        roots.push_back(pool.emplace_shared(i));
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([roots] () mutable {
+            for (int round = 0; round < 2000; ++round)
+            {
+                auto& h = roots[static_cast<size_t>(round) % roots.size()];
+                auto copy = h;
+                assert(copy.use_count() >= 2);
+                if (round % 7 == 0)
+                    h = copy;
+            }
+            roots.clear();
+        });
+    }
+
+    // The creating handles go away while the threads still share the objects.
+    roots.clear();
+    for (auto& th : threads) th.join();
+    assert(pool.size() == 0 && Texture::live == 0);
+}
+
+int main()
+{
+    test_last_handle_destroys_the_object<PoolThreading::SingleThread>();
+    test_last_handle_destroys_the_object<PoolThreading::Mutex>();
+    test_last_handle_destroys_the_object<PoolThreading::LockFree>();
+    test_last_handle_destroys_the_object<PoolThreading::OwnerThread>();
+    test_converted_from_unique_handle();
+    test_exhaustion_with_callback();
+    test_shared_across_threads<PoolThreading::Mutex>();
+    test_shared_across_threads<PoolThreading::LockFree>();
+    test_shared_across_threads<PoolThreading::OwnerThread>();
+
+    std::cout << "[OK] shared_handle tests passed\n";
+    return 0;
+}
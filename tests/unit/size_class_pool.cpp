@@ -0,0 +1,214 @@
+#include "MemOx/size_class_pool.hpp"
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct Ping
+{
+    std::uint32_t seq;
+    explicit Ping(std::uint32_t s) : seq(s) {}
+};
+
+struct Ack
+{
+    std::uint32_t seq;
+    std::uint16_t status;
+    Ack(std::uint32_t s, std::uint16_t st) : seq(s), status(st) {}
+};
+
+struct Quote
+{
+    double bid, ask;
+    std::uint64_t venue;
+    Quote(double b, double a) : bid(b), ask(a), venue(0) {}
+};
+
+struct Named
+{
+    std::string name;
+    explicit Named(std::string n) : name(std::move(n)) {}
+};
+
+struct Throwing
+{
+    explicit Throwing(bool fail) { if (fail) throw std::runtime_error("ctor"); }
+};
+
+struct alignas(64) OverAligned { int v; };
+struct Oversized { std::byte data[1024]; };
+
+static_assert(kFitsSlab<Quote> && kFitsSlab<Named>);
+static_assert(!kFitsSlab<OverAligned> && !kFitsSlab<Oversized>);
+
+void test_size_classes()
+{
+    static_assert(SizeClassPool<>::slot_size(1) == 16);
+    static_assert(SizeClassPool<>::slot_size(16) == 16);
+    static_assert(SizeClassPool<>::slot_size(17) == 32);
+    static_assert(SizeClassPool<>::slot_size(129) == 160);
+    static_assert(SizeClassPool<>::slot_size(512) == 512);
+    static_assert(SizeClassPool<>::slot_size(513) == 0);
+}
+
+void test_types_share_a_class()
+{
+    SizeClassPool<PoolThreading::SingleThread> pool(4);
+
+    auto ping = pool.emplace<Ping>(1u);
+    auto ack = pool.emplace<Ack>(2u, std::uint16_t{200});
+    auto quote = pool.emplace<Quote>(1.5, 1.75);
+
+    assert(ping->seq == 1 && ack->status == 200 && quote->ask == 1.75);
+    assert(&pool.pool_for<Ping>() == &pool.pool_for<Ack>());
+    assert(pool.pool_for<Ping>().size() == 2);
+    assert(pool.pool_for<Quote>().size() == 1);
+    assert(pool.size() == 3);
+
+    // A freed slot is reused by another type of the same class.
+    void* slot = ping.get();
+    ping.reset();
+    auto other = pool.emplace<Ack>(3u, std::uint16_t{404});
+    assert(static_cast<void*>(other.get()) == slot);
+    assert(reinterpret_cast<std::uintptr_t>(other.get()) % kSlabAlign == 0);
+}
+
+void test_handles_and_non_trivial_types()
+{
+    SizeClassPool<PoolThreading::SingleThread> pool(2);
+
+    SlabHandle<Named, PoolThreading::SingleThread> a =
+        pool.emplace<Named>(std::string(40, 'x'));
+    auto b = std::move(a);
+    assert(!a && b && b->name.size() == 40);
+
+    a = pool.emplace<Named>("second");
+    b = std::move(a);          // destroys the first string
+    assert(b->name == "second");
+    assert(pool.size() == 1);
+
+    bool threw = false;
+    try {
+        auto t = pool.emplace<Throwing>(true);
+    }
+    catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    assert(pool.size() == 1);
+    assert(pool.stats()[0].requested_bytes == 0);
+}
+
+void test_fragmentation_and_utilization()
+{
+    SizeClassPool<PoolThreading::SingleThread> pool(8);
+
+    std::vector<SlabHandle<Ack, PoolThreading::SingleThread>> acks;
+    for (std::uint32_t i = 0; i < 4; ++i)
+        acks.push_back(pool.emplace<Ack>(i, std::uint16_t{0}));
+    auto quote = pool.emplace<Quote>(1.0, 2.0);
+
+    const auto st = pool.stats();
+    assert(st[0].slot_size == 16);
+    assert(st[0].live == 4 && st[0].capacity == 8);
+    assert(st[0].requested_bytes == 4 * sizeof(Ack));
+    assert(st[0].used_bytes == 64 && st[0].reserved_bytes == 128);
+    assert(st[0].utilization == 0.5);
+    assert(st[0].internal_fragmentation == 1.0 - sizeof(Ack) / 16.0);
+
+    const size_t quote_class = slab_class_index(sizeof(Quote));
+    assert(st[quote_class].live == 1);
+    assert(st[quote_class].requested_bytes == sizeof(Quote));
+    assert(st[2].live == 0 && st[2].internal_fragmentation == 0.0);
+
+    // Only the two classes in use have slot memory.
+    assert(st[2].slot_size == 48 && st[2].capacity == 0);
+    assert(pool.reserved_bytes() == 8 * (16 + 32));
+
+    acks.clear();
+    assert(pool.stats()[0].requested_bytes == 0);
+}
+
+void test_classes_created_on_first_use()
+{
+    SizeClassPool<PoolThreading::SingleThread> pool(1000);
+    assert(pool.reserved_bytes() == 0);
+    assert(pool.stats()[0].capacity == 0);
+
+    auto ping = pool.emplace<Ping>(1u);
+    assert(pool.reserved_bytes() == 1000 * 16);
+    for (const SizeClassStats& c : pool.stats())
+        assert(c.capacity == (c.slot_size == 16 ? 1000 : 0));
+
+    // Nothing to release in classes that were never created.
+    assert(pool.shrink_to_fit() == 0);
+}
+
+void test_per_class_capacities()
+{
+    std::array<size_t, SizeClassPool<>::class_count> slots{};
+    slots.fill(1);
+    slots[slab_class_index(sizeof(Ping))] = 64;
+
+    SizeClassPool<PoolThreading::Mutex> pool(slots);
+    assert(pool.pool_for<Ping>().capacity() == 64);
+    assert(pool.pool_for<Quote>().capacity() == 1);
+    assert(pool.reserved_bytes() == 64 * 16 + 1 * 32);
+}
+
+void test_growth_per_class()
+{
+    SizeClassPool<PoolThreading::SingleThread> pool(2, GrowthPolicy::fixed_step(2, 6));
+
+    std::vector<SlabHandle<Ping, PoolThreading::SingleThread>> pings;
+    for (std::uint32_t i = 0; i < 6; ++i)
+        pings.push_back(pool.emplace<Ping>(i));
+    assert(pool.pool_for<Ping>().capacity() == 6);
+    assert(pool.pool_for<Quote>().capacity() == 2);
+
+    pings.clear();
+    assert(pool.shrink_to_fit() == 4);
+}
+
+void test_concurrent_classes()
+{
+    SizeClassPool<PoolThreading::Mutex> pool(64);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&, t] {
+            for (std::uint32_t i = 0; i < 2000; ++i)
+            {
+                auto p = pool.emplace<Ping>(i);
+                auto q = pool.emplace<Quote>(t, i);
+                assert(p->seq == i && q->ask == i);
+            }
+        });
+    }
+    for (auto& th : threads)
+        th.join();
+
+    assert(pool.size() == 0);
+    assert(pool.stats()[0].requested_bytes == 0);
+}
+
+int main()
+{
+    test_size_classes();
+    test_types_share_a_class();
+    test_handles_and_non_trivial_types();
+    test_fragmentation_and_utilization();
+    test_classes_created_on_first_use();
+    test_per_class_capacities();
+    test_growth_per_class();
+    test_concurrent_classes();
+
+    std::cout << "[OK] size_class_pool tests passed\n";
+    return 0;
+}
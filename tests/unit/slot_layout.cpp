@@ -0,0 +1,139 @@
+#include "MemOx/object_pool.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+struct Counter
+{
+    std::uint64_t hits = 0;
+};
+
+struct PaddedCounter
+{
+    std::uint64_t hits = 0;
+};
+
+struct Flag
+{
+    std::uint32_t bits;
+    explicit Flag(std::uint32_t b) : bits(b) {}
+};
+
+template <>
+struct PoolSlotLayout<PaddedCounter>
+{
+    static constexpr SlotLayout value = SlotLayout::CacheLine;
+};
+
+template <>
+struct PoolSlotLayout<Flag>
+{
+    static constexpr SlotLayout value = SlotLayout::Dense;
+};
+
+// Smallest distance between two of the objects owned by `handles`.
+template <typename Handles>
+static size_t min_stride(const Handles& handles)
+{
+    std::vector<std::uintptr_t> addresses;
+    for (const auto& h : handles)
+        addresses.push_back(reinterpret_cast<std::uintptr_t>(h.get()));
+    std::sort(addresses.begin(), addresses.end());
+
+    size_t stride = std::numeric_limits<size_t>::max();
+    for (size_t i = 1; i < addresses.size(); ++i)
+        stride = std::min<size_t>(stride, addresses[i] - addresses[i - 1]);
+    return stride;
+}
+
+template <PoolThreading Threading>
+void test_natural_layout_is_unchanged()
+{
+    ObjectPool<Counter, Threading> pool(4);
+
+    std::vector<typename ObjectPool<Counter, Threading>::handle_type> handles;
+    for (int i = 0; i < 4; ++i)
+        handles.push_back(pool.emplace());
+    assert(min_stride(handles) == sizeof(Counter));
+}
+
+template <PoolThreading Threading>
+void test_cache_line_layout()
+{
+    ObjectPool<PaddedCounter, Threading> pool(16);
+
+    std::vector<typename ObjectPool<PaddedCounter, Threading>::handle_type> handles;
+    for (int i = 0; i < 16; ++i)
+        handles.push_back(pool.emplace());
+
+    for (const auto& h : handles)
+        assert(reinterpret_cast<std::uintptr_t>(h.get()) % kPoolCacheLineSize == 0);
+    assert(min_stride(handles) == kPoolCacheLineSize);
+}
+
+template <PoolThreading Threading>
+void test_dense_layout()
+{
+    ObjectPool<Flag, Threading> pool(8, GrowthPolicy::fixed_step(8, 32));
+
+    std::vector<typename ObjectPool<Flag, Threading>::handle_type> handles;
+    for (std::uint32_t i = 0; i < 32; ++i)
+        handles.push_back(pool.emplace(i));
+
+    // 4-byte objects sit 4 bytes apart even though links would need a pointer.
+    assert(min_stride(handles) == sizeof(Flag));
+
+    // The index-linked free list hands slots back in LIFO order across chunks.
+    Flag* last_freed = handles[20].get();
+    handles[3].reset();
+    handles[20].reset();
+    auto again = pool.emplace(99u);
+    assert(again.get() == last_freed);
+
+    // Bulk release and shrinking walk and relink the indexed free list.
+    pool.release_bulk(handles.begin() + 8, handles.end());
+    assert(pool.shrink_to_fit() == 16);
+    assert(pool.capacity() == 16);
+
+    for (std::uint32_t i = 0; i < 9; ++i)
+        handles[8 + i] = pool.emplace(i);
+    assert(pool.size() == 7 + 1 + 9);
+    for (std::uint32_t i = 0; i < 9; ++i)
+        assert(handles[8 + i]->bits == i);
+}
+
+void test_dense_capacity_limit()
+{
+    bool threw = false;
+    try {
+        ObjectPool<Flag, PoolThreading::SingleThread> pool(
+            4, GrowthPolicy::fixed_step(size_t{1} << 30, size_t{1} << 33));
+    }
+    catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+}
+
+int main()
+{
+    static_assert(kDefaultSlotLayout == SlotLayout::Natural);
+
+    test_natural_layout_is_unchanged<PoolThreading::SingleThread>();
+    test_natural_layout_is_unchanged<PoolThreading::LockFree>();
+    test_cache_line_layout<PoolThreading::SingleThread>();
+    test_cache_line_layout<PoolThreading::Mutex>();
+    test_cache_line_layout<PoolThreading::LockFree>();
+    test_dense_layout<PoolThreading::SingleThread>();
+    test_dense_layout<PoolThreading::Mutex>();
+    test_dense_layout<PoolThreading::LockFree>();
+    test_dense_capacity_limit();
+
+    std::cout << "[OK] slot_layout tests passed\n";
+    return 0;
+}
@@ -0,0 +1,186 @@
+#define OxiMemPool_ErrCallback
+#include "MemOx/static_object_pool.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+static std::atomic<size_t> g_heap_allocs{0};
+
+void* operator new(size_t size)
+{
+    ++g_heap_allocs;
+    if (void* p = std::malloc(size))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+struct Message
+{
+    static inline std::atomic<int> live{0};
+
+    long id;
+    explicit Message(long i) : id(i) { ++live; }
+    ~Message() { --live; }
+};
+
+constexpr PoolThreading kST = PoolThreading::SingleThread;
+
+StaticObjectPool<Message, 4> g_messages;
+
+template <PoolThreading Threading>
+void test_no_heap_allocation()
+{
+    const size_t allocs = g_heap_allocs;
+    {
+        StaticObjectPool<Message, 8, Threading> pool;
+        assert(pool.capacity() == 8);
+        {
+            auto warm = pool.emplace(0); // thread caches allocate their magazine once
+        }
+
+        const size_t warmed = g_heap_allocs;
+        Message* objects[8];
+        for (long i = 0; i < 8; ++i)
+        {
+            objects[i] = pool.emplace_unowned(i);
+            assert(objects[i]->id == i);
+        }
+        assert(!pool.try_emplace(8));
+        assert(pool.size() == 8 && pool.capacity() == 8);
+
+        // Slots are part of the pool object.
+        const auto* begin = reinterpret_cast<const std::byte*>(&pool);
+        for (Message* p : objects)
+        {
+            const auto* bytes = reinterpret_cast<const std::byte*>(p);
+            assert(bytes >= begin && bytes < begin + sizeof(pool));
+        }
+        for (Message* p : objects)
+            pool.destroy_unowned(p);
+
+        auto h = pool.emplace(9);
+        assert(h && Message::live == 1);
+        h.reset();
+        assert(Message::live == 0);
+        assert(g_heap_allocs == warmed);
+    }
+    if constexpr (Threading == kST)
+        assert(g_heap_allocs == allocs);
+}
+
+void test_user_buffer()
+{
+    using Pool = ObjectPool<Message, kST>;
+    alignas(Pool::slot_align) std::byte storage[16 * Pool::slot_size + 1];
+
+    // An unaligned start loses the partial leading slot.
+    std::span<std::byte> buffer(storage + 1, sizeof(storage) - 1);
+    const size_t allocs = g_heap_allocs;
+    {
+        Pool pool(buffer);
+        assert(pool.capacity() == 15);
+        Message* objects[15];
+        for (long i = 0; i < 15; ++i)
+            objects[i] = pool.emplace_unowned(i);
+        assert(!pool.try_emplace(15));
+
+        for (Message* p : objects)
+        {
+            const auto addr = reinterpret_cast<std::uintptr_t>(p);
+            assert(addr % Pool::slot_align == 0);
+            assert(reinterpret_cast<std::byte*>(p) >= storage + 1);
+            assert(reinterpret_cast<std::byte*>(p) + Pool::slot_size <= storage + sizeof(storage));
+        }
+        for (Message* p : objects)
+            pool.destroy_unowned(p);
+        assert(pool.size() == 0);
+    }
+    assert(g_heap_allocs == allocs);
+
+    // A buffer too small for one slot is rejected like a zero capacity.
+    bool thrown = false;
+    try {
+        Pool tiny(std::span<std::byte>(storage + 1, Pool::slot_size));
+    }
+    catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+}
+
+static int g_exhausted = 0;
+static void on_error(const char*, size_t code) { g_exhausted += code == 1; }
+
+void test_exhaustion_reports_through_callback()
+{
+    StaticObjectPool<Message, 2, kST> pool;
+    pool.set_error_callback(on_error);
+    auto a = pool.emplace(1);
+    auto b = pool.emplace(2);
+    const size_t allocs = g_heap_allocs;
+    auto c = pool.emplace(3);
+    assert(a && b && !c);
+    assert(g_exhausted == 1);
+    assert(g_heap_allocs == allocs);
+}
+
+void test_global_pool_and_compact_handles()
+{
+    using Compact = CompactPoolHandle<g_messages>;
+    using Index = PoolIndexHandle<g_messages>;
+    static_assert(sizeof(Compact) == sizeof(void*));
+
+    Compact a = Compact::emplace(1);
+    Index b = Index::try_emplace(2);
+    PoolHandle<Message> c = g_messages.emplace(3);
+    assert(a && b && c);
+    assert(a->id == 1 && b->id == 2 && c->id == 3);
+    assert(g_messages.size() == 3);
+    a.reset();
+    b.reset();
+    c.reset();
+    assert(g_messages.size() == 0);
+}
+
+void test_shared_between_threads()
+{
+    static StaticObjectPool<Message, 64, PoolThreading::Mutex> pool;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([] {
+            for (int round = 0; round < 5000; ++round)
+            {
+                auto h = pool.try_emplace(round);
+                assert(h);
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+    assert(pool.size() == 0 && Message::live == 0);
+}
+
+int main()
+{
+    test_no_heap_allocation<kST>();
+    test_no_heap_allocation<PoolThreading::Mutex>();
+    test_no_heap_allocation<PoolThreading::LockFree>();
+    test_no_heap_allocation<PoolThreading::OwnerThread>();
+    test_user_buffer();
+    test_exhaustion_reports_through_callback();
+    test_global_pool_and_compact_handles();
+    test_shared_between_threads();
+
+    std::cout << "[OK] static_pool tests passed\n";
+    return 0;
+}
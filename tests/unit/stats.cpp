@@ -0,0 +1,116 @@
+#define OxiMemPool_Stats
+#include "MemOx/object_pool.hpp"
+
+#include <cassert>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+struct Sample
+{
+    int value;
+    explicit Sample(int v) : value(v) {}
+};
+
+template <PoolThreading Threading>
+void test_counts_and_peak()
+{
+    ObjectPool<Sample, Threading> pool(4);
+
+    {
+        auto a = pool.emplace(1);
+        auto b = pool.emplace(2);
+        auto c = pool.emplace(3);
+    }
+    auto d = pool.emplace(4); // reused slot
+
+    const PoolStats st = pool.stats();
+    assert(st.live == 1);
+    assert(st.peak_live == 3);
+    assert(st.capacity == 4);
+    assert(st.touched_slots == 3);
+    assert(st.fresh_allocs == 3);
+    assert(st.reused_allocs == 1);
+    assert(st.frees == 3);
+    assert(st.exhausted == 0);
+}
+
+void test_exhaustion_is_counted()
+{
+    ObjectPool<Sample, PoolThreading::SingleThread> pool(1);
+    auto a = pool.emplace(1);
+
+    bool threw = false;
+    try {
+        auto b = pool.emplace(2);
+    }
+    catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    assert(pool.stats().exhausted == 1);
+}
+
+void test_growth_and_batches()
+{
+    ObjectPool<Sample, PoolThreading::SingleThread> pool(2, GrowthPolicy::fixed_step(4, 10));
+
+    std::vector<PoolHandle<Sample, PoolThreading::SingleThread>> batch;
+    pool.emplace_n(6, std::back_inserter(batch), 0);
+
+    PoolStats st = pool.stats();
+    assert(st.live == 6 && st.peak_live == 6);
+    assert(st.grows == 1);
+    assert(st.fresh_allocs == 6);
+
+    pool.release_bulk(batch.begin(), batch.end());
+    assert(pool.shrink_to_fit() == 4);
+
+    st = pool.stats();
+    assert(st.frees == 6);
+    assert(st.shrinks == 1);
+    assert(st.peak_live == 6);
+    assert(st.capacity == 2);
+}
+
+void test_sharded_counters_under_threads()
+{
+    constexpr int kThreads = 4;
+    constexpr int kIterations = 5'000;
+
+    ObjectPool<Sample, PoolThreading::Mutex> pool(kThreads);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t)
+    {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < kIterations; ++i)
+            {
+                auto h = pool.emplace(t + i);
+                assert(h->value == t + i);
+            }
+        });
+    }
+    for (auto& th : threads)
+        th.join();
+
+    const PoolStats st = pool.stats();
+    assert(st.live == 0);
+    assert(st.peak_live >= 1 && st.peak_live <= kThreads);
+    assert(st.fresh_allocs + st.reused_allocs == kThreads * kIterations);
+    assert(st.frees == kThreads * kIterations);
+    assert(st.lock_contended == 0 || st.lock_wait_ns > 0);
+}
+
+int main()
+{
+    test_counts_and_peak<PoolThreading::SingleThread>();
+    test_counts_and_peak<PoolThreading::Mutex>();
+    test_counts_and_peak<PoolThreading::LockFree>();
+    test_exhaustion_is_counted();
+    test_growth_and_batches();
+    test_sharded_counters_under_threads();
+
+    std::cout << "[OK] stats tests passed\n";
+    return 0;
+}
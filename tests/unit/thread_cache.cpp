@@ -0,0 +1,187 @@
+#define OxiMemPool_ThreadCache
+#ifndef OxiMemPool_LockFree
+#define OxiMemPool_ThreadSafe
+#endif
+#include "MemOx/object_pool.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+struct CachedObject
+{
+    static inline std::atomic<int> live{0};
+
+    int value;
+    explicit CachedObject(int v) : value(v) { live.fetch_add(1, std::memory_order_relaxed); }
+    ~CachedObject() { live.fetch_sub(1, std::memory_order_relaxed); }
+};
+
+// Tries to take `count` objects on a fresh thread, returns how many succeeded.
+static int emplace_on_other_thread(ObjectPool<CachedObject>& pool, int count)
+{
+    int ok = 0;
+    std::thread([&] {
+        std::vector<PoolHandle<CachedObject>> held;
+        for (int i = 0; i < count; ++i)
+        {
+            try {
+                held.push_back(pool.emplace(i));
+                ++ok;
+            }
+            catch (const std::runtime_error&) {}
+        }
+    }).join();
+    return ok;
+}
+
+void test_reuse_from_own_magazine()
+{
+    ObjectPool<CachedObject> pool(8);
+    pool.set_magazine_size(4);
+
+    auto h1 = pool.emplace(1);
+    auto* addr = h1.get();
+    h1.reset();
+
+    assert(pool.size() == 0);
+
+    auto h2 = pool.emplace(2);
+    assert(h2.get() == addr);
+    assert(h2->value == 2);
+}
+
+void test_cached_slots_are_private_until_drained()
+{
+    ObjectPool<CachedObject> pool(4);
+    pool.set_magazine_size(4);
+
+    // refill takes half a magazine (2 slots), one is handed back on reset
+    pool.emplace(1).reset();
+
+    assert(emplace_on_other_thread(pool, 4) == 2);
+
+    pool.drain_thread_cache();
+
+    assert(emplace_on_other_thread(pool, 4) == 4);
+    assert(pool.size() == 0);
+}
+
+void test_thread_exit_drains_cache()
+{
+    ObjectPool<CachedObject> pool(4);
+    pool.set_magazine_size(4);
+
+    std::thread([&] {
+        auto a = pool.emplace(1);
+        auto b = pool.emplace(2);
+        auto c = pool.emplace(3);
+    }).join();
+
+    // all four slots must be reachable again from another thread
+    std::vector<PoolHandle<CachedObject>> held;
+    for (int i = 0; i < 4; ++i)
+        held.push_back(pool.emplace(i));
+
+    assert(pool.size() == 4);
+    held.clear();
+    pool.drain_thread_cache();
+}
+
+void test_thread_outliving_pool()
+{
+    std::atomic<int> stage{0};
+    auto pool = std::make_unique<ObjectPool<CachedObject>>(4);
+
+    std::thread worker([&] {
+        pool->emplace(1).reset(); // leaves slots in this thread's magazine
+        stage.store(1, std::memory_order_release);
+        while (stage.load(std::memory_order_acquire) != 2) {}
+        // thread exit must not touch the destroyed pool
+    });
+
+    while (stage.load(std::memory_order_acquire) != 1) {}
+    pool.reset();
+    stage.store(2, std::memory_order_release);
+    worker.join();
+}
+
+void test_disabled_magazine_uses_shared_list()
+{
+    ObjectPool<CachedObject> pool(2);
+    pool.set_magazine_size(0);
+
+    pool.emplace(1).reset();
+
+    assert(emplace_on_other_thread(pool, 2) == 2);
+}
+
+void test_magazine_size_is_clamped()
+{
+    ObjectPool<CachedObject> pool(2);
+    pool.set_magazine_size(ObjectPool<CachedObject>::kMaxMagazineSize * 4);
+    assert(pool.magazine_size() == ObjectPool<CachedObject>::kMaxMagazineSize);
+}
+
+void test_parallel_churn_with_cross_thread_frees()
+{
+    constexpr int kThreads = 6;
+    constexpr int kIterations = 20'000;
+    constexpr int kCapacity = 512;
+
+    ObjectPool<CachedObject> pool(kCapacity);
+    pool.set_magazine_size(16);
+
+    std::atomic<bool> start{false};
+    std::vector<std::vector<PoolHandle<CachedObject>>> handoff(kThreads);
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < kThreads; ++t)
+    {
+        threads.emplace_back([&, t] {
+            while (!start.load(std::memory_order_acquire)) {}
+
+            std::vector<PoolHandle<CachedObject>> held;
+            for (int i = 0; i < kIterations; ++i)
+            {
+                auto h = pool.emplace(i);
+                assert(h->value == i);
+                if (i % 4 == 0)
+                    held.push_back(std::move(h));
+                if (held.size() > 8)
+                    held.erase(held.begin());
+                assert(pool.size() <= kCapacity);
+            }
+
+            // hand the rest to another thread so they are freed remotely
+            handoff[t] = std::move(held);
+        });
+    }
+
+    start.store(true, std::memory_order_release);
+    for (auto& th : threads)
+        th.join();
+
+    std::thread([&] { handoff.clear(); }).join();
+
+    assert(pool.size() == 0);
+    assert(CachedObject::live.load() == 0);
+}
+
+int main()
+{
+    test_reuse_from_own_magazine();
+    test_cached_slots_are_private_until_drained();
+    test_thread_exit_drains_cache();
+    test_thread_outliving_pool();
+    test_disabled_magazine_uses_shared_list();
+    test_magazine_size_is_clamped();
+    test_parallel_churn_with_cross_thread_frees();
+
+    std::cout << "[OK] thread_cache tests passed\n";
+    return 0;
+}
@@ -121,11 +121,47 @@ void test_capacity_never_exceeded()
     assert(pool.size() == 0);
 }
 
+void test_parallel_growth()
+{
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 100;
+    constexpr size_t kMax = kThreads * kPerThread;
+
+    ObjectPool<ThreadObject> pool(8, GrowthPolicy::geometric(kMax));
+
+    std::atomic<bool> start{false};
+    std::vector<std::vector<PoolHandle<ThreadObject>>> per_thread(kThreads);
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < kThreads; ++t)
+    {
+        threads.emplace_back([&, t] {
+            while (!start.load(std::memory_order_acquire)) {}
+
+            for (int i = 0; i < kPerThread; ++i)
+                per_thread[t].push_back(pool.emplace(t));
+        });
+    }
+
+    start.store(true, std::memory_order_release);
+
+    for (auto& th : threads)
+        th.join();
+
+    assert(pool.size() == kMax);
+    assert(pool.capacity() == kMax);
+
+    per_thread.clear();
+    assert(pool.size() == 0);
+    assert(pool.shrink_to_fit() == kMax - 8);
+}
+
 int main()
 {
     test_parallel_emplace_and_destroy();
     test_parallel_reuse_pressure();
     test_capacity_never_exceeded();
+    test_parallel_growth();
 
     std::cout << "[OK] thread_safety tests passed\n";
     return 0;
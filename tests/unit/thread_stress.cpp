@@ -37,7 +37,7 @@ void test_thread_stress()
     const auto test_duration = 3s;        // время гонки
     const int max_local_handles = 64;     // сколько handle'ов локально держать в потоке
 
-    ObjectPool<StressItem> pool(pool_capacity);
+    ObjectPool<StressItem, PoolThreading::Mutex> pool(pool_capacity);
 
     const unsigned hw = std::max(2u, std::thread::hardware_concurrency());
     const int num_threads = static_cast<int>(hw);
@@ -53,7 +53,7 @@ void test_thread_stress()
             std::mt19937_64 rng(static_cast<uint64_t>(std::chrono::high_resolution_clock::now().time_since_epoch().count()) + (uint64_t)t);
             std::uniform_int_distribution<int> coin(0, 99);
 
-            std::vector<PoolHandle<StressItem>> local;
+            std::vector<PoolHandle<StressItem, PoolThreading::Mutex>> local;
             local.reserve(32);
 
             while (!stop.load(std::memory_order_relaxed))
@@ -0,0 +1,120 @@
+// No configuration macros: every pool picks its threading policy explicitly.
+#include "MemOx/object_pool.hpp"
+
+#include <cassert>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <iostream>
+
+struct PolicyObject
+{
+    int value;
+    explicit PolicyObject(int v) : value(v) {}
+};
+
+using LocalPool = ObjectPool<PolicyObject, PoolThreading::SingleThread>;
+using SharedPool = ObjectPool<PolicyObject, PoolThreading::Mutex>;
+using LockFreePool = ObjectPool<PolicyObject, PoolThreading::LockFree>;
+
+static_assert(kDefaultPoolThreading == PoolThreading::SingleThread);
+static_assert(std::is_same_v<ObjectPool<PolicyObject>, LocalPool>);
+static_assert(std::is_same_v<SharedPool::handle_type, PoolHandle<PolicyObject, PoolThreading::Mutex>>);
+static_assert(LockFreePool::threading == PoolThreading::LockFree);
+
+// A single-threaded pool carries neither a mutex nor atomic counters.
+static_assert(sizeof(LocalPool) < sizeof(SharedPool));
+
+template <typename Pool>
+void run_parallel(Pool& pool, int threads, int iterations)
+{
+    std::atomic<bool> start{false};
+    std::vector<std::thread> workers;
+
+    for (int t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([&, t] {
+            while (!start.load(std::memory_order_acquire)) {}
+
+            for (int i = 0; i < iterations; ++i)
+            {
+                auto h = pool.emplace(t * 100000 + i);
+                if (h)
+                {
+                    assert(h->value == t * 100000 + i);
+                    assert(pool.size() <= pool.capacity());
+                }
+            }
+        });
+    }
+
+    start.store(true, std::memory_order_release);
+
+    for (auto& w : workers)
+        w.join();
+}
+
+void test_single_thread_pool()
+{
+    LocalPool pool(4);
+
+    auto a = pool.emplace(1);
+    auto b = pool.emplace(2);
+    assert(pool.size() == 2);
+
+    auto* addr = a.get();
+    a.reset();
+    assert(pool.size() == 1);
+
+    auto c = pool.emplace(3);
+    assert(c.get() == addr);
+    assert(c->value == 3);
+}
+
+void test_mixed_pools_in_one_unit()
+{
+    LocalPool local(8);
+    SharedPool shared(16);
+    LockFreePool lock_free(16);
+
+    auto h = local.emplace(42);
+
+    run_parallel(shared, 4, 5'000);
+    run_parallel(lock_free, 4, 5'000);
+
+    assert(shared.size() == 0);
+    assert(lock_free.size() == 0);
+    assert(local.size() == 1);
+    assert(h->value == 42);
+}
+
+void test_policies_support_growth_and_bulk()
+{
+    SharedPool shared(2, GrowthPolicy::fixed_step(2, 8));
+    LocalPool local(2, GrowthPolicy::fixed_step(2, 8));
+
+    std::vector<SharedPool::handle_type> a;
+    std::vector<LocalPool::handle_type> b;
+    shared.emplace_n(6, std::back_inserter(a), 1);
+    local.emplace_n(6, std::back_inserter(b), 2);
+
+    assert(shared.size() == 6 && local.size() == 6);
+    assert(shared.capacity() >= 6 && local.capacity() >= 6);
+
+    shared.release_bulk(a.begin(), a.end());
+    local.release_bulk(b.begin(), b.end());
+    assert(shared.size() == 0 && local.size() == 0);
+
+    assert(shared.shrink_to_fit() > 0);
+    assert(local.shrink_to_fit() > 0);
+}
+
+int main()
+{
+    test_single_thread_pool();
+    test_mixed_pools_in_one_unit();
+    test_policies_support_growth_and_bulk();
+
+    std::cout << "[OK] threading_policy tests passed\n";
+    return 0;
+}
@@ -0,0 +1,125 @@
+#define OxiMemPool_ErrCallback
+#define OxiMemPool_Stats
+#include "MemOx/object_pool.hpp"
+#include "MemOx/size_class_pool.hpp"
+
+#include <cassert>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+struct Order
+{
+    static inline int live = 0;
+
+    int id;
+    explicit Order(int i) : id(i)
+    {
+        if (i < 0)
+            throw std::runtime_error("bad order");
+        ++live;
+    }
+    ~Order() { --live; }
+};
+
+static int g_callback_calls = 0;
+static void count_error(const char*, size_t) { ++g_callback_calls; }
+
+ObjectPool<Order> g_orders(2);
+
+template <PoolThreading Threading>
+void test_exhaustion_returns_empty_handle()
+{
+    ObjectPool<Order, Threading> pool(3);
+    std::vector<PoolHandle<Order, Threading>> handles;
+    for (int i = 0; i < 3; ++i)
+    {
+        handles.push_back(pool.try_emplace(i));
+        assert(handles.back() && handles.back()->id == i);
+    }
+
+    // Neither throws nor reports, with or without an error callback.
+    auto none = pool.try_emplace(3);
+    assert(!none);
+    pool.set_error_callback(count_error);
+    assert(!pool.try_emplace(4));
+    assert(g_callback_calls == 0);
+    assert(pool.size() == 3);
+    assert(pool.stats().exhausted == 2);
+
+    // emplace() still reports through the callback.
+    assert(!pool.emplace(5));
+    assert(g_callback_calls == 1);
+    g_callback_calls = 0;
+
+    handles.pop_back();
+    auto again = pool.try_emplace(6);
+    assert(again && again->id == 6);
+}
+
+void test_constructor_exceptions_propagate()
+{
+    ObjectPool<Order> pool(1);
+    bool thrown = false;
+    try {
+        (void)pool.try_emplace(-1);
+    }
+    catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+    assert(pool.size() == 0);
+
+    // The slot went back to the pool.
+    auto h = pool.try_emplace(1);
+    assert(h);
+    assert(Order::live == 1);
+}
+
+void test_growable_pool_grows_first()
+{
+    ObjectPool<Order> pool(1, GrowthPolicy::fixed_step(1, 3));
+    auto a = pool.try_emplace(1);
+    auto b = pool.try_emplace(2);
+    auto c = pool.try_emplace(3);
+    assert(a && b && c);
+    assert(pool.capacity() == 3);
+    assert(!pool.try_emplace(4));
+}
+
+void test_handle_front_ends()
+{
+    using Compact = CompactPoolHandle<g_orders>;
+    using Index = PoolIndexHandle<g_orders>;
+
+    Compact a = Compact::try_emplace(1);
+    Index b = Index::try_emplace(2);
+    assert(a && b);
+    assert(!Compact::try_emplace(3));
+    assert(!Index::try_emplace(4));
+    a.reset();
+    assert(Index::try_emplace(5));
+}
+
+void test_size_class_pool()
+{
+    SizeClassPool<> slab(1);
+    auto a = slab.try_emplace<Order>(1);
+    assert(a && a->id == 1);
+    assert(!slab.try_emplace<Order>(2));
+    assert(slab.size() == 1);
+}
+
+int main()
+{
+    test_exhaustion_returns_empty_handle<PoolThreading::SingleThread>();
+    test_exhaustion_returns_empty_handle<PoolThreading::Mutex>();
+    test_exhaustion_returns_empty_handle<PoolThreading::LockFree>();
+    test_constructor_exceptions_propagate();
+    test_growable_pool_grows_first();
+    test_handle_front_ends();
+    test_size_class_pool();
+
+    std::cout << "[OK] try_emplace tests passed\n";
+    return 0;
+}
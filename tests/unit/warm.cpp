@@ -0,0 +1,78 @@
+#include "MemOx/object_pool.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+struct Page
+{
+    std::uint8_t bytes[512];
+    explicit Page(std::uint8_t v) { bytes[0] = v; }
+};
+
+template <PoolThreading Threading>
+void test_warm_touches_untouched_region()
+{
+    ObjectPool<Page, Threading> pool(64);
+
+    auto first = pool.emplace(1);       // slot 0 leaves the untouched region
+    assert(pool.warm() == 63);
+    assert(pool.warm() == 63);          // still untouched: warming is idempotent
+
+    auto second = pool.emplace(2);
+    assert(reinterpret_cast<std::byte*>(second.get()) ==
+           reinterpret_cast<std::byte*>(first.get()) + sizeof(Page));
+}
+
+template <PoolThreading Threading>
+void test_warm_threads_free_list_in_address_order()
+{
+    ObjectPool<Page, Threading> pool(8);
+
+    assert(pool.warm(5, true) == 5);
+    assert(pool.warm() == 3);           // remaining untouched slots
+
+    std::vector<typename ObjectPool<Page, Threading>::handle_type> handles;
+    for (int i = 0; i < 8; ++i)
+        handles.push_back(pool.emplace(static_cast<std::uint8_t>(i)));
+
+    for (size_t i = 1; i < handles.size(); ++i)
+        assert(handles[i].get() == handles[i - 1].get() + 1);
+    assert(pool.size() == 8);
+}
+
+void test_warm_growable_pool()
+{
+    ObjectPool<Page> pool(4, GrowthPolicy::fixed_step(4, 16));
+
+    std::vector<PoolHandle<Page>> handles;
+    for (int i = 0; i < 6; ++i)
+        handles.push_back(pool.emplace(static_cast<std::uint8_t>(i)));
+    assert(pool.capacity() == 8);
+
+    // Only committed memory is warmed; the pool does not grow.
+    assert(pool.warm(100, true) == 2);
+    assert(pool.capacity() == 8);
+
+    handles.push_back(pool.emplace(6));
+    handles.push_back(pool.emplace(7));
+    assert(pool.capacity() == 8);
+    assert(pool.warm() == 0);
+
+    handles.push_back(pool.emplace(8)); // grows as usual
+    assert(pool.capacity() == 12);
+}
+
+int main()
+{
+    test_warm_touches_untouched_region<PoolThreading::SingleThread>();
+    test_warm_touches_untouched_region<PoolThreading::Mutex>();
+    test_warm_touches_untouched_region<PoolThreading::LockFree>();
+    test_warm_threads_free_list_in_address_order<PoolThreading::SingleThread>();
+    test_warm_threads_free_list_in_address_order<PoolThreading::LockFree>();
+    test_warm_growable_pool();
+
+    std::cout << "[OK] warm tests passed\n";
+    return 0;
+}
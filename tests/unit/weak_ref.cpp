@@ -0,0 +1,129 @@
+#define OxiMemPool_WeakRefs
+#include "MemOx/object_pool.hpp"
+
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+struct Entity
+{
+    int id;
+    explicit Entity(int i) : id(i) {}
+};
+
+void test_weak_ref_tracks_lifetime()
+{
+    ObjectPool<Entity> pool(4);
+
+    auto h = pool.emplace(1);
+    PoolWeakRef<Entity> ref(h);
+
+    assert(!ref.expired());
+    assert(ref.try_get() == h.get());
+    assert(ref.try_get()->id == 1);
+
+    h.reset();
+
+    assert(ref.expired());
+    assert(ref.try_get() == nullptr);
+}
+
+void test_reused_slot_does_not_revive_ref()
+{
+    ObjectPool<Entity> pool(1);
+
+    auto h1 = pool.emplace(1);
+    PoolWeakRef<Entity> old_ref(h1);
+    auto* addr = h1.get();
+    h1.reset();
+
+    auto h2 = pool.emplace(2);
+    assert(h2.get() == addr); // same slot
+    PoolWeakRef<Entity> new_ref(h2);
+
+    assert(old_ref.expired());
+    assert(new_ref.try_get() == addr);
+    assert(!(old_ref == new_ref));
+}
+
+void test_ref_survives_handle_move()
+{
+    ObjectPool<Entity> pool(2);
+
+    auto h1 = pool.emplace(7);
+    PoolWeakRef<Entity> ref(h1);
+
+    PoolHandle<Entity> h2 = std::move(h1);
+    assert(ref.try_get() == h2.get());
+
+    h2.reset();
+    assert(ref.expired());
+}
+
+void test_empty_refs()
+{
+    PoolWeakRef<Entity> empty;
+    assert(empty.expired());
+
+    ObjectPool<Entity> pool(1);
+    auto h = pool.emplace(1);
+    PoolWeakRef<Entity> ref(h);
+    ref.reset();
+    assert(ref.expired());
+}
+
+void test_refs_into_grown_chunks()
+{
+    ObjectPool<Entity> pool(1, GrowthPolicy::fixed_step(2, 5));
+
+    std::vector<PoolHandle<Entity>> handles;
+    std::vector<PoolWeakRef<Entity>> refs;
+    for (int i = 0; i < 5; ++i)
+    {
+        handles.push_back(pool.emplace(i));
+        refs.emplace_back(handles.back());
+    }
+
+    for (int i = 0; i < 5; ++i)
+        assert(refs[i].try_get()->id == i);
+
+    // release the last chunk, grow again: old refs must stay expired
+    handles[3].reset();
+    handles[4].reset();
+    assert(pool.shrink_to_fit() == 2);
+
+    handles[3] = pool.emplace(30);
+    handles[4] = pool.emplace(40);
+
+    assert(refs[3].expired());
+    assert(refs[4].expired());
+    assert(refs[2].try_get()->id == 2);
+}
+
+void test_release_bulk_expires_refs()
+{
+    ObjectPool<Entity> pool(8);
+
+    std::vector<PoolHandle<Entity>> batch;
+    for (int i = 0; i < 8; ++i)
+        batch.push_back(pool.emplace(i));
+
+    std::vector<PoolWeakRef<Entity>> refs(batch.begin(), batch.end());
+    pool.release_bulk(batch.begin(), batch.end());
+
+    for (auto& ref : refs)
+        assert(ref.expired());
+}
+
+int main()
+{
+    test_weak_ref_tracks_lifetime();
+    test_reused_slot_does_not_revive_ref();
+    test_ref_survives_handle_move();
+    test_empty_refs();
+    test_refs_into_grown_chunks();
+    test_release_bulk_expires_refs();
+
+    std::cout << "[OK] weak_ref tests passed\n";
+    return 0;
+}